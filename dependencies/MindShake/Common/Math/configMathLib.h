@@ -1 +1,23 @@
 #pragma once
+
+//-------------------------------------
+// SIMD implementations of the math types.
+// SSE2 is part of every x64 target. AVX2 (+ FMA) paths are only built when
+// the compiler targets it (ie. -mavx2 -mfma, /arch:AVX2).
+// Define MS_MATH_NO_SIMD (cmake option MINDSHAKE_MATH_SIMD=OFF) to build the
+// scalar reference code instead.
+//-------------------------------------
+#if !defined(MS_MATH_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define MS_MATH_SSE
+    #endif
+    #if defined(MS_MATH_SSE) && defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+        #define MS_MATH_AVX2
+    #endif
+#endif
+
+#if defined(MS_MATH_AVX2)
+    #include <immintrin.h>
+#elif defined(MS_MATH_SSE)
+    #include <emmintrin.h>
+#endif
@@ -1,9 +1,11 @@
 #pragma once
 
 //-------------------------------------
+#include "configMathLib.h"
 #include "constants.h"
 //-------------------------------------
 #include <cmath>
+#include <cstddef>
 #include <type_traits>
 //-------------------------------------
 
@@ -17,15 +19,15 @@ namespace MindShake
 
     //---------------------------------
     template <typename T>
-    inline T        Abs(T _val)                             { return (_val < T(0)) ?  -_val :   _val; }
+    constexpr T     Abs(T _val)                             { return (_val < T(0)) ?  -_val :   _val; }
 
     //---------------------------------
     template <typename T>
-    inline T        Sign(T _val)                            { return (_val > 0) ? T(1) : T(-1); }
+    constexpr T     Sign(T _val)                            { return (_val > 0) ? T(1) : T(-1); }
 
     //---------------------------------
     template <typename T>
-    inline bool     DifferentSign(T _val1, T _val2)         { return (_val1 * _val2 < T(0)) ? true : false; }
+    constexpr bool  DifferentSign(T _val1, T _val2)         { return (_val1 * _val2 < T(0)) ? true : false; }
 
 
     //---------------------------------
@@ -122,31 +124,31 @@ namespace MindShake
     //---------------------------------
 
     //---------------------------------
-    inline bool     IsZero(float  _val, float  _eps=Float32::ZERO_EPSILON)                  { return ((_val  > -_eps) && (_val  < _eps)); }
-    inline bool     IsZero(double _val, double _eps=Float64::ZERO_EPSILON)                  { return ((_val  > -_eps) && (_val  < _eps)); }
+    constexpr bool  IsZero(float  _val, float  _eps=Float32::ZERO_EPSILON)                  { return ((_val  > -_eps) && (_val  < _eps)); }
+    constexpr bool  IsZero(double _val, double _eps=Float64::ZERO_EPSILON)                  { return ((_val  > -_eps) && (_val  < _eps)); }
 
     //---------------------------------
-    inline bool     IsNotZero(float  _val, float  _eps=Float32::ZERO_EPSILON)               { return ((_val <= -_eps) || (_val >= _eps)); }
-    inline bool     IsNotZero(double _val, double _eps=Float64::ZERO_EPSILON)               { return ((_val <= -_eps) || (_val >= _eps)); }
+    constexpr bool  IsNotZero(float  _val, float  _eps=Float32::ZERO_EPSILON)               { return ((_val <= -_eps) || (_val >= _eps)); }
+    constexpr bool  IsNotZero(double _val, double _eps=Float64::ZERO_EPSILON)               { return ((_val <= -_eps) || (_val >= _eps)); }
 
     //---------------------------------
-    inline bool     IsEqual(float  _v1, float  _v2, float  _eps=Float32::ZERO_EPSILON)      { return (Abs(_v2 - _v1) <= _eps) ? true : false; }
-    inline bool     IsEqual(double _v1, double _v2, double _eps=Float64::ZERO_EPSILON)      { return (Abs(_v2 - _v1) <= _eps) ? true : false; }
+    constexpr bool  IsEqual(float  _v1, float  _v2, float  _eps=Float32::ZERO_EPSILON)      { return (Abs(_v2 - _v1) <= _eps) ? true : false; }
+    constexpr bool  IsEqual(double _v1, double _v2, double _eps=Float64::ZERO_EPSILON)      { return (Abs(_v2 - _v1) <= _eps) ? true : false; }
 
     //---------------------------------
-    inline bool     IsNotEqual(float  _v1, float  _v2, float  _eps=Float32::ZERO_EPSILON)   { return (Abs(_v2 - _v1) <= _eps) ? false : true; }
-    inline bool     IsNotEqual(double _v1, double _v2, double _eps=Float64::ZERO_EPSILON)   { return (Abs(_v2 - _v1) <= _eps) ? false : true; }
+    constexpr bool  IsNotEqual(float  _v1, float  _v2, float  _eps=Float32::ZERO_EPSILON)   { return (Abs(_v2 - _v1) <= _eps) ? false : true; }
+    constexpr bool  IsNotEqual(double _v1, double _v2, double _eps=Float64::ZERO_EPSILON)   { return (Abs(_v2 - _v1) <= _eps) ? false : true; }
 
     //---------------------------------
     template <typename T1, typename T2>
-    inline auto     Min(const T1 &_A, const T2 &_B) -> decltype(_A + _B)    { return (_A <= _B) ? _A : _B; }
+    constexpr auto  Min(const T1 &_A, const T2 &_B) -> decltype(_A + _B)    { return (_A <= _B) ? _A : _B; }
 
     template <typename T1, typename T2>
-    inline auto     Max(const T1 &_A, const T2 &_B) -> decltype(_A + _B)    { return (_A >  _B) ? _A : _B; }
+    constexpr auto  Max(const T1 &_A, const T2 &_B) -> decltype(_A + _B)    { return (_A >  _B) ? _A : _B; }
 
     //---------------------------------
     template <typename T>
-    inline T        Clamp(T _val, T _min=T(0), T _max=T(1)) {
+    constexpr T     Clamp(T _val, T _min=T(0), T _max=T(1)) {
 		if(_val < _min) return _min;
 		if(_val > _max) return _max;
 
@@ -211,7 +213,7 @@ namespace MindShake
 
     //---------------------------------
     template <typename T>
-    inline T        Sqr(T _v)                               { return _v * _v;           }
+    constexpr T     Sqr(T _v)                               { return _v * _v;           }
 
     //---------------------------------
     inline float    Sqrt(float  _v)                         { return sqrtf(_v);         }
@@ -252,7 +254,7 @@ namespace MindShake
 
     // Fast power of two checking
     //---------------------------------
-    inline bool     IsPowerOfTwo(const uint32_t _val)       { return ((_val & (_val-1)) == 0);  }
+    constexpr bool  IsPowerOfTwo(const uint32_t _val)       { return ((_val & (_val-1)) == 0);  }
 
     // Gets closest power of two given a number
     //---------------------------------
@@ -394,32 +396,178 @@ namespace MindShake
     inline float    CosecG(float  _v)                       { return Cosec(_v * Float32::DEGTORAD); }
     inline double   CosecG(double _v)                       { return Cosec(_v * Float64::DEGTORAD); }
 
+    //---------------------------------
+    inline void     SinCos(float  _v, float  &_sin, float  &_cos)   { _sin = sinf(_v); _cos = cosf(_v);     }
+    inline void     SinCos(double _v, double &_sin, double &_cos)   { _sin = sin (_v); _cos = cos (_v);     }
+
+    inline void     SinCosG(float  _v, float  &_sin, float  &_cos)  { SinCos(_v * Float32::DEGTORAD, _sin, _cos); }
+    inline void     SinCosG(double _v, double &_sin, double &_cos)  { SinCos(_v * Float64::DEGTORAD, _sin, _cos); }
+
+#if defined(MS_MATH_SSE)
+    //---------------------------------
+    // Sine and cosine of 4 angles (radians) with the Cephes single precision
+    // polynomials. Absolute error below 1e-7 for |_v| < 8192, the range
+    // reduction loses precision beyond that.
+    //---------------------------------
+    inline void
+    SinCos(__m128 _v, __m128 &_sin, __m128 &_cos) {
+        const __m128    signMask = _mm_set1_ps(-0.0f);
+        __m128          x        = _mm_andnot_ps(signMask, _v);
+        __m128          signSin  = _mm_and_ps(_v, signMask);
+        __m128          y, z, polySin, polyCos, useSin;
+        __m128i         j;
+
+        // Octant, rounded up to even: j = (int(|x| * 4/PI) + 1) & ~1
+        j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f)));
+        j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+        y = _mm_cvtepi32_ps(j);
+
+        // x - y * PI/4 in extended precision
+        x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(0.78515625f)));
+        x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(2.4187564849853515625e-4f)));
+        x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(3.77489497744594108e-8f)));
+        z = _mm_mul_ps(x, x);
+
+        polyCos = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(-1.388731625493765e-3f));
+        polyCos = _mm_add_ps(_mm_mul_ps(polyCos, z), _mm_set1_ps(4.166664568298827e-2f));
+        polyCos = _mm_mul_ps(_mm_mul_ps(polyCos, z), z);
+        polyCos = _mm_add_ps(_mm_sub_ps(polyCos, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+        polySin = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f));
+        polySin = _mm_add_ps(_mm_mul_ps(polySin, z), _mm_set1_ps(-1.6666654611e-1f));
+        polySin = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(polySin, z), x), x);
+
+        // Octants 0, 3, 4 and 7 (j & 2 == 0) use the sine polynomial for the sine
+        useSin  = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+        signSin = _mm_xor_ps(signSin, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29)));
+
+        _sin = _mm_or_ps(_mm_and_ps(useSin, polySin), _mm_andnot_ps(useSin, polyCos));
+        _cos = _mm_or_ps(_mm_and_ps(useSin, polyCos), _mm_andnot_ps(useSin, polySin));
+        _sin = _mm_xor_ps(_sin, signSin);
+        _cos = _mm_xor_ps(_cos, _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29)));
+    }
+#endif
+
+#if defined(MS_MATH_AVX2)
+    //---------------------------------
+    // 8 angles. Same operations as the 4 wide version (no FMA), so the
+    // results do not depend on the width used
+    //---------------------------------
+    inline void
+    SinCos(__m256 _v, __m256 &_sin, __m256 &_cos) {
+        const __m256    signMask = _mm256_set1_ps(-0.0f);
+        __m256          x        = _mm256_andnot_ps(signMask, _v);
+        __m256          signSin  = _mm256_and_ps(_v, signMask);
+        __m256          y, z, polySin, polyCos, useSin;
+        __m256i         j;
+
+        j = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(1.27323954473516f)));
+        j = _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+        y = _mm256_cvtepi32_ps(j);
+
+        x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(0.78515625f)));
+        x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(2.4187564849853515625e-4f)));
+        x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(3.77489497744594108e-8f)));
+        z = _mm256_mul_ps(x, x);
+
+        polyCos = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(2.443315711809948e-5f), z), _mm256_set1_ps(-1.388731625493765e-3f));
+        polyCos = _mm256_add_ps(_mm256_mul_ps(polyCos, z), _mm256_set1_ps(4.166664568298827e-2f));
+        polyCos = _mm256_mul_ps(_mm256_mul_ps(polyCos, z), z);
+        polyCos = _mm256_add_ps(_mm256_sub_ps(polyCos, _mm256_mul_ps(z, _mm256_set1_ps(0.5f))), _mm256_set1_ps(1.0f));
+
+        polySin = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(-1.9515295891e-4f), z), _mm256_set1_ps(8.3321608736e-3f));
+        polySin = _mm256_add_ps(_mm256_mul_ps(polySin, z), _mm256_set1_ps(-1.6666654611e-1f));
+        polySin = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(polySin, z), x), x);
+
+        useSin  = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(2)), _mm256_setzero_si256()));
+        signSin = _mm256_xor_ps(signSin, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, _mm256_set1_epi32(4)), 29)));
+
+        _sin = _mm256_blendv_ps(polyCos, polySin, useSin);
+        _cos = _mm256_blendv_ps(polySin, polyCos, useSin);
+        _sin = _mm256_xor_ps(_sin, signSin);
+        _cos = _mm256_xor_ps(_cos, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29)));
+    }
+#endif
+
+    //---------------------------------
+    // _sin[i] and _cos[i] of _angles[i] (degrees). The outputs may alias the input.
+    // Uses the SIMD kernels above when available, SinG / CosG otherwise
+    //---------------------------------
+    inline void
+    SinCosG(const float *_angles, float *_sin, float *_cos, size_t _count) {
+        size_t  i = 0;
+
+#if defined(MS_MATH_AVX2)
+        for (; i + 8 <= _count; i += 8) {
+            __m256 s, c;
+
+            SinCos(_mm256_mul_ps(_mm256_loadu_ps(_angles + i), _mm256_set1_ps(Float32::DEGTORAD)), s, c);
+            _mm256_storeu_ps(_sin + i, s);
+            _mm256_storeu_ps(_cos + i, c);
+        }
+#endif
+#if defined(MS_MATH_SSE)
+        for (; i + 4 <= _count; i += 4) {
+            __m128 s, c;
+
+            SinCos(_mm_mul_ps(_mm_loadu_ps(_angles + i), _mm_set1_ps(Float32::DEGTORAD)), s, c);
+            _mm_storeu_ps(_sin + i, s);
+            _mm_storeu_ps(_cos + i, c);
+        }
+
+        if (i < _count) {
+            alignas(16) float   in[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            alignas(16) float   outSin[4], outCos[4];
+            __m128              s, c;
+            size_t              rest = _count - i;
+
+            for (size_t k = 0; k < rest; ++k)
+                in[k] = _angles[i + k];
+
+            SinCos(_mm_mul_ps(_mm_load_ps(in), _mm_set1_ps(Float32::DEGTORAD)), s, c);
+            _mm_store_ps(outSin, s);
+            _mm_store_ps(outCos, c);
+            for (size_t k = 0; k < rest; ++k) {
+                _sin[i + k] = outSin[k];
+                _cos[i + k] = outCos[k];
+            }
+        }
+#else
+        for (; i < _count; ++i) {
+            float angle = _angles[i];
+
+            _sin[i] = SinG(angle);
+            _cos[i] = CosG(angle);
+        }
+#endif
+    }
+
 
     //---------------------------------
     // Interpolation
     //---------------------------------
 
     //---------------------------------
-    inline float    Lerp(float _start, float _end, float _t)        { return _start + (_end - _start) * _t;             }
-    inline float    InvLerp(float _start, float _end, float _value) { return (_value - _start) / (_end - _start);   }
+    constexpr float Lerp(float _start, float _end, float _t)        { return _start + (_end - _start) * _t;             }
+    constexpr float InvLerp(float _start, float _end, float _value) { return (_value - _start) / (_end - _start);   }
 
-    inline float    Remap(float _inMin, float _inMax, float _outMin, float _outMax, float _value)   { 
+    constexpr float Remap(float _inMin, float _inMax, float _outMin, float _outMax, float _value)   { 
         float t = InvLerp(_inMin, _inMax, _value);    
         return Lerp(_outMin, _outMax, t); 
     }
 
-	inline float	RemapClamp(float _inMin, float _inMax, float _outMin, float _outMax, float _value)	{ 
+	constexpr float	RemapClamp(float _inMin, float _inMax, float _outMin, float _outMax, float _value)	{ 
         return Clamp(Remap(_inMin, _inMax, _outMin, _outMax, _value));
     }
 
     /// From simplex noise
     //---------------------------------
-    inline float    Sigma(float _start, float _end, float _t)   { 
+    constexpr float Sigma(float _start, float _end, float _t)   { 
         return _start + (_end - _start) * _t * _t * _t * (_t * (_t * 6 - 15) + 10);   
     }
 
     /// From original perlin noise
-    inline float    SigmaP(float _start, float _end, float _t)  { 
+    constexpr float SigmaP(float _start, float _end, float _t)  { 
         return _start + (_end - _start) * _t * _t * (3 - 2 * _t);     
     }
 
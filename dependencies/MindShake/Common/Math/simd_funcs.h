@@ -0,0 +1,82 @@
+#pragma once
+
+//-------------------------------------
+#include <Common/Math/configMathLib.h>
+#include <Common/Math/constants.h>
+//-------------------------------------
+
+#if defined(MS_MATH_SSE)
+
+//-------------------------------------
+// Lane i of the result is lane _i of _v (_x, _y, _z, _w in memory order)
+//-------------------------------------
+#define MS_SWIZZLE(_v, _x, _y, _z, _w)      _mm_shuffle_ps((_v), (_v), _MM_SHUFFLE(_w, _z, _y, _x))
+
+//-------------------------------------
+namespace MindShake
+{
+
+    //---------------------------------
+    inline __m128   SimdSplat(float _v)                                 { return _mm_set1_ps(_v); }
+    inline __m128   SimdSplatX(__m128 _v)                               { return MS_SWIZZLE(_v, 0, 0, 0, 0); }
+    inline __m128   SimdSplatY(__m128 _v)                               { return MS_SWIZZLE(_v, 1, 1, 1, 1); }
+    inline __m128   SimdSplatZ(__m128 _v)                               { return MS_SWIZZLE(_v, 2, 2, 2, 2); }
+    inline __m128   SimdSplatW(__m128 _v)                               { return MS_SWIZZLE(_v, 3, 3, 3, 3); }
+
+    //---------------------------------
+    // x, y, z of a packed 3 float point. Loading 4 floats touches the next one:
+    // the last point of an array must use the exact (slower) access
+    //---------------------------------
+    inline __m128
+    SimdLoadPoint3(const float *_p, bool _exact) {
+        return _exact ? _mm_setr_ps(_p[0], _p[1], _p[2], 0.0f) : _mm_loadu_ps(_p);
+    }
+
+    //---------------------------------
+    inline void
+    SimdStorePoint3(float *_p, __m128 _v, bool _exact) {
+        if (_exact) {
+            _mm_storel_pi(reinterpret_cast<__m64 *>(_p), _v);
+            _mm_store_ss(_p + 2, _mm_movehl_ps(_v, _v));
+        }
+        else {
+            _mm_storeu_ps(_p, _v);
+        }
+    }
+
+    //---------------------------------
+    // Sum of the products, added in memory order (a0*b0 + a1*b1 + a2*b2 + a3*b3)
+    // so it is bit exact with the scalar code. Result in lane 0
+    //---------------------------------
+    inline __m128
+    SimdDot4(__m128 _a, __m128 _b) {
+        __m128 p = _mm_mul_ps(_a, _b);
+        __m128 s = _mm_add_ss(p, SimdSplatY(p));
+
+        s = _mm_add_ss(s, SimdSplatZ(p));
+        return _mm_add_ss(s, SimdSplatW(p));
+    }
+
+    //---------------------------------
+    // Lanes x, y, z. Lane w is 0 for finite inputs
+    //---------------------------------
+    inline __m128
+    SimdCross3(__m128 _a, __m128 _b) {
+        return _mm_sub_ps(_mm_mul_ps(MS_SWIZZLE(_a, 1, 2, 0, 3), MS_SWIZZLE(_b, 2, 0, 1, 3)),
+                          _mm_mul_ps(MS_SWIZZLE(_a, 2, 0, 1, 3), MS_SWIZZLE(_b, 1, 2, 0, 3)));
+    }
+
+    //---------------------------------
+    // _v / |_v|, or 0 when the squared length is not above ZERO_EPSILON (as InvSqrt)
+    //---------------------------------
+    inline __m128
+    SimdNormalize4(__m128 _v, __m128 _squaredLength) {
+        float len2   = _mm_cvtss_f32(_squaredLength);
+        float invLen = (len2 > Float32::ZERO_EPSILON) ? 1.0f / _mm_cvtss_f32(_mm_sqrt_ss(_squaredLength)) : 0.0f;
+
+        return _mm_mul_ps(_v, _mm_set1_ps(invLen));
+    }
+
+} // end of namespace
+
+#endif
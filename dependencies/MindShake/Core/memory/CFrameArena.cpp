@@ -0,0 +1,187 @@
+#include "CFrameArena.h"
+#include "memory.h"
+//-------------------------------------
+#include <cassert>
+
+namespace MindShake {
+
+    //---------------------------------
+    CLinearArena::CLinearArena(size_t _chunkSize, EMemoryTag _tag) {
+        mChunkSize = (_chunkSize > 0) ? _chunkSize : kDefaultChunkSize;
+        mTag       = _tag;
+    }
+
+    //---------------------------------
+    CLinearArena::~CLinearArena() {
+        Release();
+    }
+
+    //---------------------------------
+    void *
+    CLinearArena::Allocate(size_t _size, size_t _align) {
+        Chunk   *pChunk;
+        void    *ptr;
+
+        assert(_align != 0 && (_align & (_align - 1)) == 0);
+
+        for (;;) {
+            pChunk = mpCurrent.load(std::memory_order_acquire);
+            if (pChunk != nullptr && (ptr = AllocateFromChunk(pChunk, _size, _align)) != nullptr)
+                return ptr;
+
+            if (NextChunk(pChunk, _size, _align) == false)
+                return nullptr;
+        }
+    }
+
+    //---------------------------------
+    void *
+    CLinearArena::AllocateFromChunk(Chunk *_pChunk, size_t _size, size_t _align) {
+        size_t  base  = size_t(_pChunk->GetData());
+        size_t  used  = _pChunk->used.load(std::memory_order_relaxed);
+        size_t  start;
+
+        do {
+            start = ((base + used + _align - 1) & ~(_align - 1)) - base;
+            if (start + _size > _pChunk->capacity)
+                return nullptr;
+        } while (_pChunk->used.compare_exchange_weak(used, start + _size, std::memory_order_relaxed) == false);
+
+        return _pChunk->GetData() + start;
+    }
+
+    //---------------------------------
+    // Moves to the next chunk able to hold the request, reusing the ones kept
+    // by Reset. Another thread may have moved already: then just retry
+    //---------------------------------
+    bool
+    CLinearArena::NextChunk(Chunk *_pFull, size_t _size, size_t _align) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Chunk   *pNext;
+        size_t  needed = _size + _align;
+
+        if (mpCurrent.load(std::memory_order_relaxed) != _pFull)
+            return true;
+
+        pNext = (_pFull != nullptr) ? _pFull->pNext : mpFirst;
+        if (pNext == nullptr || pNext->capacity < needed) {
+            Chunk *pChunk = NewChunk((needed > mChunkSize) ? needed : mChunkSize);
+            if (pChunk == nullptr)
+                return false;
+
+            // Inserted after the full one, so big requests do not drop the rest of the list
+            pChunk->pNext = pNext;
+            if (_pFull != nullptr)
+                _pFull->pNext = pChunk;
+            else
+                mpFirst = pChunk;
+            pNext = pChunk;
+        }
+
+        pNext->used.store(0, std::memory_order_relaxed);
+        mpCurrent.store(pNext, std::memory_order_release);
+
+        return true;
+    }
+
+    //---------------------------------
+    CLinearArena::Chunk *
+    CLinearArena::NewChunk(size_t _capacity) {
+        void    *pMemory;
+        Chunk   *pChunk;
+
+        pMemory = AlignedMalloc(kHeaderSize + _capacity, kChunkAlign, mTag);
+        if (pMemory == nullptr)
+            return nullptr;
+
+        pChunk           = new (pMemory) Chunk;
+        pChunk->pNext    = nullptr;
+        pChunk->capacity = _capacity;
+        pChunk->used.store(0, std::memory_order_relaxed);
+
+        ++mStats.numChunks;
+        mStats.capacity += _capacity;
+
+        return pChunk;
+    }
+
+    //---------------------------------
+    void
+    CLinearArena::Reset() {
+        size_t used = GetBytesUsed();
+
+        if (used > mStats.peak)
+            mStats.peak = used;
+        ++mStats.numResets;
+
+        if (mpFirst != nullptr)
+            mpFirst->used.store(0, std::memory_order_relaxed);
+        mpCurrent.store(mpFirst, std::memory_order_release);
+    }
+
+    //---------------------------------
+    void
+    CLinearArena::Release() {
+        Chunk   *pChunk = mpFirst;
+
+        while (pChunk != nullptr) {
+            Chunk *pNext = pChunk->pNext;
+            pChunk->~Chunk();
+            AlignedFree(pChunk);
+            pChunk = pNext;
+        }
+
+        mpFirst = nullptr;
+        mpCurrent.store(nullptr, std::memory_order_release);
+        mStats.numChunks = 0;
+        mStats.capacity  = 0;
+    }
+
+    //---------------------------------
+    bool
+    CLinearArena::Owns(const void *_ptr) const {
+        const uint8_t   *ptr = static_cast<const uint8_t *>(_ptr);
+
+        for (const Chunk *pChunk = mpFirst; pChunk != nullptr; pChunk = pChunk->pNext) {
+            if (ptr >= pChunk->GetData() && ptr < pChunk->GetData() + pChunk->capacity)
+                return true;
+        }
+
+        return false;
+    }
+
+    //---------------------------------
+    size_t
+    CLinearArena::GetBytesUsed() const {
+        const Chunk *pCurrent = mpCurrent.load(std::memory_order_acquire);
+        size_t      used      = 0;
+
+        if (pCurrent == nullptr)
+            return 0;
+
+        // Chunks before the current one are as full as they got
+        for (const Chunk *pChunk = mpFirst; pChunk != pCurrent; pChunk = pChunk->pNext) {
+            used += pChunk->used.load(std::memory_order_relaxed);
+        }
+
+        return used + pCurrent->used.load(std::memory_order_relaxed);
+    }
+
+    //---------------------------------
+    void
+    CFrameArena::NextFrame() {
+        mCurrent ^= 1;
+        mArenas[mCurrent].Reset();
+        ++mFrame;
+    }
+
+    //---------------------------------
+    size_t
+    CFrameArena::GetPeak() const {
+        size_t peak0 = mArenas[0].GetStats().peak;
+        size_t peak1 = mArenas[1].GetStats().peak;
+
+        return (peak0 > peak1) ? peak0 : peak1;
+    }
+
+} // end of namespace
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "memory.h"
+//-------------------------------------
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//-------------------------------------
+namespace MindShake {
+
+    //---------------------------------
+    struct ArenaStats {
+        size_t  numChunks    { 0 };
+        size_t  capacity     { 0 };     // Bytes in all chunks
+        size_t  peak         { 0 };     // Max bytes used between two resets (updated on Reset)
+        size_t  numResets    { 0 };
+    };
+
+    //---------------------------------
+    // Bump pointer allocator over a list of chunks.
+    // Allocate is lock free (a CAS on the chunk offset); only moving to another
+    // chunk takes a lock. Reset rewinds to the first chunk in O(1) and keeps all
+    // of them, so a warmed up arena never touches the heap again.
+    // Nothing is destroyed: store trivially destructible data only.
+    // Reset must not run concurrently with Allocate.
+    //---------------------------------
+    class CLinearArena {
+        public:
+            static const size_t kDefaultChunkSize = 1024 * 1024;
+            static const size_t kDefaultAlign     = alignof(std::max_align_t);
+
+        public:
+                            CLinearArena(size_t _chunkSize = kDefaultChunkSize, EMemoryTag _tag = EMemoryTag::User);
+                            CLinearArena(const CLinearArena &)   = delete;
+                            CLinearArena(CLinearArena &&)        = delete;
+                            ~CLinearArena();
+
+            CLinearArena &  operator = (const CLinearArena &)    = delete;
+            CLinearArena &  operator = (CLinearArena &&)         = delete;
+
+            // _align must be a power of 2. Returns nullptr only if the heap fails
+            void *          Allocate(size_t _size, size_t _align = kDefaultAlign);
+
+            void            Reset();
+            // Frees all the chunks
+            void            Release();
+
+            bool            Owns(const void *_ptr) const;
+
+            // Bytes handed out (plus alignment padding) since the last reset
+            size_t          GetBytesUsed() const;
+            const ArenaStats &GetStats() const                      { return mStats; }
+
+        protected:
+            struct Chunk {
+                Chunk               *pNext;
+                size_t              capacity;
+                std::atomic<size_t> used;
+
+                uint8_t *           GetData()                       { return reinterpret_cast<uint8_t *>(this) + kHeaderSize; }
+                const uint8_t *     GetData() const                 { return reinterpret_cast<const uint8_t *>(this) + kHeaderSize; }
+            };
+            static const size_t kChunkAlign  = 64;
+            static const size_t kHeaderSize  = (sizeof(Chunk) + kChunkAlign - 1) & ~(kChunkAlign - 1);
+
+            static void *   AllocateFromChunk(Chunk *_pChunk, size_t _size, size_t _align);
+            Chunk *         NewChunk(size_t _capacity);
+            bool            NextChunk(Chunk *_pFull, size_t _size, size_t _align);
+
+        protected:
+            std::atomic<Chunk *>    mpCurrent   { nullptr };
+            Chunk                   *mpFirst    { nullptr };
+            size_t                  mChunkSize  { kDefaultChunkSize };
+            EMemoryTag              mTag        { EMemoryTag::User };
+            std::mutex              mMutex;
+            ArenaStats              mStats;
+    };
+
+    //---------------------------------
+    // Two linear arenas used on alternate frames. NextFrame resets the one used
+    // two frames ago, so anything allocated during a frame stays valid until the
+    // end of the next one (ie. data simulated in frame N and drawn by a pipelined
+    // render in frame N + 1). Call NextFrame while no other thread allocates.
+    //---------------------------------
+    class CFrameArena {
+        public:
+                            CFrameArena(size_t _chunkSize = CLinearArena::kDefaultChunkSize, EMemoryTag _tag = EMemoryTag::User)
+                                : mArenas { CLinearArena(_chunkSize, _tag), CLinearArena(_chunkSize, _tag) } { }
+
+            void *          Allocate(size_t _size)                  { return mArenas[mCurrent].Allocate(_size); }
+            void *          AllocateAligned(size_t _size, size_t _align) { return mArenas[mCurrent].Allocate(_size, _align); }
+
+            // Uninitialized storage for _count T
+            template <typename T>
+            T *             AllocateArray(size_t _count, size_t _align = alignof(T)) {
+                static_assert(std::is_trivially_destructible<T>::value, "Arena memory is released without running destructors");
+                return static_cast<T *>(mArenas[mCurrent].Allocate(sizeof(T) * _count, (_align > alignof(T)) ? _align : alignof(T)));
+            }
+
+            template <typename T, typename... Args>
+            T *             New(Args &&... _args) {
+                static_assert(std::is_trivially_destructible<T>::value, "Arena memory is released without running destructors");
+                void *ptr = mArenas[mCurrent].Allocate(sizeof(T), alignof(T));
+                return (ptr != nullptr) ? new (ptr) T(std::forward<Args>(_args)...) : nullptr;
+            }
+
+            void            NextFrame();
+            void            Release()                               { mArenas[0].Release(); mArenas[1].Release(); }
+
+            uint64_t        GetFrame() const                        { return mFrame;                      }
+            bool            Owns(const void *_ptr) const            { return mArenas[0].Owns(_ptr) || mArenas[1].Owns(_ptr); }
+            size_t          GetBytesUsed() const                    { return mArenas[mCurrent].GetBytesUsed(); }
+            // Both arenas
+            size_t          GetBytesReserved() const                { return mArenas[0].GetStats().capacity + mArenas[1].GetStats().capacity; }
+            size_t          GetPeak() const;
+
+        protected:
+            CLinearArena    mArenas[2];
+            uint32_t        mCurrent    { 0 };
+            uint64_t        mFrame      { 0 };
+    };
+
+} // end of namespace
@@ -0,0 +1,151 @@
+#include "CPoolAllocator.h"
+#include "memory.h"
+//-------------------------------------
+#include <cassert>
+#include <utility>
+
+namespace MindShake {
+
+    //---------------------------------
+    static inline size_t
+    AlignUp(size_t _value, size_t _align) {
+        return (_value + _align - 1) & ~(_align - 1);
+    }
+
+    //---------------------------------
+    CPoolAllocator::CPoolAllocator(size_t _slotSize, size_t _slotAlign, size_t _slotsPerSlab, EMemoryTag _tag) {
+        assert(_slotAlign != 0 && (_slotAlign & (_slotAlign - 1)) == 0);
+
+        if (_slotSize < sizeof(FreeSlot))
+            _slotSize = sizeof(FreeSlot);
+
+        mSlotAlign          = _slotAlign;
+        mTag                = _tag;
+        mStats.slotSize     = AlignUp(_slotSize, _slotAlign);
+        mStats.slotsPerSlab = (_slotsPerSlab > 0) ? _slotsPerSlab : kDefaultSlabSlots;
+    }
+
+    //---------------------------------
+    CPoolAllocator::~CPoolAllocator() {
+        assert(mStats.used == 0 && "CPoolAllocator destroyed with live slots");
+        Release();
+    }
+
+    //---------------------------------
+    void *
+    CPoolAllocator::Allocate() {
+        FreeSlot    *pSlot;
+
+        if (mpFreeList == nullptr) {
+            AddSlab();
+            if (mpFreeList == nullptr)
+                return nullptr;
+        }
+
+        pSlot      = mpFreeList;
+        mpFreeList = pSlot->pNext;
+
+        ++mStats.used;
+        ++mStats.numAllocs;
+        if (mStats.used > mStats.peak)
+            mStats.peak = mStats.used;
+
+        return pSlot;
+    }
+
+    //---------------------------------
+    void
+    CPoolAllocator::Free(void *_ptr) {
+        FreeSlot    *pSlot;
+
+        if (_ptr == nullptr)
+            return;
+
+        assert(Owns(_ptr));
+        assert(mStats.used > 0);
+
+        pSlot        = static_cast<FreeSlot *>(_ptr);
+        pSlot->pNext = mpFreeList;
+        mpFreeList   = pSlot;
+
+        --mStats.used;
+        ++mStats.numFrees;
+    }
+
+    //---------------------------------
+    void
+    CPoolAllocator::Reserve(size_t _numSlots) {
+        while (mStats.capacity < _numSlots) {
+            size_t prevCapacity = mStats.capacity;
+            AddSlab();
+            if (mStats.capacity == prevCapacity)
+                break;
+        }
+    }
+
+    //---------------------------------
+    void
+    CPoolAllocator::Release() {
+        for (uint8_t *pSlab : mSlabs) {
+            AlignedFree(pSlab);
+        }
+        mSlabs.clear();
+
+        mpFreeList      = nullptr;
+        mStats.numSlabs = 0;
+        mStats.capacity = 0;
+        mStats.used     = 0;
+    }
+
+    //---------------------------------
+    bool
+    CPoolAllocator::Owns(const void *_ptr) const {
+        const uint8_t   *ptr = static_cast<const uint8_t *>(_ptr);
+        size_t          slabSize = mStats.slotSize * mStats.slotsPerSlab;
+
+        for (const uint8_t *pSlab : mSlabs) {
+            if (ptr >= pSlab && ptr < pSlab + slabSize) {
+                return ((ptr - pSlab) % mStats.slotSize) == 0;
+            }
+        }
+
+        return false;
+    }
+
+    //---------------------------------
+    void
+    CPoolAllocator::Swap(CPoolAllocator &_other) {
+        assert(mStats.slotSize == _other.mStats.slotSize && mSlotAlign == _other.mSlotAlign);
+
+        mSlabs.swap(_other.mSlabs);
+        std::swap(mpFreeList, _other.mpFreeList);
+        std::swap(mStats, _other.mStats);
+    }
+
+    //---------------------------------
+    void
+    CPoolAllocator::AddSlab() {
+        uint8_t     *pSlab;
+        FreeSlot    *pHead;
+        size_t      i;
+
+        pSlab = static_cast<uint8_t *>(AlignedMalloc(mStats.slotSize * mStats.slotsPerSlab, mSlotAlign, mTag));
+        if (pSlab == nullptr)
+            return;
+
+        mSlabs.push_back(pSlab);
+
+        // Link the new slots so they are handed out in address order
+        pHead = mpFreeList;
+        for (i = mStats.slotsPerSlab; i > 0; --i) {
+            FreeSlot *pSlot = reinterpret_cast<FreeSlot *>(pSlab + (i - 1) * mStats.slotSize);
+            pSlot->pNext = pHead;
+            pHead        = pSlot;
+        }
+        mpFreeList = pHead;
+
+        ++mStats.numSlabs;
+        mStats.capacity += mStats.slotsPerSlab;
+    }
+
+} // end of namespace
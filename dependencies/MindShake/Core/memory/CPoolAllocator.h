@@ -0,0 +1,112 @@
+#pragma once
+
+#include "memory.h"
+//-------------------------------------
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+//-------------------------------------
+namespace MindShake {
+
+    //---------------------------------
+    struct PoolStats {
+        size_t  slotSize     { 0 };     // Bytes per slot (rounded to the slot alignment)
+        size_t  slotsPerSlab { 0 };
+        size_t  numSlabs     { 0 };
+        size_t  capacity     { 0 };     // Total slots in all slabs
+        size_t  used         { 0 };     // Live slots
+        size_t  peak         { 0 };     // Max live slots since creation
+        size_t  numAllocs    { 0 };     // Total allocations since creation
+        size_t  numFrees     { 0 };     // Total frees since creation
+
+        float   GetOccupancy() const    { return (capacity > 0) ? float(used) / float(capacity) : 0.0f; }
+        size_t  GetBytesReserved() const{ return capacity * slotSize; }
+        size_t  GetBytesUsed() const    { return used * slotSize;     }
+    };
+
+    //---------------------------------
+    // Fixed size slot allocator.
+    // Slots live in contiguous slabs, are aligned to 'slotAlign' (a cache line by default)
+    // and freed slots are recycled (LIFO) before a new slab is requested.
+    // Not thread safe.
+    //---------------------------------
+    class CPoolAllocator {
+        public:
+            static const size_t kCacheLineSize    = 64;
+            static const size_t kDefaultSlabSlots = 64;
+
+        public:
+                            CPoolAllocator(size_t _slotSize, size_t _slotAlign = kCacheLineSize, size_t _slotsPerSlab = kDefaultSlabSlots, EMemoryTag _tag = EMemoryTag::User);
+                            CPoolAllocator(const CPoolAllocator &)   = delete;
+                            CPoolAllocator(CPoolAllocator &&)        = delete;
+                            ~CPoolAllocator();
+
+            CPoolAllocator &operator = (const CPoolAllocator &)      = delete;
+            CPoolAllocator &operator = (CPoolAllocator &&)           = delete;
+
+            void *          Allocate();
+            void            Free(void *_ptr);
+
+            // Reserve enough slabs to hold at least _numSlots without growing
+            void            Reserve(size_t _numSlots);
+            // Releases all the slabs. Live objects are NOT destroyed
+            void            Release();
+
+            bool            Owns(const void *_ptr) const;
+
+            // Exchanges slabs, free lists and statistics (slot layout must match)
+            void            Swap(CPoolAllocator &_other);
+
+            size_t          GetSlotSize() const                     { return mStats.slotSize;   }
+            size_t          GetSlotAlign() const                    { return mSlotAlign;        }
+            size_t          GetNumUsed() const                      { return mStats.used;       }
+            const PoolStats&GetStats() const                        { return mStats;            }
+
+        protected:
+            void            AddSlab();
+
+        protected:
+            struct FreeSlot {
+                FreeSlot    *pNext;
+            };
+
+            std::vector<uint8_t *>  mSlabs;
+            FreeSlot                *mpFreeList  { nullptr };
+            size_t                  mSlotAlign   { kCacheLineSize };
+            EMemoryTag              mTag         { EMemoryTag::User };
+            PoolStats               mStats;
+    };
+
+    //---------------------------------
+    // Typed wrapper: constructs / destroys T in pool slots
+    //---------------------------------
+    template <typename T>
+    class CObjectPool {
+        public:
+                            CObjectPool(size_t _slotsPerSlab = CPoolAllocator::kDefaultSlabSlots, EMemoryTag _tag = EMemoryTag::User)
+                                : mPool(sizeof(T), (alignof(T) > CPoolAllocator::kCacheLineSize) ? alignof(T) : CPoolAllocator::kCacheLineSize, _slotsPerSlab, _tag) { }
+
+            template <typename... Args>
+            T *             Create(Args &&... _args)                { return new (mPool.Allocate()) T(std::forward<Args>(_args)...); }
+            void            Destroy(T *_obj)                        { if (_obj != nullptr) { _obj->~T(); mPool.Free(_obj); } }
+
+            // Raw slot access, for owners that construct in place themselves (ie. to relocate objects)
+            void *          AllocateSlot()                          { return mPool.Allocate();      }
+            void            FreeSlot(void *_ptr)                    { mPool.Free(_ptr);             }
+
+            void            Reserve(size_t _numObjects)             { mPool.Reserve(_numObjects);   }
+            void            Release()                               { mPool.Release();              }
+            bool            Owns(const T *_obj) const               { return mPool.Owns(_obj);      }
+            void            Swap(CObjectPool &_other)               { mPool.Swap(_other.mPool);     }
+
+            size_t          GetNumUsed() const                      { return mPool.GetNumUsed();    }
+            const PoolStats&GetStats() const                        { return mPool.GetStats();      }
+
+        protected:
+            CPoolAllocator  mPool;
+    };
+
+} // end of namespace
@@ -0,0 +1,281 @@
+#include "CThreadCacheAllocator.h"
+//-------------------------------------
+#include <cassert>
+#include <cstdlib>
+#include <mutex>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace MindShake {
+
+    //---------------------------------
+    static const uint32_t   kLargeClass  = 0xffffffff;
+    static const size_t     kSpanSize    = 64 * 1024;
+    static const size_t     kBatchBytes  = 8 * 1024;
+
+    //---------------------------------
+    // In front of every block
+    struct BlockHeader {
+        uint32_t    sizeClass;
+        uint32_t    pad;
+        size_t      size;           // Requested bytes (large blocks only)
+    };
+    static_assert(sizeof(BlockHeader) <= CThreadCacheAllocator::kHeaderSize, "BlockHeader does not fit");
+
+    //---------------------------------
+    // Overlaps the header of free blocks
+    struct FreeBlock {
+        FreeBlock   *pNext;
+    };
+
+    //---------------------------------
+    struct CentralList {
+        std::mutex  mutex;
+        FreeBlock   *pHead  { nullptr };
+        void        *pSpans { nullptr };    // Linked through their first word, only to keep them reachable
+    };
+
+    //---------------------------------
+    // Plain data: zero initialized and usable at any time, even after the
+    // flusher ran on thread exit (then those few blocks are simply not returned)
+    struct ThreadCache {
+        FreeBlock   *pLists[CThreadCacheAllocator::kNumClasses];
+        uint32_t    counts[CThreadCacheAllocator::kNumClasses];
+    };
+
+    //---------------------------------
+    struct ThreadCacheFlusher {
+        bool        isRegistered { false };
+                    ~ThreadCacheFlusher() { CThreadCacheAllocator::FlushThreadCache(); }
+    };
+
+    static thread_local ThreadCache         tlsCache;
+    static thread_local ThreadCacheFlusher  tlsFlusher;
+
+    //---------------------------------
+    // Touching it registers the thread exit flush. Done whenever an empty
+    // list of the cache gets blocks, by allocating or by freeing
+    //---------------------------------
+    static inline void
+    RegisterThreadFlush() {
+        tlsFlusher.isRegistered = true;
+    }
+
+    //---------------------------------
+    // Never destroyed: blocks can be freed from static destructors
+    //---------------------------------
+    static CentralList *
+    GetCentralLists() {
+        static CentralList *lists = new CentralList[CThreadCacheAllocator::kNumClasses];
+
+        return lists;
+    }
+
+    //---------------------------------
+    static inline uint32_t
+    Log2(size_t _value) {
+    #if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, uint64_t(_value));
+        return uint32_t(index);
+    #else
+        return uint32_t(63 - __builtin_clzll(uint64_t(_value)));
+    #endif
+    }
+
+    //---------------------------------
+    // 16, 32, ..., 128, then 4 classes per power of 2: 160, 192, 224, 256, 320, ...
+    //---------------------------------
+    uint32_t
+    CThreadCacheAllocator::GetSizeClass(size_t _blockSize) {
+        uint32_t    log2, shift;
+
+        assert(_blockSize > 0 && _blockSize <= kMaxSmallSize);
+        if (_blockSize <= 128)
+            return uint32_t((_blockSize + 15) >> 4) - 1;
+
+        log2  = Log2(_blockSize - 1);           // _blockSize in (2^log2, 2^(log2 + 1)]
+        shift = log2 - 2;
+
+        return 8 + (log2 - 7) * 4 + (uint32_t((_blockSize - 1) >> shift) & 3);
+    }
+
+    //---------------------------------
+    size_t
+    CThreadCacheAllocator::GetClassSize(uint32_t _sizeClass) {
+        uint32_t    group;
+
+        if (_sizeClass < 8)
+            return size_t(_sizeClass + 1) << 4;
+
+        group = (_sizeClass - 8) >> 2;
+
+        return size_t(5 + ((_sizeClass - 8) & 3)) << (group + 5);
+    }
+
+    //---------------------------------
+    static inline uint32_t
+    GetBatchSize(uint32_t _sizeClass) {
+        size_t count = kBatchBytes / CThreadCacheAllocator::GetClassSize(_sizeClass);
+
+        return uint32_t((count < 4) ? 4 : (count > 64) ? 64 : count);
+    }
+
+    //---------------------------------
+    // Moves up to a batch of blocks from the central list to the thread cache,
+    // carving a new span when the central list runs dry
+    //---------------------------------
+    static bool
+    FetchFromCentral(ThreadCache &_cache, uint32_t _sizeClass) {
+        CentralList &central   = GetCentralLists()[_sizeClass];
+        size_t      blockSize  = CThreadCacheAllocator::GetClassSize(_sizeClass);
+        uint32_t    batch      = GetBatchSize(_sizeClass);
+        uint32_t    count      = 0;
+
+        RegisterThreadFlush();
+
+        std::lock_guard<std::mutex> lock(central.mutex);
+        if (central.pHead == nullptr) {
+            size_t  spanSize = (blockSize * batch > kSpanSize) ? blockSize * batch : kSpanSize;
+            uint8_t *pSpan   = static_cast<uint8_t *>(malloc(spanSize));
+
+            if (pSpan == nullptr)
+                return false;
+
+            // First block keeps the span list, the rest go to the free list in address order
+            *reinterpret_cast<void **>(pSpan) = central.pSpans;
+            central.pSpans = pSpan;
+            for (size_t offset = (spanSize / blockSize - 1) * blockSize; offset > 0; offset -= blockSize) {
+                FreeBlock *pBlock = reinterpret_cast<FreeBlock *>(pSpan + offset);
+                pBlock->pNext = central.pHead;
+                central.pHead = pBlock;
+            }
+        }
+
+        while (central.pHead != nullptr && count < batch) {
+            FreeBlock *pBlock = central.pHead;
+            central.pHead = pBlock->pNext;
+            pBlock->pNext = _cache.pLists[_sizeClass];
+            _cache.pLists[_sizeClass] = pBlock;
+            ++count;
+        }
+        _cache.counts[_sizeClass] += count;
+
+        return count > 0;
+    }
+
+    //---------------------------------
+    static void
+    ReturnToCentral(ThreadCache &_cache, uint32_t _sizeClass, uint32_t _count) {
+        CentralList &central = GetCentralLists()[_sizeClass];
+        FreeBlock   *pFirst, *pLast;
+        uint32_t    count;
+
+        pFirst = pLast = _cache.pLists[_sizeClass];
+        if (pFirst == nullptr || _count == 0)
+            return;
+
+        for (count = 1; count < _count && pLast->pNext != nullptr; ++count) {
+            pLast = pLast->pNext;
+        }
+        _cache.pLists[_sizeClass]  = pLast->pNext;
+        _cache.counts[_sizeClass] -= count;
+
+        std::lock_guard<std::mutex> lock(central.mutex);
+        pLast->pNext  = central.pHead;
+        central.pHead = pFirst;
+    }
+
+    //---------------------------------
+    void *
+    CThreadCacheAllocator::Allocate(size_t _size) {
+        BlockHeader *pHeader;
+        size_t      blockSize = _size + kHeaderSize;
+
+        if (blockSize < _size)
+            return nullptr;
+
+        if (blockSize > kMaxSmallSize) {
+            pHeader = static_cast<BlockHeader *>(malloc(blockSize));
+            if (pHeader == nullptr)
+                return nullptr;
+
+            pHeader->sizeClass = kLargeClass;
+            pHeader->size      = _size;
+        }
+        else {
+            ThreadCache &cache     = tlsCache;
+            uint32_t    sizeClass  = GetSizeClass(blockSize);
+
+            if (cache.pLists[sizeClass] == nullptr && FetchFromCentral(cache, sizeClass) == false)
+                return nullptr;
+
+            FreeBlock *pBlock = cache.pLists[sizeClass];
+            cache.pLists[sizeClass] = pBlock->pNext;
+            --cache.counts[sizeClass];
+
+            pHeader = reinterpret_cast<BlockHeader *>(pBlock);
+            pHeader->sizeClass = sizeClass;
+        }
+
+        return reinterpret_cast<uint8_t *>(pHeader) + kHeaderSize;
+    }
+
+    //---------------------------------
+    void
+    CThreadCacheAllocator::Free(void *_ptr) {
+        BlockHeader *pHeader;
+        uint32_t    sizeClass;
+
+        if (_ptr == nullptr)
+            return;
+
+        pHeader   = reinterpret_cast<BlockHeader *>(static_cast<uint8_t *>(_ptr) - kHeaderSize);
+        sizeClass = pHeader->sizeClass;
+        if (sizeClass == kLargeClass) {
+            free(pHeader);
+            return;
+        }
+
+        assert(sizeClass < kNumClasses);
+
+        // Into the cache of the thread freeing it. Past two batches, one goes back
+        ThreadCache &cache  = tlsCache;
+        FreeBlock   *pBlock = reinterpret_cast<FreeBlock *>(pHeader);
+        if (cache.pLists[sizeClass] == nullptr)
+            RegisterThreadFlush();
+
+        pBlock->pNext = cache.pLists[sizeClass];
+        cache.pLists[sizeClass] = pBlock;
+        if (++cache.counts[sizeClass] > 2 * GetBatchSize(sizeClass))
+            ReturnToCentral(cache, sizeClass, GetBatchSize(sizeClass));
+    }
+
+    //---------------------------------
+    size_t
+    CThreadCacheAllocator::GetBlockSize(const void *_ptr) {
+        const BlockHeader *pHeader;
+
+        if (_ptr == nullptr)
+            return 0;
+
+        pHeader = reinterpret_cast<const BlockHeader *>(static_cast<const uint8_t *>(_ptr) - kHeaderSize);
+        if (pHeader->sizeClass == kLargeClass)
+            return pHeader->size;
+
+        return GetClassSize(pHeader->sizeClass) - kHeaderSize;
+    }
+
+    //---------------------------------
+    void
+    CThreadCacheAllocator::FlushThreadCache() {
+        ThreadCache &cache = tlsCache;
+
+        for (uint32_t sizeClass = 0; sizeClass < kNumClasses; ++sizeClass) {
+            ReturnToCentral(cache, sizeClass, cache.counts[sizeClass]);
+        }
+    }
+
+} // end of namespace
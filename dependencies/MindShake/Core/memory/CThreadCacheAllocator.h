@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//-------------------------------------
+namespace MindShake {
+
+    //---------------------------------
+    // Size class allocator behind Malloc / Free.
+    // Small blocks (up to kMaxSmallSize) are rounded to one of kNumClasses sizes
+    // (4 per power of 2, so at most 25% waste) and come from a per thread cache:
+    // no lock at all. Caches move blocks in batches to / from a central free
+    // list per class (one mutex each), so a thread freeing what another one
+    // allocated does not grow forever. Bigger blocks go to malloc.
+    // Spans carved for small blocks are never given back to the system.
+    //---------------------------------
+    class CThreadCacheAllocator {
+        public:
+            static const size_t     kHeaderSize   = 16;         // Keeps 16 byte alignment
+            static const size_t     kMaxSmallSize = 32 * 1024;  // Including the header
+            static const uint32_t   kNumClasses   = 40;
+
+        public:
+            static void *   Allocate(size_t _size);
+            static void     Free(void *_ptr);
+
+            // Usable bytes of a block returned by Allocate
+            static size_t   GetBlockSize(const void *_ptr);
+
+            // Returns the cached blocks of the calling thread to the central lists
+            // (also done when the thread exits)
+            static void     FlushThreadCache();
+
+            static uint32_t GetSizeClass(size_t _blockSize);
+            static size_t   GetClassSize(uint32_t _sizeClass);
+    };
+
+} // end of namespace
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "memory.h"
+#include "CPoolAllocator.h"
+#include "CFrameArena.h"
+//-------------------------------------
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+//-------------------------------------
+namespace MindShake {
+
+    //---------------------------------
+    // Standard allocators (C++17 minimal interface) over the MindShake memory
+    // functions, so engine containers get a known alignment or come from a
+    // pool / arena. The ones with non type template parameters need their
+    // own rebind: the std::allocator_traits default only handles type ones
+    //---------------------------------
+
+    //---------------------------------
+    // AlignedMalloc: data() is aligned to Align (a cache line by default), so
+    // SIMD kernels can use aligned loads from the first element.
+    //   std::vector<float, CAlignedAllocator<float>>
+    //---------------------------------
+    template <typename T, size_t Align = 64, EMemoryTag Tag = EMemoryTag::User>
+    class CAlignedAllocator {
+        static_assert(Align != 0 && (Align & (Align - 1)) == 0, "Align must be a power of 2");
+
+        public:
+            using value_type = T;
+
+            static const size_t kAlign = (Align > alignof(T)) ? Align : alignof(T);
+
+            template <typename U>
+            struct rebind {
+                using other = CAlignedAllocator<U, Align, Tag>;
+            };
+
+        public:
+                            CAlignedAllocator() noexcept = default;
+            template <typename U>
+                            CAlignedAllocator(const CAlignedAllocator<U, Align, Tag> &) noexcept { }
+
+            T *             allocate(size_t _count) {
+                                void *ptr = AlignedMalloc(_count * sizeof(T), kAlign, Tag);
+                                if (ptr == nullptr)
+                                    throw std::bad_alloc();
+                                return static_cast<T *>(ptr);
+                            }
+            void            deallocate(T *_ptr, size_t) noexcept    { AlignedFree(_ptr); }
+
+            template <typename U>
+            bool            operator == (const CAlignedAllocator<U, Align, Tag> &) const noexcept { return true;  }
+            template <typename U>
+            bool            operator != (const CAlignedAllocator<U, Align, Tag> &) const noexcept { return false; }
+    };
+
+    //---------------------------------
+    // Single objects from a CPoolAllocator, for node based containers
+    // (std::list, std::map, ...). Arrays, or nodes that do not fit a slot,
+    // fall back to AlignedMalloc. Not thread safe, as the pool.
+    //   CPoolAllocator pool(64);
+    //   std::list<int, CPoolSlotAllocator<int>> list { CPoolSlotAllocator<int>(pool) };
+    //---------------------------------
+    template <typename T>
+    class CPoolSlotAllocator {
+        template <typename U> friend class CPoolSlotAllocator;
+
+        public:
+            using value_type = T;
+
+            using propagate_on_container_copy_assignment = std::true_type;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap            = std::true_type;
+
+        public:
+                            CPoolSlotAllocator(CPoolAllocator &_pool) noexcept : mpPool(&_pool) { }
+            template <typename U>
+                            CPoolSlotAllocator(const CPoolSlotAllocator<U> &_other) noexcept : mpPool(_other.mpPool) { }
+
+            T *             allocate(size_t _count) {
+                                void *ptr = UsesPool(_count) ? mpPool->Allocate() : AlignedMalloc(_count * sizeof(T), alignof(T));
+                                if (ptr == nullptr)
+                                    throw std::bad_alloc();
+                                return static_cast<T *>(ptr);
+                            }
+            void            deallocate(T *_ptr, size_t _count) noexcept {
+                                if (UsesPool(_count))
+                                    mpPool->Free(_ptr);
+                                else
+                                    AlignedFree(_ptr);
+                            }
+
+            CPoolAllocator *GetPool() const                         { return mpPool; }
+
+            template <typename U>
+            bool            operator == (const CPoolSlotAllocator<U> &_other) const noexcept { return mpPool == _other.mpPool; }
+            template <typename U>
+            bool            operator != (const CPoolSlotAllocator<U> &_other) const noexcept { return mpPool != _other.mpPool; }
+
+        protected:
+            bool            UsesPool(size_t _count) const           { return _count == 1 && sizeof(T) <= mpPool->GetSlotSize() && alignof(T) <= mpPool->GetSlotAlign(); }
+
+        protected:
+            CPoolAllocator  *mpPool;
+    };
+
+    //---------------------------------
+    // Storage from a CFrameArena: containers built during a frame, valid until
+    // the end of the next one (see CFrameArena). deallocate does nothing, so
+    // reserve up front: every reallocation leaves the old block in the arena.
+    //   std::vector<uint32_t, CArenaAllocator<uint32_t>> bins { CArenaAllocator<uint32_t>(window.GetFrameArena()) };
+    //---------------------------------
+    template <typename T>
+    class CArenaAllocator {
+        template <typename U> friend class CArenaAllocator;
+
+        public:
+            using value_type = T;
+
+            using propagate_on_container_copy_assignment = std::true_type;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap            = std::true_type;
+
+        public:
+                            CArenaAllocator(CFrameArena &_arena) noexcept : mpArena(&_arena) { }
+            template <typename U>
+                            CArenaAllocator(const CArenaAllocator<U> &_other) noexcept : mpArena(_other.mpArena) { }
+
+            T *             allocate(size_t _count) {
+                                void *ptr = mpArena->AllocateAligned(_count * sizeof(T), (alignof(T) > CLinearArena::kDefaultAlign) ? alignof(T) : CLinearArena::kDefaultAlign);
+                                if (ptr == nullptr)
+                                    throw std::bad_alloc();
+                                return static_cast<T *>(ptr);
+                            }
+            void            deallocate(T *, size_t) noexcept        { }
+
+            CFrameArena *   GetArena() const                        { return mpArena; }
+
+            template <typename U>
+            bool            operator == (const CArenaAllocator<U> &_other) const noexcept { return mpArena == _other.mpArena; }
+            template <typename U>
+            bool            operator != (const CArenaAllocator<U> &_other) const noexcept { return mpArena != _other.mpArena; }
+
+        protected:
+            CFrameArena     *mpArena;
+    };
+
+    //---------------------------------
+    // Standard allocator over LargeMalloc: small arrays come from the heap
+    // (64 byte aligned), big ones from huge page backed mappings.
+    //   std::vector<vec3, CLargePageAllocator<vec3>>
+    //---------------------------------
+    template <typename T, EMemoryTag Tag = EMemoryTag::User>
+    class CLargePageAllocator {
+        public:
+            using value_type = T;
+
+            template <typename U>
+            struct rebind {
+                using other = CLargePageAllocator<U, Tag>;
+            };
+
+        public:
+                            CLargePageAllocator() noexcept = default;
+            template <typename U>
+                            CLargePageAllocator(const CLargePageAllocator<U, Tag> &) noexcept { }
+
+            T *             allocate(size_t _count) {
+                                void *ptr = LargeMalloc(_count * sizeof(T), Tag);
+                                if (ptr == nullptr)
+                                    throw std::bad_alloc();
+                                return static_cast<T *>(ptr);
+                            }
+            void            deallocate(T *_ptr, size_t _count) noexcept { LargeFree(_ptr, _count * sizeof(T), Tag); }
+
+            template <typename U>
+            bool            operator == (const CLargePageAllocator<U, Tag> &) const noexcept { return true;  }
+            template <typename U>
+            bool            operator != (const CLargePageAllocator<U, Tag> &) const noexcept { return false; }
+    };
+
+} // end of namespace
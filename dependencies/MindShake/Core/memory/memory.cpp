@@ -1,20 +1,224 @@
 #include "memory.h"
+#include "CThreadCacheAllocator.h"
+//-------------------------------------
+#include <Common/Core/platform.h>
 //-------------------------------------
 #include <cstdlib>
+#include <cstdio>
 #include <string.h>
+#if defined(MS_MEMORY_TRACKING)
+    #include <atomic>
+#endif
+#if defined(TARGET_PLATFORM_WINDOWS)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
 
 namespace MindShake {
 
     //---------------------------------
-    void *
-    Malloc(size_t size) {
+    static inline void *
+    BackendMalloc(size_t size) {
+    #if defined(MS_MEMORY_SYSTEM_MALLOC)
         return malloc(size);
+    #else
+        return CThreadCacheAllocator::Allocate(size);
+    #endif
     }
 
     //---------------------------------
-    void 
-    Free(void *ptr) {
+    static inline void
+    BackendFree(void *ptr) {
+    #if defined(MS_MEMORY_SYSTEM_MALLOC)
         free(ptr);
+    #else
+        CThreadCacheAllocator::Free(ptr);
+    #endif
+    }
+
+    //---------------------------------
+    static const char *kMemoryTagNames[] = { "user", "scene", "mesh", "renderer" };
+    static_assert(sizeof(kMemoryTagNames) / sizeof(kMemoryTagNames[0]) == size_t(EMemoryTag::Count), "Missing tag names");
+
+    //---------------------------------
+    const char *
+    GetMemoryTagName(EMemoryTag tag) {
+        return (tag < EMemoryTag::Count) ? kMemoryTagNames[size_t(tag)] : "unknown";
+    }
+
+#if defined(MS_MEMORY_TRACKING)
+    //---------------------------------
+    // In front of every tracked block. 16 bytes keep the backend alignment
+    struct alignas(16) TrackingHeader {
+        size_t      size;
+        EMemoryTag  tag;
+    };
+
+    //---------------------------------
+    // Zero initialized (static storage), so usable before any constructor runs
+    struct TagCounters {
+        std::atomic<size_t> bytes;
+        std::atomic<size_t> count;
+        std::atomic<size_t> peakBytes;
+        std::atomic<size_t> totalAllocs;
+        std::atomic<size_t> totalFrees;
+        std::atomic<size_t> currentFrameAllocs;
+        std::atomic<size_t> currentFrameBytes;
+        std::atomic<size_t> frameAllocs;
+        std::atomic<size_t> frameBytes;
+        std::atomic<size_t> peakFrameBytes;
+    };
+
+    static TagCounters  sTagCounters[size_t(EMemoryTag::Count)];
+
+    //---------------------------------
+    static inline void
+    UpdateMax(std::atomic<size_t> &max, size_t value) {
+        size_t current = max.load(std::memory_order_relaxed);
+
+        while (value > current && max.compare_exchange_weak(current, value, std::memory_order_relaxed) == false) {
+        }
+    }
+
+    //---------------------------------
+    static inline void
+    TrackAlloc(EMemoryTag tag, size_t size) {
+        TagCounters &counters = sTagCounters[(tag < EMemoryTag::Count) ? size_t(tag) : 0];
+
+        UpdateMax(counters.peakBytes, counters.bytes.fetch_add(size, std::memory_order_relaxed) + size);
+        counters.count.fetch_add(1, std::memory_order_relaxed);
+        counters.totalAllocs.fetch_add(1, std::memory_order_relaxed);
+        counters.currentFrameAllocs.fetch_add(1, std::memory_order_relaxed);
+        counters.currentFrameBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    //---------------------------------
+    static inline void
+    TrackFree(EMemoryTag tag, size_t size) {
+        TagCounters &counters = sTagCounters[(tag < EMemoryTag::Count) ? size_t(tag) : 0];
+
+        counters.bytes.fetch_sub(size, std::memory_order_relaxed);
+        counters.count.fetch_sub(1, std::memory_order_relaxed);
+        counters.totalFrees.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //---------------------------------
+    void *
+    Malloc(size_t size, EMemoryTag tag) {
+        TrackingHeader  *pHeader;
+
+        pHeader = static_cast<TrackingHeader *>(BackendMalloc(size + sizeof(TrackingHeader)));
+        if (pHeader == nullptr)
+            return nullptr;
+
+        pHeader->size = size;
+        pHeader->tag  = (tag < EMemoryTag::Count) ? tag : EMemoryTag::User;
+        TrackAlloc(pHeader->tag, size);
+
+        return pHeader + 1;
+    }
+
+    //---------------------------------
+    void
+    Free(void *ptr) {
+        TrackingHeader  *pHeader;
+
+        if (ptr == nullptr)
+            return;
+
+        pHeader = static_cast<TrackingHeader *>(ptr) - 1;
+        TrackFree(pHeader->tag, pHeader->size);
+
+        BackendFree(pHeader);
+    }
+
+    //---------------------------------
+    bool
+    GetMemoryStats(EMemoryTag tag, MemoryTagStats &stats) {
+        if (tag >= EMemoryTag::Count)
+            return false;
+
+        const TagCounters &counters = sTagCounters[size_t(tag)];
+        stats.bytes          = counters.bytes.load(std::memory_order_relaxed);
+        stats.count          = counters.count.load(std::memory_order_relaxed);
+        stats.peakBytes      = counters.peakBytes.load(std::memory_order_relaxed);
+        stats.totalAllocs    = counters.totalAllocs.load(std::memory_order_relaxed);
+        stats.totalFrees     = counters.totalFrees.load(std::memory_order_relaxed);
+        stats.frameAllocs    = counters.frameAllocs.load(std::memory_order_relaxed);
+        stats.frameBytes     = counters.frameBytes.load(std::memory_order_relaxed);
+        stats.peakFrameBytes = counters.peakFrameBytes.load(std::memory_order_relaxed);
+
+        return true;
+    }
+
+    //---------------------------------
+    void
+    MemoryNextFrame() {
+        for (TagCounters &counters : sTagCounters) {
+            size_t frameBytes = counters.currentFrameBytes.exchange(0, std::memory_order_relaxed);
+
+            counters.frameAllocs.store(counters.currentFrameAllocs.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+            counters.frameBytes.store(frameBytes, std::memory_order_relaxed);
+            UpdateMax(counters.peakFrameBytes, frameBytes);
+        }
+    }
+
+#else
+    //---------------------------------
+    static inline void TrackAlloc(EMemoryTag, size_t)   { }
+    static inline void TrackFree(EMemoryTag, size_t)    { }
+
+    //---------------------------------
+    void *
+    Malloc(size_t size, EMemoryTag) {
+        return BackendMalloc(size);
+    }
+
+    //---------------------------------
+    void
+    Free(void *ptr) {
+        BackendFree(ptr);
+    }
+
+    //---------------------------------
+    bool
+    GetMemoryStats(EMemoryTag, MemoryTagStats &stats) {
+        stats = MemoryTagStats();
+
+        return false;
+    }
+
+    //---------------------------------
+    void
+    MemoryNextFrame() {
+    }
+#endif
+
+    //---------------------------------
+    bool
+    DumpMemoryStats(const char *filename) {
+        MemoryTagStats  stats;
+        FILE            *pFile;
+
+        if (GetMemoryStats(EMemoryTag::User, stats) == false)
+            return false;
+
+        if ((pFile = fopen(filename, "w")) == nullptr)
+            return false;
+
+        fprintf(pFile, "%-10s %14s %10s %14s %12s %12s %12s %14s %14s\n",
+                "tag", "bytes", "blocks", "peak bytes", "allocs", "frees", "frame allocs", "frame bytes", "peak frame");
+        for (size_t i = 0; i < size_t(EMemoryTag::Count); ++i) {
+            GetMemoryStats(EMemoryTag(i), stats);
+            fprintf(pFile, "%-10s %14zu %10zu %14zu %12zu %12zu %12zu %14zu %14zu\n",
+                    GetMemoryTagName(EMemoryTag(i)), stats.bytes, stats.count, stats.peakBytes,
+                    stats.totalAllocs, stats.totalFrees, stats.frameAllocs, stats.frameBytes, stats.peakFrameBytes);
+        }
+        fclose(pFile);
+
+        return true;
     }
 
     //---------------------------------
@@ -32,14 +236,14 @@ namespace MindShake {
 
     //---------------------------------
     void *
-    AlignedMalloc(size_t size, size_t align) {
+    AlignedMalloc(size_t size, size_t align, EMemoryTag tag) {
         void        *pOrig;
         void        **pAlign;
         ptrdiff_t   offset;
     
         align = NextPowerOfTwo(align) - 1;
         offset = align + sizeof(void *);
-        if ((pOrig = (void *) malloc(size + offset)) == nullptr) {
+        if ((pOrig = Malloc(size + offset, tag)) == nullptr) {
            return nullptr;
         }
 
@@ -49,4 +253,131 @@ namespace MindShake {
         return pAlign;
     }
 
-} // end of namespace
\ No newline at end of file
+    //---------------------------------
+    // Large allocations
+    //---------------------------------
+    static inline size_t
+    GetLargeLength(size_t size) {
+        return (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    }
+
+#if defined(TARGET_PLATFORM_WINDOWS)
+    //---------------------------------
+    // MEM_LARGE_PAGES needs the "Lock pages in memory" privilege: usually
+    // it fails and the range gets normal pages
+    //---------------------------------
+    static void *
+    MapLarge(size_t length, ELargePageKind &kind) {
+        size_t  largePage = GetLargePageMinimum();
+        void    *ptr;
+
+        if (largePage != 0 && (length % largePage) == 0) {
+            ptr = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (ptr != nullptr) {
+                kind = ELargePageKind::Huge;
+                return ptr;
+            }
+        }
+
+        kind = ELargePageKind::Normal;
+        return VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    }
+
+    //---------------------------------
+    static void
+    UnmapLarge(void *ptr, size_t) {
+        VirtualFree(ptr, 0, MEM_RELEASE);
+    }
+
+#else
+    //---------------------------------
+    // 1. Explicit huge pages (only if the admin reserved some: vm.nr_hugepages)
+    // 2. Transparent huge pages: a huge page aligned range + MADV_HUGEPAGE
+    //---------------------------------
+    static void *
+    MapLarge(size_t length, ELargePageKind &kind) {
+        const int   prot  = PROT_READ | PROT_WRITE;
+        const int   flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        uint8_t     *pRaw, *pAligned;
+        size_t      head, tail;
+        void        *ptr;
+
+    #if defined(MAP_HUGETLB)
+        #if defined(MAP_HUGE_2MB)
+        ptr = mmap(nullptr, length, prot, flags | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+        #else
+        ptr = mmap(nullptr, length, prot, flags | MAP_HUGETLB, -1, 0);
+        #endif
+        if (ptr != MAP_FAILED) {
+            kind = ELargePageKind::Huge;
+            return ptr;
+        }
+    #endif
+
+        ptr = mmap(nullptr, length + kHugePageSize, prot, flags, -1, 0);
+        if (ptr == MAP_FAILED)
+            return nullptr;
+
+        // Trim to a huge page boundary, so the kernel can back it with huge pages
+        pRaw     = static_cast<uint8_t *>(ptr);
+        pAligned = reinterpret_cast<uint8_t *>((size_t(pRaw) + kHugePageSize - 1) & ~(kHugePageSize - 1));
+        head     = size_t(pAligned - pRaw);
+        tail     = kHugePageSize - head;
+        if (head != 0)
+            munmap(pRaw, head);
+        if (tail != 0)
+            munmap(pAligned + length, tail);
+
+        kind = ELargePageKind::Normal;
+    #if defined(MADV_HUGEPAGE)
+        if (madvise(pAligned, length, MADV_HUGEPAGE) == 0)
+            kind = ELargePageKind::Transparent;
+    #endif
+
+        return pAligned;
+    }
+
+    //---------------------------------
+    static void
+    UnmapLarge(void *ptr, size_t length) {
+        munmap(ptr, length);
+    }
+#endif
+
+    //---------------------------------
+    void *
+    LargeMalloc(size_t size, EMemoryTag tag, ELargePageKind *pKind) {
+        ELargePageKind  kind = ELargePageKind::Heap;
+        void            *ptr;
+
+        if (size < kLargeAllocThreshold) {
+            ptr = AlignedMalloc(size, 64, tag);
+        }
+        else {
+            ptr = MapLarge(GetLargeLength(size), kind);
+            if (ptr != nullptr)
+                TrackAlloc(tag, GetLargeLength(size));
+        }
+
+        if (pKind != nullptr)
+            *pKind = kind;
+
+        return ptr;
+    }
+
+    //---------------------------------
+    void
+    LargeFree(void *ptr, size_t size, EMemoryTag tag) {
+        if (ptr == nullptr)
+            return;
+
+        if (size < kLargeAllocThreshold) {
+            AlignedFree(ptr);
+        }
+        else {
+            TrackFree(tag, GetLargeLength(size));
+            UnmapLarge(ptr, GetLargeLength(size));
+        }
+    }
+
+} // end of namespace
@@ -6,13 +6,26 @@
 //-------------------------------------
 namespace MindShake {
 
-    void *Malloc(size_t size);
+    //---------------------------------
+    // Subsystem an allocation is attributed to (MS_MEMORY_TRACKING builds)
+    enum class EMemoryTag : uint8_t {
+        User,
+        Scene,
+        Mesh,
+        Renderer,
+
+        Count
+    };
+
+    // Small blocks come from per thread caches (see CThreadCacheAllocator).
+    // Define MS_MEMORY_SYSTEM_MALLOC to use malloc / free directly (ie. for sanitizers)
+    void *Malloc(size_t size, EMemoryTag tag = EMemoryTag::User);
     void Free(void *ptr);
 
     // align must be a power of 2
-    void *AlignedMalloc(size_t size, size_t align);
+    void *AlignedMalloc(size_t size, size_t align, EMemoryTag tag = EMemoryTag::User);
 
-    template <typename T> 
+    template <typename T>
     void AlignedFree(T *&ptr) {
         if (ptr != nullptr) {
             Free(((void **) ptr)[-1]);
@@ -20,4 +33,47 @@ namespace MindShake {
         }
     }
 
+    //---------------------------------
+    // Big buffers (render targets, vertex streams). From kLargeAllocThreshold
+    // up they are mapped directly, rounded to kHugePageSize, trying to get huge
+    // pages (fewer TLB misses on random access): explicit ones first, then
+    // transparent huge pages. Smaller ones are AlignedMalloc(size, 64).
+    // LargeFree needs the same size and tag used to allocate
+    //---------------------------------
+    static const size_t kHugePageSize        = 2 * 1024 * 1024;
+    static const size_t kLargeAllocThreshold = 1024 * 1024;
+
+    enum class ELargePageKind : uint8_t {
+        Heap,           // Under the threshold
+        Normal,         // Mapped, normal pages
+        Transparent,    // Mapped, transparent huge pages requested (the kernel may still not use them)
+        Huge,           // Mapped on reserved huge pages
+    };
+
+    void *LargeMalloc(size_t size, EMemoryTag tag = EMemoryTag::User, ELargePageKind *pKind = nullptr);
+    void LargeFree(void *ptr, size_t size, EMemoryTag tag = EMemoryTag::User);
+
+    //---------------------------------
+    // Tracking. Compiled in with MS_MEMORY_TRACKING (CMake option MINDSHAKE_MEMORY_TRACKING);
+    // otherwise the queries return false and cost nothing
+    //---------------------------------
+    struct MemoryTagStats {
+        size_t  bytes          { 0 };   // Live bytes (requested sizes)
+        size_t  count          { 0 };   // Live blocks
+        size_t  peakBytes      { 0 };   // High-water mark of bytes
+        size_t  totalAllocs    { 0 };
+        size_t  totalFrees     { 0 };
+        size_t  frameAllocs    { 0 };   // Allocations during the last complete frame
+        size_t  frameBytes     { 0 };   // Bytes allocated during the last complete frame
+        size_t  peakFrameBytes { 0 };   // Max frameBytes seen
+    };
+
+    const char *GetMemoryTagName(EMemoryTag tag);
+
+    bool GetMemoryStats(EMemoryTag tag, MemoryTagStats &stats);
+    // Closes the per frame counters (CWindow calls it once per frame)
+    void MemoryNextFrame();
+    // Text table, one line per tag
+    bool DumpMemoryStats(const char *filename);
+
 } // end of namespace
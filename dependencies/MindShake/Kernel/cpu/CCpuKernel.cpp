@@ -0,0 +1,49 @@
+#include "CCpuKernel.h"
+//-------------------------------------
+#include <Core/log/log.h>
+//-------------------------------------
+
+namespace MindShake {
+
+    //---------------------------------
+    // Zero initialized before any kernel constructor runs
+    CCpuKernelBase *CCpuKernelBase::smFirst = nullptr;
+
+    //---------------------------------
+    CCpuKernelBase::CCpuKernelBase(const char *name) : mName(name) {
+        mNext   = smFirst;
+        smFirst = this;
+    }
+
+    //---------------------------------
+    CCpuKernelBase::~CCpuKernelBase() {
+        for (CCpuKernelBase **link = &smFirst; *link != nullptr; link = &(*link)->mNext) {
+            if (*link == this) {
+                *link = mNext;
+                break;
+            }
+        }
+    }
+
+    //---------------------------------
+    void
+    CCpuKernelBase::BindAll(ECpuLevel level) {
+        for (CCpuKernelBase *kernel = smFirst; kernel != nullptr; kernel = kernel->mNext) {
+            kernel->Bind(level);
+        }
+    }
+
+    //---------------------------------
+    void
+    CCpuKernelBase::LogAll() {
+        const CpuFeatures &f = GetCpuFeatures();
+
+        MS_LOG("CPU: sse2 %d, sse4.1 %d, avx %d, avx2 %d, fma %d, avx512 f %d bw %d vl %d",
+               f.sse2, f.sse41, f.avx, f.avx2, f.fma, f.avx512f, f.avx512bw, f.avx512vl);
+        MS_LOG("CPU level: %s (detected %s)", GetCpuLevelName(GetCpuLevel()), GetCpuLevelName(GetDetectedCpuLevel()));
+        for (const CCpuKernelBase *kernel = smFirst; kernel != nullptr; kernel = kernel->mNext) {
+            MS_LOG(" - %-28s %s", kernel->mName, GetCpuLevelName(kernel->mVariant));
+        }
+    }
+
+} // end of namespace
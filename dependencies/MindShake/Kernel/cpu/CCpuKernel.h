@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Kernel/cpu/cpuFeatures.h>
+//-------------------------------------
+#include <cstddef>
+#include <initializer_list>
+
+//-------------------------------------
+namespace MindShake {
+
+    //---------------------------------
+    // Registry of the dispatched kernels, so the chosen variants can be
+    // listed and rebound when the CPU level changes
+    //---------------------------------
+    class CCpuKernelBase {
+        friend void SetCpuLevel(ECpuLevel);
+
+        public:
+            const char *    GetName() const                 { return mName;     }
+            ECpuLevel       GetVariant() const              { return mVariant;  }
+
+            static const CCpuKernelBase *   GetFirst()      { return smFirst;   }
+            const CCpuKernelBase *          GetNext() const { return mNext;     }
+
+            // Logs the CPU features and the variant of every kernel
+            static void     LogAll();
+
+        protected:
+                            CCpuKernelBase(const char *name);
+            virtual         ~CCpuKernelBase();
+
+            virtual void    Bind(ECpuLevel level) = 0;
+            static void     BindAll(ECpuLevel level);
+
+        protected:
+            const char      *mName;
+            ECpuLevel       mVariant { ECpuLevel::Scalar };
+            CCpuKernelBase  *mNext   { nullptr };
+
+            static CCpuKernelBase   *smFirst;
+    };
+
+    //---------------------------------
+    // Function pointer bound to the best variant the CPU supports.
+    // Meant for namespace scope statics:
+    //   static CCpuKernel<Func> sKernel("Name", { { ECpuLevel::SSE2, FuncSSE2 }, { ECpuLevel::AVX2, FuncAVX2 } });
+    // The first variant is the fallback: Scalar, or the base ISA of the build
+    //---------------------------------
+    template <typename Func>
+    class CCpuKernel : public CCpuKernelBase {
+        public:
+            struct Variant {
+                ECpuLevel   level;
+                Func        func;
+            };
+
+        public:
+                            CCpuKernel(const char *name, std::initializer_list<Variant> variants);
+
+            Func            Get() const                     { return mFunc;     }
+
+            template <typename... Args>
+            auto            operator () (Args &&... args) const { return mFunc(static_cast<Args &&>(args)...); }
+
+        protected:
+            void            Bind(ECpuLevel level) override;
+
+        protected:
+            static const size_t kMaxVariants = 5;
+
+            Variant         mVariants[kMaxVariants] { };
+            size_t          mNumVariants { 0 };
+            Func            mFunc        { nullptr };
+    };
+
+    //---------------------------------
+    template <typename Func>
+    inline
+    CCpuKernel<Func>::CCpuKernel(const char *name, std::initializer_list<Variant> variants) : CCpuKernelBase(name) {
+        for (const Variant &variant : variants) {
+            if (mNumVariants < kMaxVariants)
+                mVariants[mNumVariants++] = variant;
+        }
+        Bind(GetCpuLevel());
+    }
+
+    //---------------------------------
+    template <typename Func>
+    inline void
+    CCpuKernel<Func>::Bind(ECpuLevel level) {
+        size_t  best = 0;
+
+        // Highest variant not above the level. The first one is the fallback
+        for (size_t i = 1; i < mNumVariants; ++i) {
+            if (mVariants[i].level <= level && (mVariants[best].level > level || mVariants[i].level > mVariants[best].level))
+                best = i;
+        }
+
+        mFunc    = mVariants[best].func;
+        mVariant = mVariants[best].level;
+    }
+
+} // end of namespace
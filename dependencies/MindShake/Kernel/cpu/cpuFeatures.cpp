@@ -0,0 +1,169 @@
+#include "cpuFeatures.h"
+#include "CCpuKernel.h"
+//-------------------------------------
+#include <cstdlib>
+#include <cstring>
+
+#if defined(MS_CPU_X86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+namespace MindShake {
+
+#if defined(MS_CPU_X86)
+    //---------------------------------
+    static void
+    CpuId(uint32_t leaf, uint32_t subLeaf, uint32_t regs[4]) {
+    #if defined(_MSC_VER)
+        int r[4];
+        __cpuidex(r, int(leaf), int(subLeaf));
+        for (int i = 0; i < 4; ++i)
+            regs[i] = uint32_t(r[i]);
+    #else
+        __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+    }
+
+    //---------------------------------
+    // Register state the OS saves on context switches (XCR0)
+    //---------------------------------
+    static uint64_t
+    GetXCR0() {
+    #if defined(_MSC_VER)
+        return _xgetbv(0);
+    #else
+        uint32_t eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (uint64_t(edx) << 32) | eax;
+    #endif
+    }
+#endif
+
+    //---------------------------------
+    static CpuFeatures
+    DetectCpuFeatures() {
+        CpuFeatures features;
+
+#if defined(MS_CPU_X86)
+        uint32_t    regs[4];
+        uint32_t    maxLeaf;
+        bool        osxsave;
+        uint64_t    xcr0 = 0;
+
+        CpuId(0, 0, regs);
+        maxLeaf = regs[0];
+        if (maxLeaf < 1)
+            return features;
+
+        CpuId(1, 0, regs);
+        features.sse2  = (regs[3] & (1u << 26)) != 0;
+        features.sse41 = (regs[2] & (1u << 19)) != 0;
+        features.fma   = (regs[2] & (1u << 12)) != 0;
+        osxsave        = (regs[2] & (1u << 27)) != 0;
+        if (osxsave)
+            xcr0 = GetXCR0();
+
+        // XMM | YMM, and opmask | ZMM 0-15 upper halves | ZMM 16-31
+        bool osAVX    = osxsave && (xcr0 & 0x06) == 0x06;
+        bool osAVX512 = osAVX   && (xcr0 & 0xe0) == 0xe0;
+
+        features.avx = osAVX && (regs[2] & (1u << 28)) != 0;
+        features.fma = features.fma && features.avx;
+        if (maxLeaf >= 7) {
+            CpuId(7, 0, regs);
+            features.avx2     = features.avx && (regs[1] & (1u <<  5)) != 0;
+            features.avx512f  = osAVX512     && (regs[1] & (1u << 16)) != 0;
+            features.avx512bw = features.avx512f && (regs[1] & (1u << 30)) != 0;
+            features.avx512vl = features.avx512f && (regs[1] & (1u << 31)) != 0;
+        }
+#endif
+
+        return features;
+    }
+
+    //---------------------------------
+    const CpuFeatures &
+    GetCpuFeatures() {
+        static const CpuFeatures features = DetectCpuFeatures();
+
+        return features;
+    }
+
+    //---------------------------------
+    ECpuLevel
+    GetDetectedCpuLevel() {
+        const CpuFeatures &f = GetCpuFeatures();
+
+        if (f.avx512f && f.avx512bw && f.avx512vl && f.avx2 && f.fma)
+            return ECpuLevel::AVX512;
+        if (f.avx2 && f.fma)
+            return ECpuLevel::AVX2;
+        if (f.sse41)
+            return ECpuLevel::SSE41;
+        if (f.sse2)
+            return ECpuLevel::SSE2;
+
+        return ECpuLevel::Scalar;
+    }
+
+    //---------------------------------
+    static ECpuLevel &
+    GetCpuLevelRef() {
+        static ECpuLevel level = [] {
+            ECpuLevel   detected = GetDetectedCpuLevel();
+            ECpuLevel   forced;
+            const char  *name    = getenv("MS_CPU_LEVEL");
+
+            if (name != nullptr && GetCpuLevelFromName(name, forced) && forced < detected)
+                return forced;
+
+            return detected;
+        }();
+
+        return level;
+    }
+
+    //---------------------------------
+    ECpuLevel
+    GetCpuLevel() {
+        return GetCpuLevelRef();
+    }
+
+    //---------------------------------
+    void
+    SetCpuLevel(ECpuLevel level) {
+        ECpuLevel detected = GetDetectedCpuLevel();
+
+        GetCpuLevelRef() = (level < detected) ? level : detected;
+        CCpuKernelBase::BindAll(GetCpuLevelRef());
+    }
+
+    //---------------------------------
+    static const char *kCpuLevelNames[] = { "scalar", "sse2", "sse41", "avx2", "avx512" };
+
+    //---------------------------------
+    const char *
+    GetCpuLevelName(ECpuLevel level) {
+        size_t index = size_t(level);
+
+        return (index < sizeof(kCpuLevelNames) / sizeof(kCpuLevelNames[0])) ? kCpuLevelNames[index] : "unknown";
+    }
+
+    //---------------------------------
+    bool
+    GetCpuLevelFromName(const char *name, ECpuLevel &level) {
+        for (size_t i = 0; i < sizeof(kCpuLevelNames) / sizeof(kCpuLevelNames[0]); ++i) {
+            if (strcmp(name, kCpuLevelNames[i]) == 0) {
+                level = ECpuLevel(i);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+} // end of namespace
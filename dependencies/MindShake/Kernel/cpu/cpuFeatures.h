@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Common/Core/platform.h>
+//-------------------------------------
+#include <cstdint>
+
+//-------------------------------------
+// Runtime CPU feature detection.
+// The build only assumes the base ISA (SSE2 on x64). Kernels with wider
+// variants compile them with MS_TARGET_* (function level target, so no
+// per-file ISA flags and no inline functions built for a wider ISA leak
+// into the rest of the program) and pick one at startup with CCpuKernel.
+//-------------------------------------
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define MS_CPU_X86
+
+    #if defined(_MSC_VER) && !defined(__clang__)
+        // MSVC accepts every intrinsic without target flags
+        #define MS_TARGET_SSE41
+        #define MS_TARGET_AVX2
+        #define MS_TARGET_AVX512
+    #else
+        #define MS_TARGET_SSE41     __attribute__((target("sse4.1")))
+        #define MS_TARGET_AVX2      __attribute__((target("avx2,fma")))
+        #define MS_TARGET_AVX512    __attribute__((target("avx512f,avx512bw,avx512vl,avx2,fma")))
+    #endif
+
+    #include <immintrin.h>
+#endif
+
+//-------------------------------------
+namespace MindShake {
+
+    //---------------------------------
+    // Each level includes the previous ones
+    //---------------------------------
+    enum class ECpuLevel : uint8_t {
+        Scalar,
+        SSE2,
+        SSE41,
+        AVX2,       // + FMA
+        AVX512,     // F + BW + VL
+    };
+
+    //---------------------------------
+    struct CpuFeatures {
+        bool    sse2     { false };
+        bool    sse41    { false };
+        bool    avx      { false };     // CPU and OS (YMM state saved)
+        bool    avx2     { false };
+        bool    fma      { false };
+        bool    avx512f  { false };     // CPU and OS (ZMM state saved)
+        bool    avx512bw { false };
+        bool    avx512vl { false };
+    };
+
+    // Detected once (CPUID / XGETBV)
+    const CpuFeatures & GetCpuFeatures();
+    ECpuLevel           GetDetectedCpuLevel();
+
+    // Level the kernels bind to: the detected one, capped by the environment
+    // variable MS_CPU_LEVEL (scalar, sse2, sse41, avx2, avx512) or SetCpuLevel
+    ECpuLevel           GetCpuLevel();
+    // Caps the level (never above the detected one) and rebinds every
+    // CCpuKernel. Not thread safe: call it at startup
+    void                SetCpuLevel(ECpuLevel level);
+
+    const char *        GetCpuLevelName(ECpuLevel level);
+    bool                GetCpuLevelFromName(const char *name, ECpuLevel &level);
+
+} // end of namespace
@@ -0,0 +1,113 @@
+#include "CWorkerPool.h"
+//-------------------------------------
+#include <algorithm>
+
+//-------------------------------------
+namespace MindShake
+{
+
+    //---------------------------------
+    CWorkerPool::CWorkerPool(uint32_t _numWorkers)
+    {
+        if (_numWorkers == 0) {
+            uint32_t hwThreads = std::thread::hardware_concurrency();
+            _numWorkers = (hwThreads > 1) ? hwThreads - 1 : 0;
+        }
+
+        mThreads.reserve(_numWorkers);
+        for (uint32_t i = 0; i < _numWorkers; ++i) {
+            mThreads.emplace_back(&CWorkerPool::WorkerLoop, this);
+        }
+    }
+
+    //---------------------------------
+    CWorkerPool::~CWorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mQuit = true;
+        }
+        mWakeCV.notify_all();
+
+        for (std::thread &thread : mThreads) {
+            thread.join();
+        }
+    }
+
+    //---------------------------------
+    void
+    CWorkerPool::ParallelFor(size_t _count, size_t _minBatch, const RangeFunc &_func)
+    {
+        size_t  numThreads;
+        size_t  batch;
+
+        if (_count == 0)
+            return;
+
+        // A few batches per thread so faster threads can steal the remainder
+        numThreads = mThreads.size() + 1;
+        batch      = (_count + numThreads * 4 - 1) / (numThreads * 4);
+        batch      = std::max(batch, std::max<size_t>(_minBatch, 1));
+
+        if (mThreads.empty() || _count <= batch) {
+            _func(0, _count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mpFunc   = &_func;
+            mCount   = _count;
+            mBatch   = batch;
+            mNext.store(0, std::memory_order_relaxed);
+            mPending = uint32_t(mThreads.size());
+            ++mJobId;
+        }
+        mWakeCV.notify_all();
+
+        RunBatches();
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDoneCV.wait(lock, [this] { return mPending == 0; });
+        mpFunc = nullptr;
+    }
+
+    //---------------------------------
+    void
+    CWorkerPool::WorkerLoop()
+    {
+        uint64_t    lastJobId = 0;
+
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mWakeCV.wait(lock, [&] { return mQuit || mJobId != lastJobId; });
+                if (mQuit)
+                    return;
+                lastJobId = mJobId;
+            }
+
+            RunBatches();
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (--mPending == 0)
+                    mDoneCV.notify_one();
+            }
+        }
+    }
+
+    //---------------------------------
+    void
+    CWorkerPool::RunBatches()
+    {
+        for (;;) {
+            size_t begin = mNext.fetch_add(mBatch, std::memory_order_relaxed);
+            if (begin >= mCount)
+                break;
+
+            (*mpFunc)(begin, std::min(begin + mBatch, mCount));
+        }
+    }
+
+} // end of namespace
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//-------------------------------------
+namespace MindShake
+{
+
+    //---------------------------------
+    // Persistent worker threads for data parallel loops.
+    // The thread calling ParallelFor also processes batches and blocks until
+    // the whole range is done. Only one ParallelFor can be in flight at a time.
+    //---------------------------------
+    class CWorkerPool
+    {
+        public:
+            using RangeFunc = std::function<void(size_t _begin, size_t _end)>;
+
+        public:
+            // 0 workers: one per hardware thread, minus the caller
+            explicit        CWorkerPool(uint32_t _numWorkers = 0);
+                            CWorkerPool(const CWorkerPool &)            = delete;
+                            CWorkerPool(CWorkerPool &&)                 = delete;
+                            ~CWorkerPool();
+
+            CWorkerPool &   operator = (const CWorkerPool &)            = delete;
+            CWorkerPool &   operator = (CWorkerPool &&)                 = delete;
+
+            // Splits [0, _count) in batches of at least _minBatch items
+            void            ParallelFor(size_t _count, size_t _minBatch, const RangeFunc &_func);
+
+            uint32_t        GetNumWorkers() const                       { return uint32_t(mThreads.size()); }
+
+        protected:
+            void            WorkerLoop();
+            void            RunBatches();
+
+        protected:
+            std::vector<std::thread>    mThreads;
+            std::mutex                  mMutex;
+            std::condition_variable     mWakeCV;
+            std::condition_variable     mDoneCV;
+
+            // Current job (written under mMutex before waking the workers)
+            const RangeFunc             *mpFunc     { nullptr };
+            size_t                      mCount      { 0 };
+            size_t                      mBatch      { 1 };
+            std::atomic<size_t>         mNext       { 0 };
+            uint32_t                    mPending    { 0 };
+            uint64_t                    mJobId      { 0 };
+            bool                        mQuit       { false };
+    };
+
+} // end of namespace
@@ -0,0 +1,333 @@
+//--------------------------------------
+#include <Common/Math/configMathLib.h>
+//--------------------------------------
+#include "CFrustumCuller.h"
+//--------------------------------------
+
+//--------------------------------------
+namespace MindShake
+{
+
+    //----------------------------------
+    // CAABBArraySoA
+    //----------------------------------
+    void
+    CAABBArraySoA::Resize(size_t _size) {
+        mMinX.resize(_size);
+        mMinY.resize(_size);
+        mMinZ.resize(_size);
+        mMaxX.resize(_size);
+        mMaxY.resize(_size);
+        mMaxZ.resize(_size);
+    }
+
+    //----------------------------------
+    void
+    CAABBArraySoA::Set(size_t _index, const CAABB &_box) {
+        mMinX[_index] = _box.min.x;
+        mMinY[_index] = _box.min.y;
+        mMinZ[_index] = _box.min.z;
+        mMaxX[_index] = _box.max.x;
+        mMaxY[_index] = _box.max.y;
+        mMaxZ[_index] = _box.max.z;
+    }
+
+    //----------------------------------
+    CAABB
+    CAABBArraySoA::Get(size_t _index) const {
+        return CAABB(CVector3(mMinX[_index], mMinY[_index], mMinZ[_index]), CVector3(mMaxX[_index], mMaxY[_index], mMaxZ[_index]));
+    }
+
+    //----------------------------------
+    // Scalar reference
+    //----------------------------------
+    size_t
+    CFrustumCuller::CullAABBsScalar(const AABBsSoA &_boxes, size_t _count, uint32_t _mask, uint32_t *_visible, uint32_t *_outMasks) const {
+        size_t  numVisible = 0;
+
+        for (size_t i = 0; i < _count; ++i) {
+            CAABB       box(CVector3(_boxes.minX[i], _boxes.minY[i], _boxes.minZ[i]), CVector3(_boxes.maxX[i], _boxes.maxY[i], _boxes.maxZ[i]));
+            uint32_t    mask = _mask;
+
+            if (TestAABB(box, mask)) {
+                _visible[numVisible++] = uint32_t(i);
+                if (_outMasks != nullptr)
+                    _outMasks[i] = mask;
+            }
+        }
+
+        return numVisible;
+    }
+
+    //----------------------------------
+    size_t
+    CFrustumCuller::CullSpheresScalar(const SpheresSoA &_spheres, size_t _count, uint32_t _mask, uint32_t *_visible, uint32_t *_outMasks) const {
+        size_t  numVisible = 0;
+
+        for (size_t i = 0; i < _count; ++i) {
+            uint32_t    mask = _mask;
+
+            if (TestSphere(CVector3(_spheres.x[i], _spheres.y[i], _spheres.z[i]), _spheres.radius[i], mask)) {
+                _visible[numVisible++] = uint32_t(i);
+                if (_outMasks != nullptr)
+                    _outMasks[i] = mask;
+            }
+        }
+
+        return numVisible;
+    }
+
+#if defined(MS_MATH_SSE)
+
+    //----------------------------------
+    // Lane width abstraction, so the kernels are written once for SSE (4 lanes)
+    // and AVX2 (8 lanes). Masks are compare results: all bits set or clear
+    //----------------------------------
+    struct SimdLanes4
+    {
+        using   Vec = __m128;
+        static const size_t kWidth = 4;
+
+        static Vec      Load(const float *_p)                               { return _mm_loadu_ps(_p);              }
+        static Vec      Splat(float _v)                                     { return _mm_set1_ps(_v);               }
+        static Vec      SplatBits(uint32_t _v)                              { return _mm_castsi128_ps(_mm_set1_epi32(int32_t(_v))); }
+        static Vec      Zero()                                              { return _mm_setzero_ps();              }
+        static Vec      Add(Vec _a, Vec _b)                                 { return _mm_add_ps(_a, _b);            }
+        static Vec      Mul(Vec _a, Vec _b)                                 { return _mm_mul_ps(_a, _b);            }
+        static Vec      Neg(Vec _a)                                         { return _mm_xor_ps(_a, _mm_set1_ps(-0.0f)); }
+        static Vec      Or(Vec _a, Vec _b)                                  { return _mm_or_ps(_a, _b);             }
+        static Vec      And(Vec _a, Vec _b)                                 { return _mm_and_ps(_a, _b);            }
+        static Vec      Less(Vec _a, Vec _b)                                { return _mm_cmplt_ps(_a, _b);          }
+        // !(a >= b): true for NaN, as the scalar test
+        static Vec      NotGreaterEqual(Vec _a, Vec _b)                     { return _mm_cmpnge_ps(_a, _b);         }
+        static uint32_t MoveMask(Vec _a)                                    { return uint32_t(_mm_movemask_ps(_a)); }
+        static void     StoreBits(uint32_t *_p, Vec _a)                     { _mm_storeu_si128(reinterpret_cast<__m128i *>(_p), _mm_castps_si128(_a)); }
+    };
+
+#if defined(MS_MATH_AVX2)
+    //----------------------------------
+    struct SimdLanes8
+    {
+        using   Vec = __m256;
+        static const size_t kWidth = 8;
+
+        static Vec      Load(const float *_p)                               { return _mm256_loadu_ps(_p);           }
+        static Vec      Splat(float _v)                                     { return _mm256_set1_ps(_v);            }
+        static Vec      SplatBits(uint32_t _v)                              { return _mm256_castsi256_ps(_mm256_set1_epi32(int32_t(_v))); }
+        static Vec      Zero()                                              { return _mm256_setzero_ps();           }
+        static Vec      Add(Vec _a, Vec _b)                                 { return _mm256_add_ps(_a, _b);         }
+        static Vec      Mul(Vec _a, Vec _b)                                 { return _mm256_mul_ps(_a, _b);         }
+        static Vec      Neg(Vec _a)                                         { return _mm256_xor_ps(_a, _mm256_set1_ps(-0.0f)); }
+        static Vec      Or(Vec _a, Vec _b)                                  { return _mm256_or_ps(_a, _b);          }
+        static Vec      And(Vec _a, Vec _b)                                 { return _mm256_and_ps(_a, _b);         }
+        static Vec      Less(Vec _a, Vec _b)                                { return _mm256_cmp_ps(_a, _b, _CMP_LT_OQ);  }
+        static Vec      NotGreaterEqual(Vec _a, Vec _b)                     { return _mm256_cmp_ps(_a, _b, _CMP_NGE_UQ); }
+        static uint32_t MoveMask(Vec _a)                                    { return uint32_t(_mm256_movemask_ps(_a)); }
+        static void     StoreBits(uint32_t *_p, Vec _a)                     { _mm256_storeu_si256(reinterpret_cast<__m256i *>(_p), _mm256_castps_si256(_a)); }
+    };
+
+    using SimdLanes = SimdLanes8;
+#else
+    using SimdLanes = SimdLanes4;
+#endif
+
+    //----------------------------------
+    // One batch of kWidth boxes. Returns the lanes not culled (bit per lane)
+    //----------------------------------
+    template <typename L>
+    static inline uint32_t
+    CullAABBsBatch(const CPlane *_planes, size_t _numPlanes, const AABBsSoA &_boxes, uint32_t _mask, uint32_t *_outMasks) {
+        const uint32_t  kAllLanes = (1u << L::kWidth) - 1u;
+        typename L::Vec zero      = L::Zero();
+        typename L::Vec culled    = zero;
+        typename L::Vec straddled = zero;
+
+        for (size_t p = 0; p < _numPlanes; ++p) {
+            uint32_t bit = 1u << p;
+
+            if ((_mask & bit) == 0)
+                continue;
+
+            // The corner furthest along the normal (and the nearest one) is
+            // picked per plane, so it is just a choice of array
+            const CPlane    &plane = _planes[p];
+            bool            posX   = plane.normal.x >= 0.0f;
+            bool            posY   = plane.normal.y >= 0.0f;
+            bool            posZ   = plane.normal.z >= 0.0f;
+            typename L::Vec nx     = L::Splat(plane.normal.x);
+            typename L::Vec ny     = L::Splat(plane.normal.y);
+            typename L::Vec nz     = L::Splat(plane.normal.z);
+            typename L::Vec d      = L::Splat(plane.d);
+
+            typename L::Vec maxDistance = L::Add(L::Add(L::Add(
+                                            L::Mul(nx, L::Load(posX ? _boxes.maxX : _boxes.minX)),
+                                            L::Mul(ny, L::Load(posY ? _boxes.maxY : _boxes.minY))),
+                                            L::Mul(nz, L::Load(posZ ? _boxes.maxZ : _boxes.minZ))),
+                                            d);
+            culled = L::Or(culled, L::Less(maxDistance, zero));
+            if (L::MoveMask(culled) == kAllLanes)
+                return 0;
+
+            if (_outMasks != nullptr) {
+                typename L::Vec minDistance = L::Add(L::Add(L::Add(
+                                                L::Mul(nx, L::Load(posX ? _boxes.minX : _boxes.maxX)),
+                                                L::Mul(ny, L::Load(posY ? _boxes.minY : _boxes.maxY))),
+                                                L::Mul(nz, L::Load(posZ ? _boxes.minZ : _boxes.maxZ))),
+                                                d);
+                straddled = L::Or(straddled, L::And(L::NotGreaterEqual(minDistance, zero), L::SplatBits(bit)));
+            }
+        }
+
+        if (_outMasks != nullptr)
+            L::StoreBits(_outMasks, straddled);
+
+        return ~L::MoveMask(culled) & kAllLanes;
+    }
+
+    //----------------------------------
+    template <typename L>
+    static inline uint32_t
+    CullSpheresBatch(const CPlane *_planes, size_t _numPlanes, const SpheresSoA &_spheres, uint32_t _mask, uint32_t *_outMasks) {
+        const uint32_t  kAllLanes = (1u << L::kWidth) - 1u;
+        typename L::Vec culled    = L::Zero();
+        typename L::Vec straddled = L::Zero();
+        typename L::Vec x         = L::Load(_spheres.x);
+        typename L::Vec y         = L::Load(_spheres.y);
+        typename L::Vec z         = L::Load(_spheres.z);
+        typename L::Vec radius    = L::Load(_spheres.radius);
+        typename L::Vec negRadius = L::Neg(radius);
+
+        for (size_t p = 0; p < _numPlanes; ++p) {
+            uint32_t bit = 1u << p;
+
+            if ((_mask & bit) == 0)
+                continue;
+
+            const CPlane    &plane   = _planes[p];
+            typename L::Vec distance = L::Add(L::Add(L::Add(
+                                        L::Mul(L::Splat(plane.normal.x), x),
+                                        L::Mul(L::Splat(plane.normal.y), y)),
+                                        L::Mul(L::Splat(plane.normal.z), z)),
+                                        L::Splat(plane.d));
+            culled = L::Or(culled, L::Less(distance, negRadius));
+            if (L::MoveMask(culled) == kAllLanes)
+                return 0;
+
+            straddled = L::Or(straddled, L::And(L::NotGreaterEqual(distance, radius), L::SplatBits(bit)));
+        }
+
+        if (_outMasks != nullptr)
+            L::StoreBits(_outMasks, straddled);
+
+        return ~L::MoveMask(culled) & kAllLanes;
+    }
+
+    //----------------------------------
+    // Appends the indices of the lanes set in _lanes. Branchless: always
+    // writes, but only advances on visible lanes (_visible has room for them)
+    //----------------------------------
+    static inline size_t
+    CompactLanes(uint32_t _lanes, size_t _width, uint32_t _first, uint32_t *_visible, size_t _numVisible) {
+        for (size_t l = 0; l < _width; ++l) {
+            _visible[_numVisible] = _first + uint32_t(l);
+            _numVisible += (_lanes >> l) & 1;
+        }
+
+        return _numVisible;
+    }
+
+    //----------------------------------
+    // The tail (less than kWidth volumes) is copied to a padded batch
+    //----------------------------------
+    size_t
+    CFrustumCuller::CullAABBs(const AABBsSoA &_boxes, size_t _count, uint32_t _mask, uint32_t *_visible, uint32_t *_outMasks) const {
+        const size_t    kWidth     = SimdLanes::kWidth;
+        size_t          numVisible = 0;
+        size_t          i          = 0;
+
+        for (; i + kWidth <= _count; i += kWidth) {
+            uint32_t lanes = CullAABBsBatch<SimdLanes>(mPlanes, mNumPlanes, _boxes.GetOffset(i), _mask, (_outMasks != nullptr) ? _outMasks + i : nullptr);
+            numVisible = CompactLanes(lanes, kWidth, uint32_t(i), _visible, numVisible);
+        }
+
+        size_t rest = _count - i;
+        if (rest > 0) {
+            float       tail[6][kWidth] = { };
+            uint32_t    tailMasks[kWidth];
+            AABBsSoA    boxes { tail[0], tail[1], tail[2], tail[3], tail[4], tail[5] };
+
+            for (size_t j = 0; j < rest; ++j) {
+                tail[0][j] = _boxes.minX[i + j];
+                tail[1][j] = _boxes.minY[i + j];
+                tail[2][j] = _boxes.minZ[i + j];
+                tail[3][j] = _boxes.maxX[i + j];
+                tail[4][j] = _boxes.maxY[i + j];
+                tail[5][j] = _boxes.maxZ[i + j];
+            }
+
+            uint32_t lanes = CullAABBsBatch<SimdLanes>(mPlanes, mNumPlanes, boxes, _mask, (_outMasks != nullptr) ? tailMasks : nullptr);
+            numVisible = CompactLanes(lanes, rest, uint32_t(i), _visible, numVisible);
+            if (_outMasks != nullptr) {
+                for (size_t j = 0; j < rest; ++j) {
+                    _outMasks[i + j] = tailMasks[j];
+                }
+            }
+        }
+
+        return numVisible;
+    }
+
+    //----------------------------------
+    size_t
+    CFrustumCuller::CullSpheres(const SpheresSoA &_spheres, size_t _count, uint32_t _mask, uint32_t *_visible, uint32_t *_outMasks) const {
+        const size_t    kWidth     = SimdLanes::kWidth;
+        size_t          numVisible = 0;
+        size_t          i          = 0;
+
+        for (; i + kWidth <= _count; i += kWidth) {
+            uint32_t lanes = CullSpheresBatch<SimdLanes>(mPlanes, mNumPlanes, _spheres.GetOffset(i), _mask, (_outMasks != nullptr) ? _outMasks + i : nullptr);
+            numVisible = CompactLanes(lanes, kWidth, uint32_t(i), _visible, numVisible);
+        }
+
+        size_t rest = _count - i;
+        if (rest > 0) {
+            float       tail[4][kWidth] = { };
+            uint32_t    tailMasks[kWidth];
+            SpheresSoA  spheres { tail[0], tail[1], tail[2], tail[3] };
+
+            for (size_t j = 0; j < rest; ++j) {
+                tail[0][j] = _spheres.x[i + j];
+                tail[1][j] = _spheres.y[i + j];
+                tail[2][j] = _spheres.z[i + j];
+                tail[3][j] = _spheres.radius[i + j];
+            }
+
+            uint32_t lanes = CullSpheresBatch<SimdLanes>(mPlanes, mNumPlanes, spheres, _mask, (_outMasks != nullptr) ? tailMasks : nullptr);
+            numVisible = CompactLanes(lanes, rest, uint32_t(i), _visible, numVisible);
+            if (_outMasks != nullptr) {
+                for (size_t j = 0; j < rest; ++j) {
+                    _outMasks[i + j] = tailMasks[j];
+                }
+            }
+        }
+
+        return numVisible;
+    }
+
+#else
+
+    //----------------------------------
+    size_t
+    CFrustumCuller::CullAABBs(const AABBsSoA &_boxes, size_t _count, uint32_t _mask, uint32_t *_visible, uint32_t *_outMasks) const {
+        return CullAABBsScalar(_boxes, _count, _mask, _visible, _outMasks);
+    }
+
+    //----------------------------------
+    size_t
+    CFrustumCuller::CullSpheres(const SpheresSoA &_spheres, size_t _count, uint32_t _mask, uint32_t *_visible, uint32_t *_outMasks) const {
+        return CullSpheresScalar(_spheres, _count, _mask, _visible, _outMasks);
+    }
+
+#endif
+
+} // end of namespace
@@ -0,0 +1,157 @@
+#pragma once
+
+//-------------------------------------
+#include <Math/types/CPlane.h>
+#include <Core/memory/allocators.h>
+//-------------------------------------
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+//-------------------------------------
+
+//-------------------------------------
+namespace MindShake
+{
+
+    //---------------------------------
+    // Bounding volumes as structure of arrays: the batch kernels load one
+    // component of 4 (SSE) or 8 (AVX2) volumes with a single instruction
+    //---------------------------------
+    struct AABBsSoA
+    {
+        const float     *minX, *minY, *minZ;
+        const float     *maxX, *maxY, *maxZ;
+
+        AABBsSoA        GetOffset(size_t _first) const                      { return { minX + _first, minY + _first, minZ + _first, maxX + _first, maxY + _first, maxZ + _first }; }
+    };
+
+    //---------------------------------
+    struct SpheresSoA
+    {
+        const float     *x, *y, *z;
+        const float     *radius;
+
+        SpheresSoA      GetOffset(size_t _first) const                      { return { x + _first, y + _first, z + _first, radius + _first }; }
+    };
+
+    //---------------------------------
+    // Storage for AABBsSoA
+    //---------------------------------
+    class CAABBArraySoA
+    {
+        public:
+            void            Clear()                                         { Resize(0);            }
+            void            Resize(size_t _size);
+            size_t          GetSize() const                                 { return mMinX.size();  }
+
+            void            Set(size_t _index, const CAABB &_box);
+            CAABB           Get(size_t _index) const;
+
+            AABBsSoA        GetView() const                                 { return { mMinX.data(), mMinY.data(), mMinZ.data(), mMaxX.data(), mMaxY.data(), mMaxZ.data() }; }
+
+        protected:
+            // Cache line aligned, like the batches the kernels load
+            using Floats = std::vector<float, CAlignedAllocator<float>>;
+
+            Floats          mMinX, mMinY, mMinZ;
+            Floats          mMaxX, mMaxY, mMaxZ;
+    };
+
+    //---------------------------------
+    // Tests bounding volumes against a set of planes (normals pointing inside,
+    // as CCamera::GetFrustumPlanes). A volume is culled when it is fully behind
+    // any plane.
+    //
+    // Plane masks (bit p = plane p) give plane coherency: the planes a volume is
+    // fully in front of can not cull its children, so they only test the planes
+    // their parent straddles. A mask of 0 means fully inside the frustum.
+    //
+    // The batch kernels give the same results as the scalar tests (same
+    // operation order as CPlane::GetMaxDistance / GetMinDistance).
+    //---------------------------------
+    class CFrustumCuller
+    {
+        public:
+            static const size_t kMaxPlanes = 32;
+
+        public:
+                            CFrustumCuller(const CPlane *_planes, size_t _numPlanes);
+
+            size_t          GetNumPlanes() const                            { return mNumPlanes;    }
+            uint32_t        GetAllPlanesMask() const                        { return mAllPlanes;    }
+
+            // Single volumes. Return false if culled. Otherwise _mask keeps only
+            // the planes the volume straddles
+            bool            TestAABB(const CAABB &_box, uint32_t &_mask) const;
+            bool            TestSphere(const CVector3 &_center, float _radius, uint32_t &_mask) const;
+
+            // Batches. Test the volumes against the planes in _mask, write the
+            // indices of the visible ones to _visible (room for _count) and return
+            // how many. If _outMasks is not null, _outMasks[i] gets the planes
+            // the visible volume i straddles
+            size_t          CullAABBs(const AABBsSoA &_boxes, size_t _count, uint32_t _mask, uint32_t *_visible, uint32_t *_outMasks = nullptr) const;
+            size_t          CullSpheres(const SpheresSoA &_spheres, size_t _count, uint32_t _mask, uint32_t *_visible, uint32_t *_outMasks = nullptr) const;
+
+            // Scalar reference
+            size_t          CullAABBsScalar(const AABBsSoA &_boxes, size_t _count, uint32_t _mask, uint32_t *_visible, uint32_t *_outMasks = nullptr) const;
+            size_t          CullSpheresScalar(const SpheresSoA &_spheres, size_t _count, uint32_t _mask, uint32_t *_visible, uint32_t *_outMasks = nullptr) const;
+
+        protected:
+            CPlane          mPlanes[kMaxPlanes];
+            size_t          mNumPlanes;
+            uint32_t        mAllPlanes;
+    };
+
+    //---------------------------------
+    inline
+    CFrustumCuller::CFrustumCuller(const CPlane *_planes, size_t _numPlanes) {
+        mNumPlanes = (_numPlanes < kMaxPlanes) ? _numPlanes : kMaxPlanes;
+        mAllPlanes = (mNumPlanes < 32) ? (1u << mNumPlanes) - 1u : 0xffffffffu;
+        for (size_t p = 0; p < mNumPlanes; ++p) {
+            mPlanes[p] = _planes[p];
+        }
+    }
+
+    //---------------------------------
+    inline bool
+    CFrustumCuller::TestAABB(const CAABB &_box, uint32_t &_mask) const {
+        uint32_t    mask = _mask;
+
+        for (size_t p = 0; p < mNumPlanes; ++p) {
+            uint32_t bit = 1u << p;
+
+            if ((mask & bit) == 0)
+                continue;
+            if (mPlanes[p].GetMaxDistance(_box) < 0.0f)
+                return false;
+            if (mPlanes[p].GetMinDistance(_box) >= 0.0f)
+                mask &= ~bit;
+        }
+
+        _mask = mask;
+        return true;
+    }
+
+    //---------------------------------
+    inline bool
+    CFrustumCuller::TestSphere(const CVector3 &_center, float _radius, uint32_t &_mask) const {
+        uint32_t    mask = _mask;
+
+        for (size_t p = 0; p < mNumPlanes; ++p) {
+            uint32_t bit = 1u << p;
+
+            if ((mask & bit) == 0)
+                continue;
+
+            float distance = mPlanes[p].GetDistance(_center);
+            if (distance < -_radius)
+                return false;
+            if (distance >= _radius)
+                mask &= ~bit;
+        }
+
+        _mask = mask;
+        return true;
+    }
+
+} // end of namespace
@@ -0,0 +1,161 @@
+#include "CAABB.h"
+#include "CMatrix4.h"
+#include "CMatrix3x4.h"
+//-------------------------------------
+#include <Common/Math/math_funcs.h>
+//-------------------------------------
+#include <algorithm>
+
+//-------------------------------------
+namespace MindShake
+{
+
+    //---------------------------------
+    void
+    CAABB::Reset() {
+        min.Set(Float32::POS_INFINITY);
+        max.Set(Float32::NEG_INFINITY);
+    }
+
+    //---------------------------------
+    void
+    CAABB::Expand(const CVector3 &_point) {
+        min.SetMin(_point);
+        max.SetMax(_point);
+    }
+
+    //---------------------------------
+    void
+    CAABB::Expand(const CAABB &_other) {
+        min.SetMin(_other.min);
+        max.SetMax(_other.max);
+    }
+
+    //---------------------------------
+    float
+    CAABB::GetSurfaceArea() const {
+        if (IsEmpty())
+            return 0.0f;
+
+        CVector3 size = GetSize();
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    //---------------------------------
+    size_t
+    CAABB::GetLongestAxis() const {
+        CVector3 size = GetSize();
+
+        if (size.x >= size.y && size.x >= size.z)
+            return 0;
+
+        return (size.y >= size.z) ? 1 : 2;
+    }
+
+    //---------------------------------
+    bool
+    CAABB::Contains(const CVector3 &_point) const {
+        return (_point.x >= min.x) && (_point.x <= max.x) &&
+               (_point.y >= min.y) && (_point.y <= max.y) &&
+               (_point.z >= min.z) && (_point.z <= max.z);
+    }
+
+    //---------------------------------
+    bool
+    CAABB::Contains(const CAABB &_other) const {
+        return (_other.min.x >= min.x) && (_other.max.x <= max.x) &&
+               (_other.min.y >= min.y) && (_other.max.y <= max.y) &&
+               (_other.min.z >= min.z) && (_other.max.z <= max.z);
+    }
+
+    //---------------------------------
+    bool
+    CAABB::Intersects(const CAABB &_other) const {
+        return (min.x <= _other.max.x) && (max.x >= _other.min.x) &&
+               (min.y <= _other.max.y) && (max.y >= _other.min.y) &&
+               (min.z <= _other.max.z) && (max.z >= _other.min.z);
+    }
+
+    //---------------------------------
+    float
+    CAABB::GetSquaredDistance(const CVector3 &_point) const {
+        float   dist = 0.0f;
+
+        for (size_t i = 0; i < 3; ++i) {
+            float v = _point[i];
+            if (v < min[i])
+                dist += (min[i] - v) * (min[i] - v);
+            else if (v > max[i])
+                dist += (v - max[i]) * (v - max[i]);
+        }
+
+        return dist;
+    }
+
+    //---------------------------------
+    bool
+    CAABB::IntersectsRay(const CVector3 &_origin, const CVector3 &_invDir, float _tMax, float &_tNear) const {
+        float   tMin = 0.0f;
+
+        for (size_t i = 0; i < 3; ++i) {
+            float t1 = (min[i] - _origin[i]) * _invDir[i];
+            float t2 = (max[i] - _origin[i]) * _invDir[i];
+
+            tMin  = std::max(tMin,  std::min(t1, t2));
+            _tMax = std::min(_tMax, std::max(t1, t2));
+        }
+
+        _tNear = tMin;
+
+        return tMin <= _tMax;
+    }
+
+    //---------------------------------
+    // J. Arvo, "Transforming Axis-Aligned Bounding Boxes", Graphics Gems 1990
+    //---------------------------------
+    CAABB
+    CAABB::GetTransformed(const CMatrix4 &_matrix) const {
+        CAABB   r;
+
+        if (IsEmpty())
+            return r;
+
+        r.min = _matrix.GetTranslation();
+        r.max = r.min;
+        for (size_t col = 0; col < 3; ++col) {
+            for (size_t row = 0; row < 3; ++row) {
+                float a = _matrix[col][row] * min[col];
+                float b = _matrix[col][row] * max[col];
+
+                r.min[row] += std::min(a, b);
+                r.max[row] += std::max(a, b);
+            }
+        }
+
+        return r;
+    }
+
+    //---------------------------------
+    CAABB
+    CAABB::GetTransformed(const CMatrix3x4 &_matrix) const {
+        CAABB   r;
+
+        if (IsEmpty())
+            return r;
+
+        r.min = _matrix.GetTranslation();
+        r.max = r.min;
+        for (size_t col = 0; col < 3; ++col) {
+            for (size_t row = 0; row < 3; ++row) {
+                float a = _matrix[row][col] * min[col];
+                float b = _matrix[row][col] * max[col];
+
+                r.min[row] += std::min(a, b);
+                r.max[row] += std::max(a, b);
+            }
+        }
+
+        return r;
+    }
+
+} // end of namespace
@@ -0,0 +1,57 @@
+#pragma once
+
+//-------------------------------------
+#include <Math/types/CVector3.h>
+//-------------------------------------
+
+//-------------------------------------
+namespace MindShake
+{
+
+    //---------------------------------
+    class CMatrix4;
+    class CMatrix3x4;
+
+    //---------------------------------
+    // Axis aligned bounding box.
+    // An empty box has min = +inf and max = -inf, so Expand works without special cases.
+    //---------------------------------
+    class CAABB
+    {
+        public:
+                            CAABB()                                             { Reset(); }
+                            CAABB(const CVector3 &_min, const CVector3 &_max)   : min(_min), max(_max) { }
+
+            void            Reset();
+            bool            IsEmpty() const                                     { return (min.x > max.x) || (min.y > max.y) || (min.z > max.z); }
+
+            void            Expand(const CVector3 &_point);
+            void            Expand(const CAABB &_other);
+
+            CVector3        GetCenter() const                                   { return CVector3((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f); }
+            CVector3        GetExtents() const                                  { return CVector3((max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f); }
+            CVector3        GetSize() const                                     { return CVector3(max.x - min.x, max.y - min.y, max.z - min.z); }
+            float           GetSurfaceArea() const;
+            size_t          GetLongestAxis() const;
+
+            bool            Contains(const CVector3 &_point) const;
+            bool            Contains(const CAABB &_other) const;
+            bool            Intersects(const CAABB &_other) const;
+
+            float           GetSquaredDistance(const CVector3 &_point) const;   // 0 if inside
+            // Slab test. _invDir = 1 / ray direction. Returns the entry distance in _tNear
+            bool            IntersectsRay(const CVector3 &_origin, const CVector3 &_invDir, float _tMax, float &_tNear) const;
+
+            // Box enclosing this one transformed by an affine matrix
+            CAABB           GetTransformed(const CMatrix4 &_matrix) const;
+            CAABB           GetTransformed(const CMatrix3x4 &_matrix) const;
+
+            bool            operator == (const CAABB &_other) const             { return (min == _other.min) && (max == _other.max); }
+            bool            operator != (const CAABB &_other) const             { return (min != _other.min) || (max != _other.max); }
+
+        public:
+            CVector3    min;
+            CVector3    max;
+    };
+
+} // end of namespace
@@ -14,27 +14,6 @@
 namespace MindShake
 {
 
-    //---------------------------------
-    const CMatrix3  CMatrix3::kZERO    (0,0,0, 0,0,0, 0,0,0);
-    const CMatrix3  CMatrix3::kIDENTITY(1,0,0, 0,1,0, 0,0,1);
-    //---------------------------------
-
-    //---------------------------------
-    CMatrix3::CMatrix3(float _00, float _01, float _02,
-                       float _10, float _11, float _12,
-                       float _20, float _21, float _22)
-    {
-        m[0][0] = _00;
-        m[0][1] = _01;
-        m[0][2] = _02;
-        m[1][0] = _10;
-        m[1][1] = _11;
-        m[1][2] = _12;
-        m[2][0] = _20;
-        m[2][1] = _21;
-        m[2][2] = _22;
-    }
-
     //---------------------------------
 
     //---------------------------------
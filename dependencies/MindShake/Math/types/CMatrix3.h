@@ -53,7 +53,7 @@ namespace MindShake
 
             template <typename T>
             explicit        CMatrix3(const T* _ptr);
-                            CMatrix3(float _00, float _01, float _02,
+                  constexpr CMatrix3(float _00, float _01, float _02,
                                      float _10, float _11, float _12,
                                      float _20, float _21, float _22);
 
@@ -140,6 +140,21 @@ namespace MindShake
             static const CMatrix3   kIDENTITY;
     };
 
+    //-------------------------------------
+    inline constexpr
+    CMatrix3::CMatrix3(float _00, float _01, float _02,
+                       float _10, float _11, float _12,
+                       float _20, float _21, float _22)
+        : m { { _00, _01, _02 },
+              { _10, _11, _12 },
+              { _20, _21, _22 } }
+    {
+    }
+
+    //-------------------------------------
+    inline constexpr CMatrix3  CMatrix3::kZERO    (0,0,0, 0,0,0, 0,0,0);
+    inline constexpr CMatrix3  CMatrix3::kIDENTITY(1,0,0, 0,1,0, 0,0,1);
+
     //-------------------------------------
     template <typename T>
     inline
@@ -0,0 +1,75 @@
+//--------------------------------------
+#include <Common/Math/configMathLib.h>
+//--------------------------------------
+#include "CMatrix3x4.h"
+#include "CVector3.h"
+//--------------------------------------
+#include <Core/log/log.h>
+//--------------------------------------
+
+
+//--------------------------------------
+namespace MindShake
+{
+
+    //----------------------------------
+    // Batch transforms
+    //----------------------------------
+    static_assert(sizeof(CMatrix3x4) == 12 * sizeof(float), "CMatrix3x4 must be packed");
+
+    //----------------------------------
+    // c0 * x + c1 * y + c2 * z + t. Same operation order as operator * (CVector3)
+    //----------------------------------
+    void
+    CMatrix3x4::TransformPoints(const CVector3 *_in, CVector3 *_out, size_t _count) const {
+#if defined(MS_MATH_SSE)
+        __m128  c0 = _mm_load_ps(m[0]);
+        __m128  c1 = _mm_load_ps(m[1]);
+        __m128  c2 = _mm_load_ps(m[2]);
+        __m128  t  = _mm_setzero_ps();
+
+        _MM_TRANSPOSE4_PS(c0, c1, c2, t);
+        for (size_t i = 0; i < _count; ++i) {
+            bool    isLast = (i + 1 == _count);
+            __m128  p      = SimdLoadPoint3(&_in[i].x, isLast);
+
+            p = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(c0, SimdSplatX(p)),
+                    _mm_mul_ps(c1, SimdSplatY(p))),
+                    _mm_mul_ps(c2, SimdSplatZ(p))),
+                    t);
+            SimdStorePoint3(&_out[i].x, p, isLast);
+        }
+#else
+        for (size_t i = 0; i < _count; ++i) {
+            _out[i] = *this * _in[i];
+        }
+#endif
+    }
+
+    //----------------------------------
+    void
+    CMatrix3x4::MakeTransforms(const CVector3 *_positions, const CVector3 *_scales, const CVector3 *_angles, CMatrix3x4 *_out, size_t _count) {
+        const size_t    kBatch = 64;
+        float           sines[kBatch * 3], cosines[kBatch * 3];
+
+        for (size_t i = 0; i < _count; i += kBatch) {
+            size_t  count = (_count - i < kBatch) ? _count - i : kBatch;
+
+            SinCosG(&_angles[i].x, sines, cosines, count * 3);
+            for (size_t j = 0; j < count; ++j) {
+                _out[i + j].MakeTransformSinCos(_positions[i + j], _scales[i + j], &sines[j * 3], &cosines[j * 3]);
+            }
+        }
+    }
+
+    //----------------------------------
+    void
+    CMatrix3x4::Print() const
+    {
+        MS_LOG("% 4.3f   % 4.3f   % 4.3f   % 4.3f", m[0][0], m[0][1], m[0][2], m[0][3]);
+        MS_LOG("% 4.3f   % 4.3f   % 4.3f   % 4.3f", m[1][0], m[1][1], m[1][2], m[1][3]);
+        MS_LOG("% 4.3f   % 4.3f   % 4.3f   % 4.3f", m[2][0], m[2][1], m[2][2], m[2][3]);
+    }
+
+} // end of namespace
@@ -0,0 +1,554 @@
+#pragma once
+
+#include <Common/Math/configMathLib.h>
+#include <Common/Math/simd_funcs.h>
+#include <Common/Math/constants.h>
+//-------------------------------------
+#include <cstddef>
+#include <cassert>
+
+//-------------------------------------
+namespace MindShake
+{
+
+    //---------------------------------
+    class CVector3;
+    class CMatrix4;
+    class CQuaternion;
+    //---------------------------------
+
+    //---------------------------------
+    // Affine transform: the 3 upper rows of a CMatrix4, the last one is
+    // always (0, 0, 0, 1). 48 bytes instead of 64, and no row 3 math.
+    // Same conventions as CMatrix4 (column vectors, post-multiplication).
+    //---------------------------------
+    // Memory (row major):
+    //  | row0 row1 row2 |
+    // Logical representation: scale and translation
+    //  | sx  0  0 tx |
+    //  |  0 sy  0 ty |
+    //  |  0  0 sz tz |
+    // v:
+    //  |  0  1  2  3 |
+    //  |  4  5  6  7 |
+    //  |  8  9 10 11 |
+    // m:
+    //  | m[0][0]  m[0][1]  m[0][2]  m[0][3] |
+    //  | m[1][0]  m[1][1]  m[1][2]  m[1][3] |
+    //  | m[2][0]  m[2][1]  m[2][2]  m[2][3] |
+    //---------------------------------
+
+    //---------------------------------
+    class alignas(16) CMatrix3x4
+    {
+        public:
+            friend class CMatrix4;
+
+        public:
+                            CMatrix3x4()                            = default;
+                            CMatrix3x4(const CMatrix3x4 &_other)    = default;
+                            ~CMatrix3x4()                           = default;
+
+                  constexpr CMatrix3x4(float _m00, float _m01, float _m02, float _m03,
+                                       float _m10, float _m11, float _m12, float _m13,
+                                       float _m20, float _m21, float _m22, float _m23);
+
+            // Drops row 3: _mat4 must be affine
+            explicit        CMatrix3x4(const CMatrix4 &_mat4);
+
+            CMatrix3x4 &    operator = (const CMatrix3x4 &_other)   = default;
+
+            CMatrix3x4 &    Set(float _m00, float _m01, float _m02, float _m03,
+                                float _m10, float _m11, float _m12, float _m13,
+                                float _m20, float _m21, float _m22, float _m23);
+            CMatrix3x4 &    Set(const CMatrix4 &_mat4);
+
+            float *         operator [] (size_t _row)               { assert(_row < 3); return m[_row]; }
+            const float *   operator [] (size_t _row) const         { assert(_row < 3); return m[_row]; }
+
+            float *         GetPtr()                                { return &m[0][0]; }
+            const float *   GetPtr() const                          { return &m[0][0]; }
+
+            bool            operator == (const CMatrix3x4 &_other) const;
+            bool            operator != (const CMatrix3x4 &_other) const    { return !(*this == _other); }
+
+            CMatrix3x4 &    Concatenate(const CMatrix3x4 &_other);
+            CMatrix3x4      GetConcatenated(const CMatrix3x4 &_other) const;
+            CMatrix3x4      operator * (const CMatrix3x4 &_other) const     { return GetConcatenated(_other); }
+            // v' = M * v
+            CVector3        operator * (const CVector3 &_vec3) const;       // W = 1
+            CVector3        TransformVector(const CVector3 &_vec3) const;   // W = 0
+
+            // Batch transform of _count points (W = 1). _in and _out must not overlap
+            void            TransformPoints(const CVector3 *_in, CVector3 *_out, size_t _count) const;
+
+            CMatrix3x4 &    Invert();
+            CMatrix3x4      GetInverse() const;
+
+            CMatrix3x4 &    SetTranslation(const CVector3 &_vec3);
+            CVector3        GetTranslation() const;
+
+            CMatrix3x4 &    MakeIdentity()                          { return *this = kIDENTITY; }
+
+            // Scale, rotate (X, Y, Z angles or quaternion) and translate. Same as CMatrix4
+            CMatrix3x4 &    MakeTransform(const CVector3 &_position, const CVector3 &_scale, const CQuaternion &_orientation);
+            CMatrix3x4 &    MakeTransform(const CVector3 &_position, const CVector3 &_scale, const CVector3 &_angles);
+            CMatrix3x4 &    MakeTransform(const CVector3 &_position, const CVector3 &_scale, float _angleZ);    // For sprites
+
+            // MakeTransform(_positions[i], _scales[i], _angles[i]) for every i, with the sines and cosines
+            // of the whole batch computed at once (SIMD)
+            static void     MakeTransforms(const CVector3 *_positions, const CVector3 *_scales, const CVector3 *_angles, CMatrix3x4 *_out, size_t _count);
+
+            void            Print() const;
+
+        protected:
+            CMatrix3x4 &    MakeTransformSinCos(const CVector3 &_position, const CVector3 &_scale, const float _sin[3], const float _cos[3]);
+
+        public:
+            // Implementations selected at build time by the members above (see configMathLib.h).
+            // The scalar ones are always available: they are the bit exact reference
+            static void     MultiplyScalar(const CMatrix3x4 &_a, const CMatrix3x4 &_b, CMatrix3x4 &_out);
+            static void     InvertScalar(const CMatrix3x4 &_in, CMatrix3x4 &_out);
+#if defined(MS_MATH_SSE)
+            static void     MultiplySSE(const CMatrix3x4 &_a, const CMatrix3x4 &_b, CMatrix3x4 &_out);
+            static void     InvertSSE(const CMatrix3x4 &_in, CMatrix3x4 &_out);
+#endif
+
+        public:
+            static const CMatrix3x4 kZERO;
+            static const CMatrix3x4 kIDENTITY;
+
+        protected:
+            // Indexed by [row][col]
+            union {
+                float   m[3][4];
+                float   v[12];
+            };
+    };
+
+} // end of namespace
+
+//-------------------------------------
+#include "CVector3.h"
+#include "CMatrix4.h"
+#include "CQuaternion.h"
+//-------------------------------------
+#include <Common/Math/math_funcs.h>
+//-------------------------------------
+
+//-------------------------------------
+namespace MindShake
+{
+
+    //---------------------------------
+    inline constexpr
+    CMatrix3x4::CMatrix3x4(float _m00, float _m01, float _m02, float _m03,
+                           float _m10, float _m11, float _m12, float _m13,
+                           float _m20, float _m21, float _m22, float _m23)
+        : m { { _m00, _m01, _m02, _m03 },
+              { _m10, _m11, _m12, _m13 },
+              { _m20, _m21, _m22, _m23 } } {
+    }
+
+    //---------------------------------
+    inline constexpr CMatrix3x4 CMatrix3x4::kZERO(
+        0, 0, 0, 0,
+        0, 0, 0, 0,
+        0, 0, 0, 0);
+
+    //---------------------------------
+    inline constexpr CMatrix3x4 CMatrix3x4::kIDENTITY(
+        1, 0, 0, 0,
+        0, 1, 0, 0,
+        0, 0, 1, 0);
+
+    //---------------------------------
+    inline
+    CMatrix3x4::CMatrix3x4(const CMatrix4 &_mat4) {
+        Set(_mat4);
+    }
+
+    //---------------------------------
+    inline CMatrix3x4 &
+    CMatrix3x4::Set(float _m00, float _m01, float _m02, float _m03,
+                    float _m10, float _m11, float _m12, float _m13,
+                    float _m20, float _m21, float _m22, float _m23) {
+        m[0][0] = _m00;
+        m[0][1] = _m01;
+        m[0][2] = _m02;
+        m[0][3] = _m03;
+
+        m[1][0] = _m10;
+        m[1][1] = _m11;
+        m[1][2] = _m12;
+        m[1][3] = _m13;
+
+        m[2][0] = _m20;
+        m[2][1] = _m21;
+        m[2][2] = _m22;
+        m[2][3] = _m23;
+
+        return *this;
+    }
+
+    //---------------------------------
+    inline CMatrix3x4 &
+    CMatrix3x4::Set(const CMatrix4 &_mat4) {
+        assert(_mat4.IsAffine());
+
+#if defined(MS_MATH_SSE)
+        const float *p  = _mat4.GetPtr();
+        __m128      c0 = _mm_load_ps(p);
+        __m128      c1 = _mm_load_ps(p + 4);
+        __m128      c2 = _mm_load_ps(p + 8);
+        __m128      c3 = _mm_load_ps(p + 12);
+
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        _mm_store_ps(m[0], c0);
+        _mm_store_ps(m[1], c1);
+        _mm_store_ps(m[2], c2);
+#else
+        for (size_t row = 0; row < 3; ++row) {
+            for (size_t col = 0; col < 4; ++col)
+                m[row][col] = _mat4[col][row];
+        }
+#endif
+
+        return *this;
+    }
+
+    //---------------------------------
+    inline bool
+    CMatrix3x4::operator == (const CMatrix3x4 &_other) const {
+        for (size_t i = 0; i < 3 * 4; ++i) {
+            if (v[i] != _other.v[i])
+                return false;
+        }
+
+        return true;
+    }
+
+    //---------------------------------
+    // Multiply / Concatenate
+    //---------------------------------
+    inline CMatrix3x4 &
+    CMatrix3x4::Concatenate(const CMatrix3x4 &_other) {
+#if defined(MS_MATH_SSE)
+        MultiplySSE(*this, _other, *this);
+#else
+        MultiplyScalar(*this, _other, *this);
+#endif
+
+        return *this;
+    }
+
+    //---------------------------------
+    inline CMatrix3x4
+    CMatrix3x4::GetConcatenated(const CMatrix3x4 &_other) const {
+        CMatrix3x4 r;
+
+#if defined(MS_MATH_SSE)
+        MultiplySSE(*this, _other, r);
+#else
+        MultiplyScalar(*this, _other, r);
+#endif
+
+        return r;
+    }
+
+    //---------------------------------
+    // Same operation order as CMatrix4::ConcatenateAffine. _out may alias _a or _b
+    //---------------------------------
+    inline void
+    CMatrix3x4::MultiplyScalar(const CMatrix3x4 &_a, const CMatrix3x4 &_b, CMatrix3x4 &_out) {
+        CMatrix3x4 r;
+
+        for (size_t row = 0; row < 3; ++row) {
+            r.m[row][0] = _a.m[row][0] * _b.m[0][0] + _a.m[row][1] * _b.m[1][0] + _a.m[row][2] * _b.m[2][0];
+            r.m[row][1] = _a.m[row][0] * _b.m[0][1] + _a.m[row][1] * _b.m[1][1] + _a.m[row][2] * _b.m[2][1];
+            r.m[row][2] = _a.m[row][0] * _b.m[0][2] + _a.m[row][1] * _b.m[1][2] + _a.m[row][2] * _b.m[2][2];
+            r.m[row][3] = _a.m[row][0] * _b.m[0][3] + _a.m[row][1] * _b.m[1][3] + _a.m[row][2] * _b.m[2][3] + _a.m[row][3];
+        }
+
+        _out = r;
+    }
+
+#if defined(MS_MATH_SSE)
+    //---------------------------------
+    // Row i of the result is the linear combination of the rows of _b weighted
+    // by row i of _a, plus the translation of _a. 9 mul + 9 add.
+    //---------------------------------
+    inline void
+    CMatrix3x4::MultiplySSE(const CMatrix3x4 &_a, const CMatrix3x4 &_b, CMatrix3x4 &_out) {
+        const __m128    maskW = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+        __m128          a0 = _mm_load_ps(_a.m[0]);
+        __m128          a1 = _mm_load_ps(_a.m[1]);
+        __m128          a2 = _mm_load_ps(_a.m[2]);
+        __m128          b0 = _mm_load_ps(_b.m[0]);
+        __m128          b1 = _mm_load_ps(_b.m[1]);
+        __m128          b2 = _mm_load_ps(_b.m[2]);
+
+        #define MS_ROW(a)   _mm_add_ps(_mm_add_ps(_mm_add_ps(                   \
+                                _mm_mul_ps(b0, SimdSplatX(a)),                  \
+                                _mm_mul_ps(b1, SimdSplatY(a))),                 \
+                                _mm_mul_ps(b2, SimdSplatZ(a))),                 \
+                                _mm_and_ps(a, maskW))
+        _mm_store_ps(_out.m[0], MS_ROW(a0));
+        _mm_store_ps(_out.m[1], MS_ROW(a1));
+        _mm_store_ps(_out.m[2], MS_ROW(a2));
+        #undef MS_ROW
+    }
+#endif
+
+    //---------------------------------
+    inline CVector3
+    CMatrix3x4::operator * (const CVector3 &_vec3) const {
+        return CVector3(
+            m[0][0] * _vec3.x + m[0][1] * _vec3.y + m[0][2] * _vec3.z + m[0][3],
+            m[1][0] * _vec3.x + m[1][1] * _vec3.y + m[1][2] * _vec3.z + m[1][3],
+            m[2][0] * _vec3.x + m[2][1] * _vec3.y + m[2][2] * _vec3.z + m[2][3]
+        );
+    }
+
+    //---------------------------------
+    inline CVector3
+    CMatrix3x4::TransformVector(const CVector3 &_vec3) const {
+        return CVector3(
+            m[0][0] * _vec3.x + m[0][1] * _vec3.y + m[0][2] * _vec3.z,
+            m[1][0] * _vec3.x + m[1][1] * _vec3.y + m[1][2] * _vec3.z,
+            m[2][0] * _vec3.x + m[2][1] * _vec3.y + m[2][2] * _vec3.z
+        );
+    }
+
+    //---------------------------------
+    // Inverse
+    //---------------------------------
+    inline CMatrix3x4 &
+    CMatrix3x4::Invert() {
+#if defined(MS_MATH_SSE)
+        InvertSSE(*this, *this);
+#else
+        InvertScalar(*this, *this);
+#endif
+
+        return *this;
+    }
+
+    //---------------------------------
+    inline CMatrix3x4
+    CMatrix3x4::GetInverse() const {
+        CMatrix3x4 r;
+
+#if defined(MS_MATH_SSE)
+        InvertSSE(*this, r);
+#else
+        InvertScalar(*this, r);
+#endif
+
+        return r;
+    }
+
+    //---------------------------------
+    // For the 3x3 with rows r0, r1, r2 the columns of the inverse are
+    // (r1 x r2, r2 x r0, r0 x r1) / det, translation = -inverse3x3 * translation.
+    // A singular 3x3 is kept as is (as CMatrix4::InvertAffine does).
+    // Single precision determinant, same operation order as InvertSSE.
+    // _out may alias _in
+    //---------------------------------
+    inline void
+    CMatrix3x4::InvertScalar(const CMatrix3x4 &_in, CMatrix3x4 &_out) {
+        float   c[3][3];        // [col][row]
+        float   det;
+        float   x = _in.m[0][3];
+        float   y = _in.m[1][3];
+        float   z = _in.m[2][3];
+
+        for (size_t col = 0; col < 3; ++col) {
+            const float *a = _in.m[(col + 1) % 3];
+            const float *b = _in.m[(col + 2) % 3];
+
+            c[col][0] = a[1] * b[2] - a[2] * b[1];
+            c[col][1] = a[2] * b[0] - a[0] * b[2];
+            c[col][2] = a[0] * b[1] - a[1] * b[0];
+        }
+
+        det = (_in.m[0][0] * c[0][0] + _in.m[0][2] * c[0][2]) + _in.m[0][1] * c[0][1];
+        if (MindShake::IsZero(det, Float32::EPSILON)) {
+            for (size_t col = 0; col < 3; ++col) {
+                for (size_t row = 0; row < 3; ++row)
+                    c[col][row] = _in.m[row][col];
+            }
+        }
+        else {
+            float invDet = 1.0f / det;
+
+            for (size_t col = 0; col < 3; ++col) {
+                for (size_t row = 0; row < 3; ++row)
+                    c[col][row] *= invDet;
+            }
+        }
+
+        for (size_t row = 0; row < 3; ++row) {
+            _out.m[row][0] = c[0][row];
+            _out.m[row][1] = c[1][row];
+            _out.m[row][2] = c[2][row];
+            _out.m[row][3] = -(c[0][row] * x + c[1][row] * y + c[2][row] * z);
+        }
+    }
+
+#if defined(MS_MATH_SSE)
+    //---------------------------------
+    inline void
+    CMatrix3x4::InvertSSE(const CMatrix3x4 &_in, CMatrix3x4 &_out) {
+        const __m128    maskXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+        __m128          r0 = _mm_load_ps(_in.m[0]);
+        __m128          r1 = _mm_load_ps(_in.m[1]);
+        __m128          r2 = _mm_load_ps(_in.m[2]);
+        __m128          x  = SimdSplatW(r0);
+        __m128          y  = SimdSplatW(r1);
+        __m128          z  = SimdSplatW(r2);
+        __m128          c0, c1, c2, t, det;
+        float           det0;
+
+        r0 = _mm_and_ps(r0, maskXYZ);
+        r1 = _mm_and_ps(r1, maskXYZ);
+        r2 = _mm_and_ps(r2, maskXYZ);
+
+        c0 = SimdCross3(r1, r2);
+        c1 = SimdCross3(r2, r0);
+        c2 = SimdCross3(r0, r1);
+
+        det  = _mm_mul_ps(r0, c0);
+        det  = _mm_add_ps(det, _mm_movehl_ps(det, det));
+        det  = _mm_add_ss(det, SimdSplatY(det));
+        det0 = _mm_cvtss_f32(det);
+
+        if (MindShake::IsZero(det0, Float32::EPSILON)) {
+            c0 = r0;
+            c1 = r1;
+            c2 = r2;
+            t  = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(c0, c1, c2, t);
+        }
+        else {
+            det = _mm_set1_ps(1.0f / det0);
+            c0  = _mm_mul_ps(c0, det);
+            c1  = _mm_mul_ps(c1, det);
+            c2  = _mm_mul_ps(c2, det);
+        }
+
+        t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, x), _mm_mul_ps(c1, y)), _mm_mul_ps(c2, z));
+        t = _mm_xor_ps(t, _mm_set1_ps(-0.0f));
+
+        // Columns (and translation) to rows
+        _MM_TRANSPOSE4_PS(c0, c1, c2, t);
+        _mm_store_ps(_out.m[0], c0);
+        _mm_store_ps(_out.m[1], c1);
+        _mm_store_ps(_out.m[2], c2);
+    }
+#endif
+
+    //---------------------------------
+    // Translation
+    //---------------------------------
+    inline CMatrix3x4 &
+    CMatrix3x4::SetTranslation(const CVector3 &_vec3) {
+        m[0][3] = _vec3.x;
+        m[1][3] = _vec3.y;
+        m[2][3] = _vec3.z;
+
+        return *this;
+    }
+
+    //---------------------------------
+    inline CVector3
+    CMatrix3x4::GetTranslation() const {
+        return CVector3(m[0][3], m[1][3], m[2][3]);
+    }
+
+    //---------------------------------
+    // Transforms
+    //---------------------------------
+    inline CMatrix3x4 &
+    CMatrix3x4::MakeTransform(const CVector3 &_position, const CVector3 &_scale, const CQuaternion &_orientation) {
+        // Rotation matrix of the (unit) quaternion, columns scaled: no trig
+        float   tx  = 2.0f * _orientation.x;
+        float   ty  = 2.0f * _orientation.y;
+        float   tz  = 2.0f * _orientation.z;
+        float   twx = tx * _orientation.w;
+        float   twy = ty * _orientation.w;
+        float   twz = tz * _orientation.w;
+        float   txx = tx * _orientation.x;
+        float   txy = ty * _orientation.x;
+        float   txz = tz * _orientation.x;
+        float   tyy = ty * _orientation.y;
+        float   tyz = tz * _orientation.y;
+        float   tzz = tz * _orientation.z;
+
+        m[0][0] = (1.0f - (tyy + tzz)) * _scale.x;
+        m[0][1] = (txy - twz) * _scale.y;
+        m[0][2] = (txz + twy) * _scale.z;
+        m[0][3] = _position.x;
+
+        m[1][0] = (txy + twz) * _scale.x;
+        m[1][1] = (1.0f - (txx + tzz)) * _scale.y;
+        m[1][2] = (tyz - twx) * _scale.z;
+        m[1][3] = _position.y;
+
+        m[2][0] = (txz - twy) * _scale.x;
+        m[2][1] = (tyz + twx) * _scale.y;
+        m[2][2] = (1.0f - (txx + tyy)) * _scale.z;
+        m[2][3] = _position.z;
+
+        return *this;
+    }
+
+    //---------------------------------
+    inline CMatrix3x4 &
+    CMatrix3x4::MakeTransform(const CVector3 &_position, const CVector3 &_scale, const CVector3 &_angles) {
+        float   sines[3], cosines[3];
+
+        MindShake::SinCosG(&_angles.x, sines, cosines, 3);
+
+        return MakeTransformSinCos(_position, _scale, sines, cosines);
+    }
+
+    //---------------------------------
+    inline CMatrix3x4 &
+    CMatrix3x4::MakeTransform(const CVector3 &_position, const CVector3 &_scale, float _angleZ) {
+        float   sinZ = MindShake::SinG(_angleZ);
+        float   cosZ = MindShake::CosG(_angleZ);
+
+        return Set(cosZ * _scale.x, -sinZ * _scale.y, 0,        _position.x,
+                   sinZ * _scale.x,  cosZ * _scale.y, 0,        _position.y,
+                   0,                0,               _scale.z, _position.z);
+    }
+
+    //---------------------------------
+    // Same matrix as CMatrix4::MakeTransformSinCos
+    //---------------------------------
+    inline CMatrix3x4 &
+    CMatrix3x4::MakeTransformSinCos(const CVector3 &_position, const CVector3 &_scale, const float _sin[3], const float _cos[3]) {
+        float   sinX = _sin[0], cosX = _cos[0];
+        float   sinY = _sin[1], cosY = _cos[1];
+        float   sinZ = _sin[2], cosZ = _cos[2];
+
+        m[0][0] =  cosY * cosZ * _scale.x;
+        m[0][1] = -cosY * sinZ * _scale.y;
+        m[0][2] = sinY * _scale.z;
+        m[0][3] = _position.x;
+
+        m[1][0] = (cosX * sinZ + sinX * sinY * cosZ) * _scale.x;
+        m[1][1] = (cosX * cosZ - sinX * sinY * sinZ) * _scale.y;
+        m[1][2] = -sinX * cosY * _scale.z;
+        m[1][3] = _position.y;
+
+        m[2][0] = (sinX * sinZ - cosX * sinY * cosZ) * _scale.x;
+        m[2][1] = (sinX * cosZ + cosX * sinY * sinZ) * _scale.y;
+        m[2][2] = cosX * cosY * _scale.z;
+        m[2][3] = _position.z;
+
+        return *this;
+    }
+
+} // end of namespace
@@ -2,8 +2,11 @@
 #include <Common/Math/configMathLib.h>
 //--------------------------------------
 #include "CMatrix4.h"
+#include "CVector3.h"
+#include "CVector4.h"
 //--------------------------------------
 #include <Core/log/log.h>
+#include <Kernel/cpu/CCpuKernel.h>
 //--------------------------------------
 
 
@@ -12,19 +15,360 @@ namespace MindShake
 {
 
     //----------------------------------
-    const  CMatrix4  CMatrix4::kZERO(
-        0, 0, 0, 0,
-        0, 0, 0, 0,
-        0, 0, 0, 0,
-        0, 0, 0, 0);
+    // Batch transforms. Each one is bound at startup to the widest variant
+    // the CPU supports (see CCpuKernel). The AVX2 and AVX-512 variants use
+    // FMA: they are not bit exact with the scalar and SSE ones.
+    // Variants take the matrix as 16 floats, column major.
+    //----------------------------------
+    static_assert(sizeof(CVector3) == 3 * sizeof(float), "CVector3 must be packed");
+    static_assert(sizeof(CVector4) == 4 * sizeof(float), "CVector4 must be packed");
+
+    using TransformPointsFunc   = void (*)(const float *_m, const CVector3 *_in, CVector4 *_out, size_t _count);
+    using TransformPoints3Func  = void (*)(const float *_m, const CVector3 *_in, CVector3 *_out, size_t _count);
+
+    //----------------------------------
+    static void
+    TransformPointsScalar(const float *_m, const CVector3 *_in, CVector4 *_out, size_t _count) {
+        for (size_t i = 0; i < _count; ++i) {
+            const CVector3 &p = _in[i];
+
+            _out[i].x = _m[0] * p.x + _m[4] * p.y + _m[ 8] * p.z + _m[12];
+            _out[i].y = _m[1] * p.x + _m[5] * p.y + _m[ 9] * p.z + _m[13];
+            _out[i].z = _m[2] * p.x + _m[6] * p.y + _m[10] * p.z + _m[14];
+            _out[i].w = _m[3] * p.x + _m[7] * p.y + _m[11] * p.z + _m[15];
+        }
+    }
+
+    //----------------------------------
+    static void
+    TransformPointsDivideScalar(const float *_m, const CVector3 *_in, CVector3 *_out, size_t _count) {
+        for (size_t i = 0; i < _count; ++i) {
+            const CVector3  &p = _in[i];
+            float           w  = _m[3] * p.x + _m[7] * p.y + _m[11] * p.z + _m[15];
+
+            if (w != 0.0f) {
+                float invW = 1.0f / w;
+
+                _out[i].x = (_m[0] * p.x + _m[4] * p.y + _m[ 8] * p.z + _m[12]) * invW;
+                _out[i].y = (_m[1] * p.x + _m[5] * p.y + _m[ 9] * p.z + _m[13]) * invW;
+                _out[i].z = (_m[2] * p.x + _m[6] * p.y + _m[10] * p.z + _m[14]) * invW;
+            }
+            else {
+                _out[i].x = 0.0f;
+                _out[i].y = 0.0f;
+                _out[i].z = Float32::POS_INFINITY;
+            }
+        }
+    }
+
+    //----------------------------------
+    static void
+    TransformPointsAffineScalar(const float *_m, const CVector3 *_in, CVector3 *_out, size_t _count) {
+        for (size_t i = 0; i < _count; ++i) {
+            const CVector3 &p = _in[i];
+
+            _out[i].x = _m[0] * p.x + _m[4] * p.y + _m[ 8] * p.z + _m[12];
+            _out[i].y = _m[1] * p.x + _m[5] * p.y + _m[ 9] * p.z + _m[13];
+            _out[i].z = _m[2] * p.x + _m[6] * p.y + _m[10] * p.z + _m[14];
+        }
+    }
+
+#if defined(MS_MATH_SSE)
+    //----------------------------------
+    // Only the last point of a batch uses the exact (slower) access
+    //----------------------------------
+    static inline __m128
+    LoadPoint(const CVector3 &_point, bool _isLast) {
+        return SimdLoadPoint3(&_point.x, _isLast);
+    }
+
+    //----------------------------------
+    static inline void
+    StorePoint(CVector3 &_point, __m128 _value, bool _isLast) {
+        SimdStorePoint3(&_point.x, _value, _isLast);
+    }
+
+    //----------------------------------
+    // c0 * x + c1 * y + c2 * z + c3. Same operation order as operator * (CVector4)
+    //----------------------------------
+    static inline __m128
+    TransformPoint(const __m128 _col[4], __m128 _point) {
+        return _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_col[0], _mm_shuffle_ps(_point, _point, _MM_SHUFFLE(0, 0, 0, 0))),
+                    _mm_mul_ps(_col[1], _mm_shuffle_ps(_point, _point, _MM_SHUFFLE(1, 1, 1, 1)))),
+                    _mm_mul_ps(_col[2], _mm_shuffle_ps(_point, _point, _MM_SHUFFLE(2, 2, 2, 2)))),
+                    _col[3]);
+    }
+
+    //----------------------------------
+    static inline __m128
+    DividePoint(__m128 _point) {
+        __m128  w      = _mm_shuffle_ps(_point, _point, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128  isZero = _mm_cmpeq_ps(w, _mm_setzero_ps());
+        __m128  r      = _mm_mul_ps(_point, _mm_div_ps(_mm_set1_ps(1.0f), w));
+
+        return _mm_or_ps(_mm_andnot_ps(isZero, r), _mm_and_ps(isZero, _mm_setr_ps(0.0f, 0.0f, Float32::POS_INFINITY, 0.0f)));
+    }
+
+    //----------------------------------
+    static void
+    TransformPointsSSE2(const float *_m, const CVector3 *_in, CVector4 *_out, size_t _count) {
+        const __m128 col[4] = { _mm_load_ps(_m), _mm_load_ps(_m + 4), _mm_load_ps(_m + 8), _mm_load_ps(_m + 12) };
+
+        for (size_t i = 0; i < _count; ++i) {
+            _mm_store_ps(&_out[i].x, TransformPoint(col, LoadPoint(_in[i], i + 1 == _count)));
+        }
+    }
+
+    //----------------------------------
+    static void
+    TransformPointsDivideSSE2(const float *_m, const CVector3 *_in, CVector3 *_out, size_t _count) {
+        const __m128 col[4] = { _mm_load_ps(_m), _mm_load_ps(_m + 4), _mm_load_ps(_m + 8), _mm_load_ps(_m + 12) };
+
+        for (size_t i = 0; i < _count; ++i) {
+            bool isLast = (i + 1 == _count);
+
+            StorePoint(_out[i], DividePoint(TransformPoint(col, LoadPoint(_in[i], isLast))), isLast);
+        }
+    }
+
+    //----------------------------------
+    static void
+    TransformPointsAffineSSE2(const float *_m, const CVector3 *_in, CVector3 *_out, size_t _count) {
+        const __m128 col[4] = { _mm_load_ps(_m), _mm_load_ps(_m + 4), _mm_load_ps(_m + 8), _mm_load_ps(_m + 12) };
+
+        for (size_t i = 0; i < _count; ++i) {
+            bool isLast = (i + 1 == _count);
+
+            StorePoint(_out[i], TransformPoint(col, LoadPoint(_in[i], isLast)), isLast);
+        }
+    }
+
+    //----------------------------------
+    // AVX2: two points per iteration. x0 y0 z0 x1 y1 z1 are loaded at once and
+    // broadcast to each 128 bit lane. Reads 8 floats: needs a third point after
+    // the pair, the last points go through the SSE2 variant
+    //----------------------------------
+    MS_TARGET_AVX2 static inline __m256
+    TransformPointPair(const __m256 _col[4], const CVector3 *_pair) {
+        const __m256i   idxX = _mm256_setr_epi32(0, 0, 0, 0, 3, 3, 3, 3);
+        const __m256i   idxY = _mm256_setr_epi32(1, 1, 1, 1, 4, 4, 4, 4);
+        const __m256i   idxZ = _mm256_setr_epi32(2, 2, 2, 2, 5, 5, 5, 5);
+        __m256          p    = _mm256_loadu_ps(&_pair->x);
+
+        return _mm256_fmadd_ps(_col[2], _mm256_permutevar8x32_ps(p, idxZ),
+               _mm256_fmadd_ps(_col[1], _mm256_permutevar8x32_ps(p, idxY),
+               _mm256_fmadd_ps(_col[0], _mm256_permutevar8x32_ps(p, idxX), _col[3])));
+    }
+
+    //----------------------------------
+    MS_TARGET_AVX2 static inline __m256
+    DividePointPair(__m256 _pair) {
+        __m256  w      = _mm256_permute_ps(_pair, _MM_SHUFFLE(3, 3, 3, 3));
+        __m256  isZero = _mm256_cmp_ps(w, _mm256_setzero_ps(), _CMP_EQ_OQ);
+        __m256  r      = _mm256_mul_ps(_pair, _mm256_div_ps(_mm256_set1_ps(1.0f), w));
+
+        return _mm256_blendv_ps(r, _mm256_setr_ps(0.0f, 0.0f, Float32::POS_INFINITY, 0.0f, 0.0f, 0.0f, Float32::POS_INFINITY, 0.0f), isZero);
+    }
+
+    //----------------------------------
+    MS_TARGET_AVX2 static inline void
+    LoadColumns(const float *_m, __m256 _col[4]) {
+        for (int i = 0; i < 4; ++i)
+            _col[i] = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(_m + i * 4));
+    }
+
+    //----------------------------------
+    MS_TARGET_AVX2 static void
+    TransformPointsAVX2(const float *_m, const CVector3 *_in, CVector4 *_out, size_t _count) {
+        __m256  col[4];
+        size_t  i = 0;
+
+        LoadColumns(_m, col);
+        for (; i + 3 <= _count; i += 2) {
+            _mm256_storeu_ps(&_out[i].x, TransformPointPair(col, &_in[i]));
+        }
+        TransformPointsSSE2(_m, _in + i, _out + i, _count - i);
+    }
+
+    //----------------------------------
+    MS_TARGET_AVX2 static void
+    TransformPointsDivideAVX2(const float *_m, const CVector3 *_in, CVector3 *_out, size_t _count) {
+        __m256  col[4];
+        size_t  i = 0;
+
+        LoadColumns(_m, col);
+        for (; i + 3 <= _count; i += 2) {
+            __m256 r = DividePointPair(TransformPointPair(col, &_in[i]));
+
+            _mm_storeu_ps(&_out[i].x,     _mm256_castps256_ps128(r));
+            _mm_storeu_ps(&_out[i + 1].x, _mm256_extractf128_ps(r, 1));
+        }
+        TransformPointsDivideSSE2(_m, _in + i, _out + i, _count - i);
+    }
+
+    //----------------------------------
+    MS_TARGET_AVX2 static void
+    TransformPointsAffineAVX2(const float *_m, const CVector3 *_in, CVector3 *_out, size_t _count) {
+        __m256  col[4];
+        size_t  i = 0;
+
+        LoadColumns(_m, col);
+        for (; i + 3 <= _count; i += 2) {
+            __m256 r = TransformPointPair(col, &_in[i]);
+
+            _mm_storeu_ps(&_out[i].x,     _mm256_castps256_ps128(r));
+            _mm_storeu_ps(&_out[i + 1].x, _mm256_extractf128_ps(r, 1));
+        }
+        TransformPointsAffineSSE2(_m, _in + i, _out + i, _count - i);
+    }
+
+    //----------------------------------
+    // AVX-512: four points per iteration, with the same operations as the
+    // AVX2 pairs. Masked loads and stores handle the last points without
+    // touching memory past the arrays.
+    // Zero masking with all lanes set, instead of the unmasked intrinsics:
+    // GCC 12 warns about the undefined source those use
+    //----------------------------------
+    MS_TARGET_AVX512 static inline __m512
+    TransformPointQuad(const __m512 _col[4], const CVector3 *_quad, size_t _numPoints) {
+        const __m512i   idxX = _mm512_setr_epi32(0, 0, 0, 0, 3, 3, 3, 3, 6, 6, 6, 6,  9,  9,  9,  9);
+        const __m512i   idxY = _mm512_setr_epi32(1, 1, 1, 1, 4, 4, 4, 4, 7, 7, 7, 7, 10, 10, 10, 10);
+        const __m512i   idxZ = _mm512_setr_epi32(2, 2, 2, 2, 5, 5, 5, 5, 8, 8, 8, 8, 11, 11, 11, 11);
+        __m512          p    = _mm512_maskz_loadu_ps(__mmask16((1u << (_numPoints * 3)) - 1u), &_quad->x);
+
+        return _mm512_fmadd_ps(_col[2], _mm512_maskz_permutexvar_ps(0xffff, idxZ, p),
+               _mm512_fmadd_ps(_col[1], _mm512_maskz_permutexvar_ps(0xffff, idxY, p),
+               _mm512_fmadd_ps(_col[0], _mm512_maskz_permutexvar_ps(0xffff, idxX, p), _col[3])));
+    }
+
+    //----------------------------------
+    // x y z of each point, packed
+    //----------------------------------
+    MS_TARGET_AVX512 static inline void
+    StorePointQuad(CVector3 *_quad, __m512 _points, size_t _numPoints) {
+        _mm512_mask_storeu_ps(&_quad->x, __mmask16((1u << (_numPoints * 3)) - 1u), _mm512_maskz_compress_ps(0x7777, _points));
+    }
 
     //----------------------------------
-    const  CMatrix4  CMatrix4::kIDENTITY(
-        1, 0, 0, 0,
-        0, 1, 0, 0,
-        0, 0, 1, 0,
-        0, 0, 0, 1);
+    MS_TARGET_AVX512 static inline void
+    LoadColumns(const float *_m, __m512 _col[4]) {
+        for (int i = 0; i < 4; ++i)
+            _col[i] = _mm512_maskz_broadcast_f32x4(0xffff, _mm_load_ps(_m + i * 4));
+    }
+
     //----------------------------------
+    MS_TARGET_AVX512 static void
+    TransformPointsAVX512(const float *_m, const CVector3 *_in, CVector4 *_out, size_t _count) {
+        __m512  col[4];
+
+        LoadColumns(_m, col);
+        for (size_t i = 0; i < _count; i += 4) {
+            size_t numPoints = (_count - i < 4) ? _count - i : 4;
+
+            _mm512_mask_storeu_ps(&_out[i].x, __mmask16((1u << (numPoints * 4)) - 1u), TransformPointQuad(col, &_in[i], numPoints));
+        }
+    }
+
+    //----------------------------------
+    MS_TARGET_AVX512 static void
+    TransformPointsDivideAVX512(const float *_m, const CVector3 *_in, CVector3 *_out, size_t _count) {
+        const __m512    inf = _mm512_setr_ps(0.0f, 0.0f, Float32::POS_INFINITY, 0.0f, 0.0f, 0.0f, Float32::POS_INFINITY, 0.0f,
+                                             0.0f, 0.0f, Float32::POS_INFINITY, 0.0f, 0.0f, 0.0f, Float32::POS_INFINITY, 0.0f);
+        __m512          col[4];
+
+        LoadColumns(_m, col);
+        for (size_t i = 0; i < _count; i += 4) {
+            size_t      numPoints = (_count - i < 4) ? _count - i : 4;
+            __m512      r         = TransformPointQuad(col, &_in[i], numPoints);
+            __m512      w         = _mm512_maskz_permute_ps(0xffff, r, _MM_SHUFFLE(3, 3, 3, 3));
+            __mmask16   isZero    = _mm512_cmp_ps_mask(w, _mm512_setzero_ps(), _CMP_EQ_OQ);
+
+            r = _mm512_mask_blend_ps(isZero, _mm512_mul_ps(r, _mm512_div_ps(_mm512_set1_ps(1.0f), w)), inf);
+            StorePointQuad(&_out[i], r, numPoints);
+        }
+    }
+
+    //----------------------------------
+    MS_TARGET_AVX512 static void
+    TransformPointsAffineAVX512(const float *_m, const CVector3 *_in, CVector3 *_out, size_t _count) {
+        __m512  col[4];
+
+        LoadColumns(_m, col);
+        for (size_t i = 0; i < _count; i += 4) {
+            size_t numPoints = (_count - i < 4) ? _count - i : 4;
+
+            StorePointQuad(&_out[i], TransformPointQuad(col, &_in[i], numPoints), numPoints);
+        }
+    }
+#endif
+
+    //----------------------------------
+    static CCpuKernel<TransformPointsFunc> sTransformPoints("CMatrix4::TransformPoints", {
+        { ECpuLevel::Scalar, TransformPointsScalar },
+#if defined(MS_MATH_SSE)
+        { ECpuLevel::SSE2,   TransformPointsSSE2   },
+        { ECpuLevel::AVX2,   TransformPointsAVX2   },
+        { ECpuLevel::AVX512, TransformPointsAVX512 },
+#endif
+    });
+
+    static CCpuKernel<TransformPoints3Func> sTransformPointsDivide("CMatrix4::TransformPointsDivide", {
+        { ECpuLevel::Scalar, TransformPointsDivideScalar },
+#if defined(MS_MATH_SSE)
+        { ECpuLevel::SSE2,   TransformPointsDivideSSE2   },
+        { ECpuLevel::AVX2,   TransformPointsDivideAVX2   },
+        { ECpuLevel::AVX512, TransformPointsDivideAVX512 },
+#endif
+    });
+
+    static CCpuKernel<TransformPoints3Func> sTransformPointsAffine("CMatrix4::TransformPointsAffine", {
+        { ECpuLevel::Scalar, TransformPointsAffineScalar },
+#if defined(MS_MATH_SSE)
+        { ECpuLevel::SSE2,   TransformPointsAffineSSE2   },
+        { ECpuLevel::AVX2,   TransformPointsAffineAVX2   },
+        { ECpuLevel::AVX512, TransformPointsAffineAVX512 },
+#endif
+    });
+
+    //----------------------------------
+    void
+    CMatrix4::TransformPoints(const CVector3 *_in, CVector4 *_out, size_t _count) const {
+        sTransformPoints(GetPtr(), _in, _out, _count);
+    }
+
+    //----------------------------------
+    void
+    CMatrix4::TransformPointsDivide(const CVector3 *_in, CVector3 *_out, size_t _count) const {
+        sTransformPointsDivide(GetPtr(), _in, _out, _count);
+    }
+
+    //----------------------------------
+    void
+    CMatrix4::TransformPointsAffine(const CVector3 *_in, CVector3 *_out, size_t _count) const {
+        assert(IsAffine());
+
+        sTransformPointsAffine(GetPtr(), _in, _out, _count);
+    }
+
+    //----------------------------------
+    void
+    CMatrix4::MakeTransforms(const CVector3 *_positions, const CVector3 *_scales, const CVector3 *_angles, CMatrix4 *_out, size_t _count) {
+        const size_t    kBatch = 64;
+        float           sines[kBatch * 3], cosines[kBatch * 3];
+
+        for (size_t i = 0; i < _count; i += kBatch) {
+            size_t  count = (_count - i < kBatch) ? _count - i : kBatch;
+
+            SinCosG(&_angles[i].x, sines, cosines, count * 3);
+            for (size_t j = 0; j < count; ++j) {
+                const CVector3 &pos   = _positions[i + j];
+                const CVector3 &scale = _scales[i + j];
+
+                _out[i + j].MakeTransformSinCos(pos.x, pos.y, pos.z, scale.x, scale.y, scale.z, &sines[j * 3], &cosines[j * 3]);
+            }
+        }
+    }
 
     //----------------------------------
     void
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <Common/Math/configMathLib.h>
+#include <Common/Math/simd_funcs.h>
 #include <Common/Math/constants.h>
 //-------------------------------------
 #include <cstddef>
@@ -13,6 +15,7 @@ namespace MindShake
     class CVector3;
     class CVector4;
     class CMatrix3;
+    class CMatrix3x4;
     class CQuaternion;
     //---------------------------------
 
@@ -48,7 +51,7 @@ namespace MindShake
                             CMatrix4(const CMatrix4 &_other)    = default;
                             ~CMatrix4()                         = default;
 
-                            CMatrix4(float _m00, float _m01, float _m02, float _m03,
+                  constexpr CMatrix4(float _m00, float _m01, float _m02, float _m03,
                                      float _m10, float _m11, float _m12, float _m13,
                                      float _m20, float _m21, float _m22, float _m23,
                                      float _m30, float _m31, float _m32, float _m33);
@@ -56,10 +59,12 @@ namespace MindShake
             template <typename T>
             explicit        CMatrix4(const T *_ptr);
                             CMatrix4(const CMatrix3    &_mat3);
+                            CMatrix4(const CMatrix3x4  &_affine);
                             CMatrix4(const CQuaternion &_quat);
 
             CMatrix4 &      operator = (const CMatrix4 &_other)  = default;
             CMatrix4 &      operator = (const CMatrix3    &_mat3);
+            CMatrix4 &      operator = (const CMatrix3x4  &_affine);
             CMatrix4 &      operator = (const CQuaternion &_quat);
 
             CMatrix4 &      Set(float _m00, float _m01, float _m02, float _m03,
@@ -68,6 +73,7 @@ namespace MindShake
                                 float _m30, float _m31, float _m32, float _m33);
             CMatrix4 &      Set(const CMatrix4 &_other);
             CMatrix4 &      Set(const CMatrix3 &_mat3);
+            CMatrix4 &      Set(const CMatrix3x4 &_affine);
             CMatrix4 &      Set(const CQuaternion &_quat);
 
             // Remember this matrix is column major
@@ -102,6 +108,9 @@ namespace MindShake
             CMatrix4 &      Concatenate(const CMatrix4 &_other);
             CMatrix4        GetConcatenated(const CMatrix4 &_other) const;
             CMatrix4        operator * (const CMatrix4 &_other) const;
+            // this * _affine (ie. view projection * world), without the row 3 of _affine
+            CMatrix4        GetConcatenated(const CMatrix3x4 &_affine) const;
+            CMatrix4        operator * (const CMatrix3x4 &_affine) const;
             // v' = M * v
             CVector2        operator * (const CVector2 &_vec2) const;           // Z = 0, W = 1
             CVector3        operator * (const CVector3 &_vec3) const;           // W = 1
@@ -120,6 +129,11 @@ namespace MindShake
             CVector3        TransformAffine(const CVector3 &_vec3) const;
             CVector4        TransformAffine(const CVector4 &_vec4) const;
 
+            // Batch transforms of _count points (W = 1). _in and _out must not overlap
+            void            TransformPoints(const CVector3 *_in, CVector4 *_out, size_t _count) const;          // Clip space
+            void            TransformPointsDivide(const CVector3 *_in, CVector3 *_out, size_t _count) const;    // Divided by W, (0, 0, +inf) if W == 0
+            void            TransformPointsAffine(const CVector3 *_in, CVector3 *_out, size_t _count) const;
+
             // Transpose
             CMatrix4 &      Transpose();
             CMatrix4        GetTransposed() const;
@@ -205,6 +219,10 @@ namespace MindShake
 
             CMatrix4 &      MakeInverseTransform(const CVector3 &_position, const CVector3 &_scale, const CQuaternion &_orientation);
 
+            // MakeTransform(_positions[i], _scales[i], _angles[i]) for every i, with the sines and cosines
+            // of all the angles computed in SIMD batches (see SinCosG)
+            static void     MakeTransforms(const CVector3 *_positions, const CVector3 *_scales, const CVector3 *_angles, CMatrix4 *_out, size_t _count);
+
             CMatrix3        Extract3x3Matrix() const;
             void            Extract3x3Matrix(CMatrix3 &_mat3) const;
             void            ExtractQuaternion(CQuaternion &_quat) const;
@@ -222,13 +240,34 @@ namespace MindShake
         protected:
             float           MINOR(size_t r0, size_t r1, size_t r2, size_t c0, size_t c1, size_t c2) const;
 
+            // Scale, rotate (X, Y, Z angles given by their sines and cosines) and translate
+            CMatrix4 &      MakeTransformSinCos(float _posX,   float _posY,   float _posZ,
+                                                float _scaleX, float _scaleY, float _scaleZ,
+                                                const float _sin[3], const float _cos[3]);
+
+        public:
+            // Implementations selected at build time by the members above (see configMathLib.h).
+            // The scalar ones are always available: they are the reference.
+            // - MultiplySSE is bit exact, but not faster, so GetConcatenated uses MultiplyScalar.
+            // - InvertAffineSSE is bit exact (double determinant, as InvertAffineScalar).
+            // - InvertSSE works in single precision while InvertScalar uses double: expect a
+            //   relative difference up to ~1e-4 on well conditioned matrices, more on bad ones.
+            static void     MultiplyScalar(const CMatrix4 &_a, const CMatrix4 &_b, CMatrix4 &_out);
+            static void     InvertScalar(const CMatrix4 &_in, CMatrix4 &_out);
+            static void     InvertAffineScalar(const CMatrix4 &_in, CMatrix4 &_out);
+#if defined(MS_MATH_SSE)
+            static void     MultiplySSE(const CMatrix4 &_a, const CMatrix4 &_b, CMatrix4 &_out);
+            static void     InvertSSE(const CMatrix4 &_in, CMatrix4 &_out);
+            static void     InvertAffineSSE(const CMatrix4 &_in, CMatrix4 &_out);
+#endif
+
         protected:
             static CMatrix4 &InvertAux(const CMatrix4 &_in, CMatrix4 &_out);
             static CMatrix4 &InvertAffineAux(const CMatrix4 &_in, CMatrix4 &_out);
 
         public:
-            static CMatrix4 BuildTranslationMatrix(const CVector3 &_vec3);
-            static CMatrix4 BuildTranslationMatrix(float _tx, float _ty, float _tz);
+            static constexpr CMatrix4 BuildTranslationMatrix(const CVector3 &_vec3);
+            static constexpr CMatrix4 BuildTranslationMatrix(float _tx, float _ty, float _tz);
 
             static CMatrix4 BuildRotationMatrix(const CVector3 &_angles);
             static CMatrix4 BuildRotationMatrix(float _angleX, float _angleY, float _angleZ);
@@ -237,13 +276,13 @@ namespace MindShake
             static CMatrix4 BuildRotationMatrix(const CMatrix3 &_mat3);
             static CMatrix4 BuildRotationMatrix(const CQuaternion &_quat);
 
-            static CMatrix4 BuildScaleMatrix(const CVector3 &_vec3);
-            static CMatrix4 BuildScaleMatrix(float _sx, float _sy, float _sz);
+            static constexpr CMatrix4 BuildScaleMatrix(const CVector3 &_vec3);
+            static constexpr CMatrix4 BuildScaleMatrix(float _sx, float _sy, float _sz);
 
-            static CMatrix4 Ortho(float _left, float _right, float _bottom, float _top, float _near, float _far);
+            static constexpr CMatrix4 Ortho(float _left, float _right, float _bottom, float _top, float _near, float _far);
             static CMatrix4 Perspective(float _fovy, float _aspect, float _zNear, float _zFar);
             static CMatrix4 PerspectiveReverseZ(float _fovy, float _aspect, float _zNear);       // Don't use with OpenGL 4.5-!
-            static CMatrix4 Frustum(float _left, float _right, float _bottom, float _top, float _near, float _far);
+            static constexpr CMatrix4 Frustum(float _left, float _right, float _bottom, float _top, float _near, float _far);
             static CMatrix4 LookAt(float    _posx, float    _posy, float    _posz,
                                    float _targetx, float _targety, float _targetz,
                                    float     _upx, float     _upy, float     _upz);
@@ -255,8 +294,8 @@ namespace MindShake
                                           float     _upx, float     _upy, float     _upz);
             static CMatrix4 InverseLookAt(const CVector3 &_pos, const CVector3 &_target, const CVector3 &_up);
 
-            static CMatrix4 Viewport(float _left, float _right, float _top, float _bottom, float _near, float _far);
-            static CMatrix4 Viewport(float _left, float _right, float _top, float _bottom);
+            static constexpr CMatrix4 Viewport(float _left, float _right, float _top, float _bottom, float _near, float _far);
+            static constexpr CMatrix4 Viewport(float _left, float _right, float _top, float _bottom);
 
         public:
             static const CMatrix4 kZERO;
@@ -284,6 +323,7 @@ namespace MindShake
 #include "CVector3.h"
 #include "CVector4.h"
 #include "CMatrix3.h"
+#include "CMatrix3x4.h"
 #include "CQuaternion.h"
 //-------------------------------------
 #include <Common/Math/math_funcs.h>
@@ -293,17 +333,31 @@ namespace MindShake
 namespace MindShake {
 
     //---------------------------------
-    inline
+    inline constexpr
     CMatrix4::CMatrix4(float _m00, float _m01, float _m02, float _m03,
              float _m10, float _m11, float _m12, float _m13,
              float _m20, float _m21, float _m22, float _m23,
-             float _m30, float _m31, float _m32, float _m33) {
-        Set(_m00, _m01, _m02, _m03,
-            _m10, _m11, _m12, _m13,
-            _m20, _m21, _m22, _m23,
-            _m30, _m31, _m32, _m33);
+             float _m30, float _m31, float _m32, float _m33)
+        : m { { _m00, _m01, _m02, _m03 },
+              { _m10, _m11, _m12, _m13 },
+              { _m20, _m21, _m22, _m23 },
+              { _m30, _m31, _m32, _m33 } } {
     }
 
+    //---------------------------------
+    inline constexpr CMatrix4 CMatrix4::kZERO(
+        0, 0, 0, 0,
+        0, 0, 0, 0,
+        0, 0, 0, 0,
+        0, 0, 0, 0);
+
+    //---------------------------------
+    inline constexpr CMatrix4 CMatrix4::kIDENTITY(
+        1, 0, 0, 0,
+        0, 1, 0, 0,
+        0, 0, 1, 0,
+        0, 0, 0, 1);
+
     //---------------------------------
     template <typename T>
     inline
@@ -320,6 +374,12 @@ namespace MindShake {
         Set(_mat3);
     }
 
+    //---------------------------------
+    inline
+    CMatrix4::CMatrix4(const CMatrix3x4 &_affine) {
+        Set(_affine);
+    }
+
     //---------------------------------
     inline
     CMatrix4::CMatrix4(const CQuaternion &_quat) {
@@ -332,6 +392,12 @@ namespace MindShake {
         return Set(_mat3);
     }
 
+    //---------------------------------
+    inline CMatrix4 &
+    CMatrix4::operator = (const CMatrix3x4 &_affine) {
+        return Set(_affine);
+    }
+
     //---------------------------------
     inline CMatrix4 &
     CMatrix4::operator = (const CQuaternion &_quat) {
@@ -405,6 +471,32 @@ namespace MindShake {
         return *this;
     }
 
+    //---------------------------------
+    inline CMatrix4 &
+    CMatrix4::Set(const CMatrix3x4 &_affine) {
+#if defined(MS_MATH_SSE)
+        __m128  c0 = _mm_load_ps(_affine.m[0]);
+        __m128  c1 = _mm_load_ps(_affine.m[1]);
+        __m128  c2 = _mm_load_ps(_affine.m[2]);
+        __m128  c3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        _mm_store_ps(m[0], c0);
+        _mm_store_ps(m[1], c1);
+        _mm_store_ps(m[2], c2);
+        _mm_store_ps(m[3], c3);
+#else
+        for (size_t col = 0; col < 4; ++col) {
+            m[col][0] = _affine.m[0][col];
+            m[col][1] = _affine.m[1][col];
+            m[col][2] = _affine.m[2][col];
+            m[col][3] = (col == 3) ? 1.0f : 0.0f;
+        }
+#endif
+
+        return *this;
+    }
+
     //---------------------------------
     inline CMatrix4 &
     CMatrix4::Set(const CQuaternion &_quat) {
@@ -616,35 +708,118 @@ namespace MindShake {
     CMatrix4::GetConcatenated(const CMatrix4 &_other) const {
         CMatrix4 r;
 
-        r.m[0][0] = m[0][0] * _other.m[0][0] + m[1][0] * _other.m[0][1] + m[2][0] * _other.m[0][2] + m[3][0] * _other.m[0][3];
-        r.m[1][0] = m[0][0] * _other.m[1][0] + m[1][0] * _other.m[1][1] + m[2][0] * _other.m[1][2] + m[3][0] * _other.m[1][3];
-        r.m[2][0] = m[0][0] * _other.m[2][0] + m[1][0] * _other.m[2][1] + m[2][0] * _other.m[2][2] + m[3][0] * _other.m[2][3];
-        r.m[3][0] = m[0][0] * _other.m[3][0] + m[1][0] * _other.m[3][1] + m[2][0] * _other.m[3][2] + m[3][0] * _other.m[3][3];
+        // MultiplySSE is not faster (BenchMatrix4): the compiler already does well here
+        MultiplyScalar(*this, _other, r);
 
-        r.m[0][1] = m[0][1] * _other.m[0][0] + m[1][1] * _other.m[0][1] + m[2][1] * _other.m[0][2] + m[3][1] * _other.m[0][3];
-        r.m[1][1] = m[0][1] * _other.m[1][0] + m[1][1] * _other.m[1][1] + m[2][1] * _other.m[1][2] + m[3][1] * _other.m[1][3];
-        r.m[2][1] = m[0][1] * _other.m[2][0] + m[1][1] * _other.m[2][1] + m[2][1] * _other.m[2][2] + m[3][1] * _other.m[2][3];
-        r.m[3][1] = m[0][1] * _other.m[3][0] + m[1][1] * _other.m[3][1] + m[2][1] * _other.m[3][2] + m[3][1] * _other.m[3][3];
+        return r;
+    }
+
+    //---------------------------------
+    // _out may alias _a or _b
+    //---------------------------------
+    inline void
+    CMatrix4::MultiplyScalar(const CMatrix4 &_a, const CMatrix4 &_b, CMatrix4 &_out) {
+        CMatrix4 r;
 
-        r.m[0][2] = m[0][2] * _other.m[0][0] + m[1][2] * _other.m[0][1] + m[2][2] * _other.m[0][2] + m[3][2] * _other.m[0][3];
-        r.m[1][2] = m[0][2] * _other.m[1][0] + m[1][2] * _other.m[1][1] + m[2][2] * _other.m[1][2] + m[3][2] * _other.m[1][3];
-        r.m[2][2] = m[0][2] * _other.m[2][0] + m[1][2] * _other.m[2][1] + m[2][2] * _other.m[2][2] + m[3][2] * _other.m[2][3];
-        r.m[3][2] = m[0][2] * _other.m[3][0] + m[1][2] * _other.m[3][1] + m[2][2] * _other.m[3][2] + m[3][2] * _other.m[3][3];
+        r.m[0][0] = _a.m[0][0] * _b.m[0][0] + _a.m[1][0] * _b.m[0][1] + _a.m[2][0] * _b.m[0][2] + _a.m[3][0] * _b.m[0][3];
+        r.m[1][0] = _a.m[0][0] * _b.m[1][0] + _a.m[1][0] * _b.m[1][1] + _a.m[2][0] * _b.m[1][2] + _a.m[3][0] * _b.m[1][3];
+        r.m[2][0] = _a.m[0][0] * _b.m[2][0] + _a.m[1][0] * _b.m[2][1] + _a.m[2][0] * _b.m[2][2] + _a.m[3][0] * _b.m[2][3];
+        r.m[3][0] = _a.m[0][0] * _b.m[3][0] + _a.m[1][0] * _b.m[3][1] + _a.m[2][0] * _b.m[3][2] + _a.m[3][0] * _b.m[3][3];
 
-        r.m[0][3] = m[0][3] * _other.m[0][0] + m[1][3] * _other.m[0][1] + m[2][3] * _other.m[0][2] + m[3][3] * _other.m[0][3];
-        r.m[1][3] = m[0][3] * _other.m[1][0] + m[1][3] * _other.m[1][1] + m[2][3] * _other.m[1][2] + m[3][3] * _other.m[1][3];
-        r.m[2][3] = m[0][3] * _other.m[2][0] + m[1][3] * _other.m[2][1] + m[2][3] * _other.m[2][2] + m[3][3] * _other.m[2][3];
-        r.m[3][3] = m[0][3] * _other.m[3][0] + m[1][3] * _other.m[3][1] + m[2][3] * _other.m[3][2] + m[3][3] * _other.m[3][3];
+        r.m[0][1] = _a.m[0][1] * _b.m[0][0] + _a.m[1][1] * _b.m[0][1] + _a.m[2][1] * _b.m[0][2] + _a.m[3][1] * _b.m[0][3];
+        r.m[1][1] = _a.m[0][1] * _b.m[1][0] + _a.m[1][1] * _b.m[1][1] + _a.m[2][1] * _b.m[1][2] + _a.m[3][1] * _b.m[1][3];
+        r.m[2][1] = _a.m[0][1] * _b.m[2][0] + _a.m[1][1] * _b.m[2][1] + _a.m[2][1] * _b.m[2][2] + _a.m[3][1] * _b.m[2][3];
+        r.m[3][1] = _a.m[0][1] * _b.m[3][0] + _a.m[1][1] * _b.m[3][1] + _a.m[2][1] * _b.m[3][2] + _a.m[3][1] * _b.m[3][3];
 
-        return r;
+        r.m[0][2] = _a.m[0][2] * _b.m[0][0] + _a.m[1][2] * _b.m[0][1] + _a.m[2][2] * _b.m[0][2] + _a.m[3][2] * _b.m[0][3];
+        r.m[1][2] = _a.m[0][2] * _b.m[1][0] + _a.m[1][2] * _b.m[1][1] + _a.m[2][2] * _b.m[1][2] + _a.m[3][2] * _b.m[1][3];
+        r.m[2][2] = _a.m[0][2] * _b.m[2][0] + _a.m[1][2] * _b.m[2][1] + _a.m[2][2] * _b.m[2][2] + _a.m[3][2] * _b.m[2][3];
+        r.m[3][2] = _a.m[0][2] * _b.m[3][0] + _a.m[1][2] * _b.m[3][1] + _a.m[2][2] * _b.m[3][2] + _a.m[3][2] * _b.m[3][3];
+
+        r.m[0][3] = _a.m[0][3] * _b.m[0][0] + _a.m[1][3] * _b.m[0][1] + _a.m[2][3] * _b.m[0][2] + _a.m[3][3] * _b.m[0][3];
+        r.m[1][3] = _a.m[0][3] * _b.m[1][0] + _a.m[1][3] * _b.m[1][1] + _a.m[2][3] * _b.m[1][2] + _a.m[3][3] * _b.m[1][3];
+        r.m[2][3] = _a.m[0][3] * _b.m[2][0] + _a.m[1][3] * _b.m[2][1] + _a.m[2][3] * _b.m[2][2] + _a.m[3][3] * _b.m[2][3];
+        r.m[3][3] = _a.m[0][3] * _b.m[3][0] + _a.m[1][3] * _b.m[3][1] + _a.m[2][3] * _b.m[3][2] + _a.m[3][3] * _b.m[3][3];
+
+        _out = r;
     }
 
+#if defined(MS_MATH_SSE)
+    //---------------------------------
+    // Column j of the result is the linear combination of the columns of _a
+    // weighted by column j of _b. Same operation order as the scalar code.
+    //---------------------------------
+    inline void
+    CMatrix4::MultiplySSE(const CMatrix4 &_a, const CMatrix4 &_b, CMatrix4 &_out) {
+        __m128  a0 = _mm_load_ps(_a.m[0]);
+        __m128  a1 = _mm_load_ps(_a.m[1]);
+        __m128  a2 = _mm_load_ps(_a.m[2]);
+        __m128  a3 = _mm_load_ps(_a.m[3]);
+        __m128  b0 = _mm_load_ps(_b.m[0]);
+        __m128  b1 = _mm_load_ps(_b.m[1]);
+        __m128  b2 = _mm_load_ps(_b.m[2]);
+        __m128  b3 = _mm_load_ps(_b.m[3]);
+
+        #define MS_COLUMN(b)    _mm_add_ps(_mm_add_ps(_mm_add_ps(                                   \
+                                    _mm_mul_ps(a0, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0))),  \
+                                    _mm_mul_ps(a1, _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 1, 1)))), \
+                                    _mm_mul_ps(a2, _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2)))), \
+                                    _mm_mul_ps(a3, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3))))
+        _mm_store_ps(_out.m[0], MS_COLUMN(b0));
+        _mm_store_ps(_out.m[1], MS_COLUMN(b1));
+        _mm_store_ps(_out.m[2], MS_COLUMN(b2));
+        _mm_store_ps(_out.m[3], MS_COLUMN(b3));
+        #undef MS_COLUMN
+    }
+#endif
+
     //---------------------------------
     inline CMatrix4
     CMatrix4::operator * (const CMatrix4 &_other) const {
         return GetConcatenated(_other);
     }
 
+    //---------------------------------
+    // Same result as the product by CMatrix4(_affine), skipping the column 3
+    // of this matrix for the 3 linear columns (their W is 0)
+    //---------------------------------
+    inline CMatrix4
+    CMatrix4::GetConcatenated(const CMatrix3x4 &_affine) const {
+        CMatrix4 r;
+
+#if defined(MS_MATH_SSE)
+        __m128  a0 = _mm_load_ps(m[0]);
+        __m128  a1 = _mm_load_ps(m[1]);
+        __m128  a2 = _mm_load_ps(m[2]);
+        __m128  a3 = _mm_load_ps(m[3]);
+        __m128  b0 = _mm_load_ps(_affine.m[0]);
+        __m128  b1 = _mm_load_ps(_affine.m[1]);
+        __m128  b2 = _mm_load_ps(_affine.m[2]);
+        __m128  b3 = _mm_setzero_ps();
+
+        _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+        #define MS_COLUMN(b)    _mm_add_ps(_mm_add_ps(                  \
+                                    _mm_mul_ps(a0, SimdSplatX(b)),      \
+                                    _mm_mul_ps(a1, SimdSplatY(b))),     \
+                                    _mm_mul_ps(a2, SimdSplatZ(b)))
+        _mm_store_ps(r.m[0], MS_COLUMN(b0));
+        _mm_store_ps(r.m[1], MS_COLUMN(b1));
+        _mm_store_ps(r.m[2], MS_COLUMN(b2));
+        _mm_store_ps(r.m[3], _mm_add_ps(MS_COLUMN(b3), a3));
+        #undef MS_COLUMN
+#else
+        MultiplyScalar(*this, CMatrix4(_affine), r);
+#endif
+
+        return r;
+    }
+
+    //---------------------------------
+    inline CMatrix4
+    CMatrix4::operator * (const CMatrix3x4 &_affine) const {
+        return GetConcatenated(_affine);
+    }
+
     //---------------------------------
     inline CVector2
     CMatrix4::operator * (const CVector2 &_vec2) const {
@@ -710,39 +885,135 @@ namespace MindShake {
     //---------------------------------
     inline CMatrix4 &
     CMatrix4::InvertAffineAux(const CMatrix4 &_in, CMatrix4 &_out) {
-        CMatrix3    mat3(_in.v[0], _in.v[1], _in.v[2],
-                         _in.v[4], _in.v[5], _in.v[6],
-                         _in.v[8], _in.v[9], _in.v[10]);
-        float x = _in.v[12];
-        float y = _in.v[13];
-        float z = _in.v[14];
-
-        mat3.Invert();
-
-        const float *r = mat3.GetPtr();
-        _out.v[0]  = r[0];
-        _out.v[1]  = r[1];
-        _out.v[2]  = r[2];
-        _out.v[3]  = 0.0f;
-
-        _out.v[4]  = r[3];
-        _out.v[5]  = r[4];
-        _out.v[6]  = r[5];
-        _out.v[7]  = 0.0f;
-
-        _out.v[8]  = r[6];
-        _out.v[9]  = r[7];
-        _out.v[10] = r[8];
-        _out.v[11] = 0.0f;
-
-        _out.v[12] = -(r[0] * x + r[3] * y + r[6] * z);
-        _out.v[13] = -(r[1] * x + r[4] * y + r[7] * z);
-        _out.v[14] = -(r[2] * x + r[5] * y + r[8] * z);
-        _out.v[15] = 1.0f;
+#if defined(MS_MATH_SSE)
+        InvertAffineSSE(_in, _out);
+#else
+        InvertAffineScalar(_in, _out);
+#endif
 
         return _out;
     }
 
+    //---------------------------------
+    // Inverse of the 3x3 by cofactors, translation = -inverse3x3 * translation.
+    // A singular 3x3 is kept as is (as CMatrix3::Invert does).
+    // _out may alias _in
+    //---------------------------------
+    inline void
+    CMatrix4::InvertAffineScalar(const CMatrix4 &_in, CMatrix4 &_out) {
+        float   r[3][3];
+        double  det, invDet;
+        float   x = _in.m[3][0];
+        float   y = _in.m[3][1];
+        float   z = _in.m[3][2];
+
+        r[0][0] = _in.m[1][1] * _in.m[2][2] - _in.m[1][2] * _in.m[2][1];
+        r[0][1] = _in.m[0][2] * _in.m[2][1] - _in.m[0][1] * _in.m[2][2];
+        r[0][2] = _in.m[0][1] * _in.m[1][2] - _in.m[0][2] * _in.m[1][1];
+        r[1][0] = _in.m[1][2] * _in.m[2][0] - _in.m[1][0] * _in.m[2][2];
+        r[1][1] = _in.m[0][0] * _in.m[2][2] - _in.m[0][2] * _in.m[2][0];
+        r[1][2] = _in.m[0][2] * _in.m[1][0] - _in.m[0][0] * _in.m[1][2];
+        r[2][0] = _in.m[1][0] * _in.m[2][1] - _in.m[1][1] * _in.m[2][0];
+        r[2][1] = _in.m[0][1] * _in.m[2][0] - _in.m[0][0] * _in.m[2][1];
+        r[2][2] = _in.m[0][0] * _in.m[1][1] - _in.m[0][1] * _in.m[1][0];
+
+        det = double(_in.m[0][0]) * r[0][0] + double(_in.m[0][1]) * r[1][0] + double(_in.m[0][2]) * r[2][0];
+        if (MindShake::IsZero(det, Float64::EPSILON)) {
+            for (size_t c = 0; c < 3; ++c) {
+                for (size_t l = 0; l < 3; ++l)
+                    r[c][l] = _in.m[c][l];
+            }
+        }
+        else {
+            invDet = 1.0 / det;
+            for (size_t c = 0; c < 3; ++c) {
+                for (size_t l = 0; l < 3; ++l)
+                    r[c][l] = float(r[c][l] * invDet);
+            }
+        }
+
+        _out.m[0][0] = r[0][0];
+        _out.m[0][1] = r[0][1];
+        _out.m[0][2] = r[0][2];
+        _out.m[0][3] = 0.0f;
+
+        _out.m[1][0] = r[1][0];
+        _out.m[1][1] = r[1][1];
+        _out.m[1][2] = r[1][2];
+        _out.m[1][3] = 0.0f;
+
+        _out.m[2][0] = r[2][0];
+        _out.m[2][1] = r[2][1];
+        _out.m[2][2] = r[2][2];
+        _out.m[2][3] = 0.0f;
+
+        _out.m[3][0] = -(r[0][0] * x + r[1][0] * y + r[2][0] * z);
+        _out.m[3][1] = -(r[0][1] * x + r[1][1] * y + r[2][1] * z);
+        _out.m[3][2] = -(r[0][2] * x + r[1][2] * y + r[2][2] * z);
+        _out.m[3][3] = 1.0f;
+    }
+
+#if defined(MS_MATH_SSE)
+    //---------------------------------
+    // For the 3x3 with columns c0, c1, c2 the rows of the inverse are
+    // (c1 x c2, c2 x c0, c0 x c1) / det. The determinant and the scale by
+    // its inverse are done in double, as InvertAffineScalar: bit exact with it
+    //---------------------------------
+    inline void
+    CMatrix4::InvertAffineSSE(const CMatrix4 &_in, CMatrix4 &_out) {
+        const __m128    maskXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+        const __m128    unitW   = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+        __m128          c0 = _mm_and_ps(_mm_load_ps(_in.m[0]), maskXYZ);
+        __m128          c1 = _mm_and_ps(_mm_load_ps(_in.m[1]), maskXYZ);
+        __m128          c2 = _mm_and_ps(_mm_load_ps(_in.m[2]), maskXYZ);
+        __m128          t  = _mm_load_ps(_in.m[3]);
+        __m128          r0, r1, r2, r3;
+        __m128d         lo, hi, invDet;
+        double          det;
+
+        #define MS_YZX(v)   _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1))
+        #define MS_ZXY(v)   _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2))
+        r0 = _mm_sub_ps(_mm_mul_ps(MS_YZX(c1), MS_ZXY(c2)), _mm_mul_ps(MS_ZXY(c1), MS_YZX(c2)));
+        r1 = _mm_sub_ps(_mm_mul_ps(MS_YZX(c2), MS_ZXY(c0)), _mm_mul_ps(MS_ZXY(c2), MS_YZX(c0)));
+        r2 = _mm_sub_ps(_mm_mul_ps(MS_YZX(c0), MS_ZXY(c1)), _mm_mul_ps(MS_ZXY(c0), MS_YZX(c1)));
+        #undef MS_YZX
+        #undef MS_ZXY
+
+        // The float products are exact in double: (x + y) + z as the scalar code
+        lo  = _mm_mul_pd(_mm_cvtps_pd(c0), _mm_cvtps_pd(r0));
+        hi  = _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(c0, c0)), _mm_cvtps_pd(_mm_movehl_ps(r0, r0)));
+        lo  = _mm_add_sd(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)), hi);
+        det = _mm_cvtsd_f64(lo);
+
+        if (MindShake::IsZero(det, Float64::EPSILON)) {
+            r0 = c0;
+            r1 = c1;
+            r2 = c2;
+        }
+        else {
+            invDet = _mm_set1_pd(1.0 / det);
+            #define MS_SCALE(v)     _mm_movelh_ps(_mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(v), invDet)),  \
+                                                  _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), invDet)))
+            r0 = MS_SCALE(r0);
+            r1 = MS_SCALE(r1);
+            r2 = MS_SCALE(r2);
+            #undef MS_SCALE
+            r3 = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        }
+
+        t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0))),
+                                  _mm_mul_ps(r1, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)))),
+                                  _mm_mul_ps(r2, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2))));
+        t = _mm_or_ps(_mm_and_ps(_mm_xor_ps(t, _mm_set1_ps(-0.0f)), maskXYZ), unitW);
+
+        _mm_store_ps(_out.m[0], r0);
+        _mm_store_ps(_out.m[1], r1);
+        _mm_store_ps(_out.m[2], r2);
+        _mm_store_ps(_out.m[3], t);
+    }
+#endif
+
     //---------------------------------
     inline CMatrix4 &
     CMatrix4::InvertAffine() {
@@ -1114,40 +1385,12 @@ namespace MindShake {
     //---------------------------------
     inline CMatrix4 &
     CMatrix4::MakeRotation(float _angleX, float _angleY, float _angleZ) {
-        float   sinX, cosX;
-        float   sinY, cosY;
-        float   sinZ, cosZ;
-
-        sinX = MindShake::SinG(_angleX);
-        cosX = MindShake::CosG(_angleX);
-
-        sinY = MindShake::SinG(_angleY);
-        cosY = MindShake::CosG(_angleY);
-
-        sinZ = MindShake::SinG(_angleZ);
-        cosZ = MindShake::CosG(_angleZ);
+        float   angles[3] = { _angleX, _angleY, _angleZ };
+        float   sines[3], cosines[3];
 
-        m[0][0] =  cosY * cosZ;
-        m[1][0] = -cosY * sinZ;
-        m[2][0] = sinY;
-        m[3][0] = 0;
+        MindShake::SinCosG(angles, sines, cosines, 3);
 
-        m[0][1] = (cosX * sinZ + sinX * sinY * cosZ);
-        m[1][1] = (cosX * cosZ - sinX * sinY * sinZ);
-        m[2][1] = -sinX * cosY;
-        m[3][1] = 0;
-
-        m[0][2] = (sinX * sinZ - cosX * sinY * cosZ);
-        m[1][2] = (sinX * cosZ + cosX * sinY * sinZ);
-        m[2][2] =  cosX * cosY;
-        m[3][2] = 0;
-
-        m[0][3] = 0;
-        m[1][3] = 0;
-        m[2][3] = 0;
-        m[3][3] = 1;
-
-        return *this;
+        return MakeTransformSinCos(0, 0, 0, 1, 1, 1, sines, cosines);
     }
 
     //---------------------------------
@@ -1408,24 +1651,39 @@ namespace MindShake {
     //---------------------------------
     inline CMatrix4 &
     CMatrix4::MakeTransform(const CVector3 &_position, const CVector3 &_scale, const CQuaternion &_orientation) {
-        CMatrix3    rot3x3, scale3x3;
-
-        _orientation.ToRotationMatrix(rot3x3);
-
-        scale3x3[0][0] = _scale.x;
-        scale3x3[0][1] = 0.0f;
-        scale3x3[0][2] = 0.0f;
+        // Rotation matrix of the (unit) quaternion, columns scaled: no trig
+        float   tx  = 2.0f * _orientation.x;
+        float   ty  = 2.0f * _orientation.y;
+        float   tz  = 2.0f * _orientation.z;
+        float   twx = tx * _orientation.w;
+        float   twy = ty * _orientation.w;
+        float   twz = tz * _orientation.w;
+        float   txx = tx * _orientation.x;
+        float   txy = ty * _orientation.x;
+        float   txz = tz * _orientation.x;
+        float   tyy = ty * _orientation.y;
+        float   tyz = tz * _orientation.y;
+        float   tzz = tz * _orientation.z;
+
+        m[0][0] = (1.0f - (tyy + tzz)) * _scale.x;
+        m[0][1] = (txy + twz) * _scale.x;
+        m[0][2] = (txz - twy) * _scale.x;
+        m[0][3] = 0.0f;
 
-        scale3x3[1][0] = 0.0f;
-        scale3x3[1][1] = _scale.y;
-        scale3x3[1][2] = 0.0f;
+        m[1][0] = (txy - twz) * _scale.y;
+        m[1][1] = (1.0f - (txx + tzz)) * _scale.y;
+        m[1][2] = (tyz + twx) * _scale.y;
+        m[1][3] = 0.0f;
 
-        scale3x3[2][0] = 0.0f;
-        scale3x3[2][1] = 0.0f;
-        scale3x3[2][2] = _scale.z;
+        m[2][0] = (txz + twy) * _scale.z;
+        m[2][1] = (tyz - twx) * _scale.z;
+        m[2][2] = (1.0f - (txx + tyy)) * _scale.z;
+        m[2][3] = 0.0f;
 
-        *this = rot3x3 * scale3x3;
-        this->SetTranslation(_position);
+        m[3][0] = _position.x;
+        m[3][1] = _position.y;
+        m[3][2] = _position.z;
+        m[3][3] = 1.0f;
 
         return *this;
     }
@@ -1441,18 +1699,22 @@ namespace MindShake {
     CMatrix4::MakeTransform(float _posX,   float _posY,   float _posZ,
                             float _scaleX, float _scaleY, float _scaleZ,
                             float _angleX, float _angleY, float _angleZ) {
-        float   sinX, cosX;
-        float   sinY, cosY;
-        float   sinZ, cosZ;
+        float   angles[3] = { _angleX, _angleY, _angleZ };
+        float   sines[3], cosines[3];
 
-        sinX = MindShake::SinG(_angleX);
-        cosX = MindShake::CosG(_angleX);
+        MindShake::SinCosG(angles, sines, cosines, 3);
 
-        sinY = MindShake::SinG(_angleY);
-        cosY = MindShake::CosG(_angleY);
+        return MakeTransformSinCos(_posX, _posY, _posZ, _scaleX, _scaleY, _scaleZ, sines, cosines);
+    }
 
-        sinZ = MindShake::SinG(_angleZ);
-        cosZ = MindShake::CosG(_angleZ);
+    //---------------------------------
+    inline CMatrix4 &
+    CMatrix4::MakeTransformSinCos(float _posX,   float _posY,   float _posZ,
+                                  float _scaleX, float _scaleY, float _scaleZ,
+                                  const float _sin[3], const float _cos[3]) {
+        float   sinX = _sin[0], cosX = _cos[0];
+        float   sinY = _sin[1], cosY = _cos[1];
+        float   sinZ = _sin[2], cosZ = _cos[2];
 
 //      m[0][0] = (cosY * cosZ) * _scaleX;
 //      m[0][1] = (cosY * -sinZ) * _scaleY;
@@ -1717,6 +1979,20 @@ namespace MindShake {
     //---------------------------------
     inline CMatrix4 &
     CMatrix4::InvertAux(const CMatrix4 &_in, CMatrix4 &_out) {
+#if defined(MS_MATH_SSE)
+        InvertSSE(_in, _out);
+#else
+        InvertScalar(_in, _out);
+#endif
+
+        return _out;
+    }
+
+    //---------------------------------
+    // _out may alias _in
+    //---------------------------------
+    inline void
+    CMatrix4::InvertScalar(const CMatrix4 &_in, CMatrix4 &_out) {
         double  m00, m01, m02, m03;
         double  m10, m11, m12, m13;
         double  m20, m21, m22, m23;
@@ -1816,10 +2092,81 @@ namespace MindShake {
         _out.m[3][1] = float(r31);
         _out.m[3][2] = float(r32);
         _out.m[3][3] = float(r33);
-
-        return _out;
     }
 
+#if defined(MS_MATH_SSE)
+    //---------------------------------
+    // 2x2 block inversion. Each __m128 holds a 2x2 block (a b c d, row by row):
+    //   M = | A B |   inverse = 1/|M| * | |D|A - B(D#C)   ... |
+    //       | C D |                     |     ...             |
+    // where X# is the adjugate of X. Loading columns as rows inverts the transpose,
+    // so the result is stored as columns too. Single precision.
+    //---------------------------------
+    inline void
+    CMatrix4::InvertSSE(const CMatrix4 &_in, CMatrix4 &_out) {
+        #define MS_SHUFFLE(v1, v2, x, y, z, w)      _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(w, z, y, x))
+
+        // 2x2 A * B, A# * B and A * B#
+        auto mat2Mul    = [](__m128 a, __m128 b) {
+            return _mm_add_ps(_mm_mul_ps(a, MS_SWIZZLE(b, 0, 3, 0, 3)), _mm_mul_ps(MS_SWIZZLE(a, 1, 0, 3, 2), MS_SWIZZLE(b, 2, 1, 2, 1)));
+        };
+        auto mat2AdjMul = [](__m128 a, __m128 b) {
+            return _mm_sub_ps(_mm_mul_ps(MS_SWIZZLE(a, 3, 3, 0, 0), b), _mm_mul_ps(MS_SWIZZLE(a, 1, 1, 2, 2), MS_SWIZZLE(b, 2, 3, 0, 1)));
+        };
+        auto mat2MulAdj = [](__m128 a, __m128 b) {
+            return _mm_sub_ps(_mm_mul_ps(a, MS_SWIZZLE(b, 3, 0, 3, 0)), _mm_mul_ps(MS_SWIZZLE(a, 1, 0, 3, 2), MS_SWIZZLE(b, 2, 1, 2, 1)));
+        };
+
+        __m128  c0 = _mm_load_ps(_in.m[0]);
+        __m128  c1 = _mm_load_ps(_in.m[1]);
+        __m128  c2 = _mm_load_ps(_in.m[2]);
+        __m128  c3 = _mm_load_ps(_in.m[3]);
+
+        __m128  A = _mm_movelh_ps(c0, c1);
+        __m128  B = _mm_movehl_ps(c1, c0);
+        __m128  C = _mm_movelh_ps(c2, c3);
+        __m128  D = _mm_movehl_ps(c3, c2);
+
+        // (|A| |B| |C| |D|)
+        __m128  detSub = _mm_sub_ps(_mm_mul_ps(MS_SHUFFLE(c0, c2, 0, 2, 0, 2), MS_SHUFFLE(c1, c3, 1, 3, 1, 3)),
+                                    _mm_mul_ps(MS_SHUFFLE(c0, c2, 1, 3, 1, 3), MS_SHUFFLE(c1, c3, 0, 2, 0, 2)));
+        __m128  detA = MS_SWIZZLE(detSub, 0, 0, 0, 0);
+        __m128  detB = MS_SWIZZLE(detSub, 1, 1, 1, 1);
+        __m128  detC = MS_SWIZZLE(detSub, 2, 2, 2, 2);
+        __m128  detD = MS_SWIZZLE(detSub, 3, 3, 3, 3);
+
+        __m128  D_C = mat2AdjMul(D, C);
+        __m128  A_B = mat2AdjMul(A, B);
+        __m128  X_  = _mm_sub_ps(_mm_mul_ps(detD, A), mat2Mul(B, D_C));
+        __m128  W_  = _mm_sub_ps(_mm_mul_ps(detA, D), mat2Mul(C, A_B));
+        __m128  Y_  = _mm_sub_ps(_mm_mul_ps(detB, C), mat2MulAdj(D, A_B));
+        __m128  Z_  = _mm_sub_ps(_mm_mul_ps(detC, B), mat2MulAdj(A, D_C));
+
+        // |M| = |A| |D| + |B| |C| - tr((A#B)(D#C))
+        __m128  detM = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+        __m128  tr   = _mm_mul_ps(A_B, MS_SWIZZLE(D_C, 0, 2, 1, 3));
+        tr   = _mm_add_ps(tr, _mm_movehl_ps(tr, tr));
+        tr   = _mm_add_ps(tr, MS_SWIZZLE(tr, 1, 0, 1, 0));
+        tr   = MS_SWIZZLE(tr, 0, 0, 0, 0);
+        detM = _mm_sub_ps(detM, tr);
+
+        // (1/|M|, -1/|M|, -1/|M|, 1/|M|)
+        __m128  rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+        X_ = _mm_mul_ps(X_, rDetM);
+        Y_ = _mm_mul_ps(Y_, rDetM);
+        Z_ = _mm_mul_ps(Z_, rDetM);
+        W_ = _mm_mul_ps(W_, rDetM);
+
+        // Adjugate of each block and store
+        _mm_store_ps(_out.m[0], MS_SHUFFLE(X_, Y_, 3, 1, 3, 1));
+        _mm_store_ps(_out.m[1], MS_SHUFFLE(X_, Y_, 2, 0, 2, 0));
+        _mm_store_ps(_out.m[2], MS_SHUFFLE(Z_, W_, 3, 1, 3, 1));
+        _mm_store_ps(_out.m[3], MS_SHUFFLE(Z_, W_, 2, 0, 2, 0));
+
+        #undef MS_SHUFFLE
+    }
+#endif
+
     //---------------------------------
     inline CMatrix4 &
     CMatrix4::Invert() {
@@ -1847,17 +2194,18 @@ namespace MindShake {
     //---------------------------------
     // Build Transform
     //---------------------------------
-    inline CMatrix4
+    inline constexpr CMatrix4
     CMatrix4::BuildTranslationMatrix(const CVector3 &_vec3) {
-        CMatrix4 r;
-        return r.MakeTranslation(_vec3);
+        return BuildTranslationMatrix(_vec3.x, _vec3.y, _vec3.z);
     }
 
     //---------------------------------
-    inline CMatrix4
+    inline constexpr CMatrix4
     CMatrix4::BuildTranslationMatrix(float _tx, float _ty, float _tz) {
-        CMatrix4 r;
-        return r.MakeTranslation(_tx, _ty, _tz);
+        return CMatrix4(1.0f, 0.0f, 0.0f, 0.0f,
+                        0.0f, 1.0f, 0.0f, 0.0f,
+                        0.0f, 0.0f, 1.0f, 0.0f,
+                        _tx,  _ty,  _tz,  1.0f);
     }
 
     //---------------------------------
@@ -1901,23 +2249,24 @@ namespace MindShake {
     }
 
     //---------------------------------
-    inline CMatrix4
+    inline constexpr CMatrix4
     CMatrix4::BuildScaleMatrix(const CVector3 &_vec3) {
-        CMatrix4 r;
-        return r.MakeScale(_vec3);
+        return BuildScaleMatrix(_vec3.x, _vec3.y, _vec3.z);
     }
 
     //---------------------------------
-    inline CMatrix4
+    inline constexpr CMatrix4
     CMatrix4::BuildScaleMatrix(float _sx, float _sy, float _sz) {
-        CMatrix4 r;
-        return r.MakeScale(_sx, _sy, _sz);
+        return CMatrix4(_sx,  0.0f, 0.0f, 0.0f,
+                        0.0f, _sy,  0.0f, 0.0f,
+                        0.0f, 0.0f, _sz,  0.0f,
+                        0.0f, 0.0f, 0.0f, 1.0f);
     }
 
     //---------------------------------
 
     //---------------------------------
-    inline CMatrix4
+    inline constexpr CMatrix4
     CMatrix4::Ortho(float _left, float _right, float _bottom, float _top, float _zNear, float _zFar) {
         float width  = _right - _left;
         float height = _top - _bottom;
@@ -1960,16 +2309,14 @@ namespace MindShake {
     }
 
     //---------------------------------
-    inline CMatrix4
+    inline constexpr CMatrix4
     CMatrix4::Frustum(float _left, float _right, float _bottom, float _top, float _zNear, float _zFar) {
-        float   x, y, a, b, c, d;
-
-        x =  (2.0f * _zNear)     / (_right - _left);
-        y =  (2.0f * _zNear)     / (_top   - _bottom);
-        a =  (_right + _left)    / (_right - _left);
-        b =  (_top   + _bottom)  / (_top   - _bottom);
-        c = -(_zFar  + _zNear)   / (_zFar  - _zNear);
-        d = -(2.0f * _zFar * _zNear) / (_zFar - _zNear);
+        float   x =  (2.0f * _zNear)     / (_right - _left);
+        float   y =  (2.0f * _zNear)     / (_top   - _bottom);
+        float   a =  (_right + _left)    / (_right - _left);
+        float   b =  (_top   + _bottom)  / (_top   - _bottom);
+        float   c = -(_zFar  + _zNear)   / (_zFar  - _zNear);
+        float   d = -(2.0f * _zFar * _zNear) / (_zFar - _zNear);
 
         return CMatrix4(
                    x,  0.0f,   0.0f,  0.0f,
@@ -2057,18 +2404,15 @@ namespace MindShake {
     }
 
     //---------------------------------
-    inline CMatrix4
+    inline constexpr CMatrix4
     CMatrix4::Viewport(float _left, float _right, float _top, float _bottom, float _near, float _far) {
-        float   halfWidth, halfHeight, halfDepth;
-        float   tx, ty, tz;
+        float   halfWidth  = (_right  - _left) * 0.5f;
+        float   halfHeight = (_bottom - _top)  * 0.5f;
+        float   halfDepth  = (_far    - _near) * 0.5f;
 
-        halfWidth  = (_right  - _left) * 0.5f;
-        halfHeight = (_bottom - _top)  * 0.5f;
-        halfDepth  = (_far    - _near) * 0.5f;
-
-        tx = _left + halfWidth;
-        ty = _top  + halfHeight;
-        tz = (_far + _near) * 0.5f;
+        float   tx = _left + halfWidth;
+        float   ty = _top  + halfHeight;
+        float   tz = (_far + _near) * 0.5f;
 
         return CMatrix4(
             halfWidth,           0,         0, 0,
@@ -2079,7 +2423,7 @@ namespace MindShake {
     }
 
     //---------------------------------
-    inline CMatrix4
+    inline constexpr CMatrix4
     CMatrix4::Viewport(float _left, float _right, float _top, float _bottom) {
         return Viewport(_left, _right, _top, _bottom, 0, 1);
     }
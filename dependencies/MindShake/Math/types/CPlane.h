@@ -0,0 +1,71 @@
+#pragma once
+
+//-------------------------------------
+#include <Math/types/CVector3.h>
+#include <Math/types/CAABB.h>
+//-------------------------------------
+
+//-------------------------------------
+namespace MindShake
+{
+
+    //---------------------------------
+    // Plane: dot(normal, p) + d = 0
+    // Positive distances are on the side the normal points to.
+    //---------------------------------
+    class CPlane
+    {
+        public:
+                            CPlane()                                            = default;
+                            CPlane(const CVector3 &_normal, float _d)           : normal(_normal), d(_d) { }
+                            CPlane(float _a, float _b, float _c, float _d)      : normal(_a, _b, _c), d(_d) { }
+
+            void            Set(float _a, float _b, float _c, float _d)         { normal.Set(_a, _b, _c); d = _d; }
+
+            // Returns false (and leaves the plane untouched) if the normal is degenerated
+            bool            Normalize();
+
+            float           GetDistance(const CVector3 &_point) const           { return normal.DotProduct(_point) + d; }
+
+            // Distance of the box corner furthest along the normal. < 0 means the box is fully behind
+            float           GetMaxDistance(const CAABB &_box) const;
+            // Distance of the nearest corner. >= 0 means the box is fully in front
+            float           GetMinDistance(const CAABB &_box) const;
+
+        public:
+            CVector3    normal  { 0.0f, 0.0f, 1.0f };
+            float       d       { 0.0f };
+    };
+
+    //---------------------------------
+    inline bool
+    CPlane::Normalize() {
+        float length = normal.GetLength();
+
+        if (length <= Float32::EPSILON)
+            return false;
+
+        float invLength = 1.0f / length;
+        normal *= invLength;
+        d      *= invLength;
+
+        return true;
+    }
+
+    //---------------------------------
+    inline float
+    CPlane::GetMaxDistance(const CAABB &_box) const {
+        return normal.x * ((normal.x >= 0.0f) ? _box.max.x : _box.min.x) +
+               normal.y * ((normal.y >= 0.0f) ? _box.max.y : _box.min.y) +
+               normal.z * ((normal.z >= 0.0f) ? _box.max.z : _box.min.z) + d;
+    }
+
+    //---------------------------------
+    inline float
+    CPlane::GetMinDistance(const CAABB &_box) const {
+        return normal.x * ((normal.x >= 0.0f) ? _box.min.x : _box.max.x) +
+               normal.y * ((normal.y >= 0.0f) ? _box.min.y : _box.max.y) +
+               normal.z * ((normal.z >= 0.0f) ? _box.min.z : _box.max.z) + d;
+    }
+
+} // end of namespace
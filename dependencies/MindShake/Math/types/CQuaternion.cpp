@@ -13,11 +13,6 @@
 namespace MindShake
 {
 
-    //---------------------------------
-    const CQuaternion CQuaternion::kZERO(0.0f, 0.0f, 0.0f, 0.0f);
-    const CQuaternion CQuaternion::kIDENTITY(1.0f, 0.0f, 0.0f, 0.0f);
-    //---------------------------------
-
     //---------------------------------
     bool
     CQuaternion::IsEqual(const CQuaternion &_other, float _t) const
@@ -311,55 +306,6 @@ namespace MindShake
 
     //---------------------------------
 
-    // NOTE:  Multiplication is not generally commutative, so in most
-    // cases p*q != q*p.
-    //---------------------------------
-    CQuaternion
-    CQuaternion::operator * (const CQuaternion &_other) const
-    {
-        return CQuaternion
-       (
-            w * _other.w - x * _other.x - y * _other.y - z * _other.z,
-            w * _other.x + x * _other.w + y * _other.z - z * _other.y,
-            w * _other.y + y * _other.w + z * _other.x - x * _other.z,
-            w * _other.z + z * _other.w + x * _other.y - y * _other.x
-       );
-    }
-
-    // nVidia SDK implementation
-    //---------------------------------
-    CVector3
-    CQuaternion::operator * (const CVector3 &_vec3) const
-    {
-        CVector3    uv, uuv;
-        CVector3    qvec(x, y, z);
-
-        uv  = qvec.CrossProduct(_vec3);
-        uuv = qvec.CrossProduct(uv);
-
-        uv  *= 2.0f * w;
-        uuv *= 2.0f;
-
-        return _vec3 + uv + uuv;
-
-    }
-
-    //---------------------------------
-
-    //---------------------------------
-    float
-    CQuaternion::GetLength() const
-    {
-        return MindShake::Sqrt(w*w + x*x + y*y + z*z);
-    }
-
-    //---------------------------------
-    float
-    CQuaternion::GetInverseLength() const
-    {
-        return MindShake::InvSqrt(w*w + x*x + y*y + z*z);
-    }
-
     //---------------------------------
     float
     CQuaternion::GetFastInverseLength() const
@@ -389,14 +335,6 @@ namespace MindShake
         }
     }
 
-    //---------------------------------
-    CQuaternion
-    CQuaternion::UnitInverse() const
-    {
-        // assert:  'this' is unit length
-        return CQuaternion(w, -x, -y, -z);
-    }
-
     //---------------------------------
 
     // If q = A*(x*i+y*j+z*k) Where(x, y, z) is unit length, then
@@ -590,21 +528,6 @@ namespace MindShake
         return Slerp(slerpT, slerpP , slerpQ);
     }
 
-    //---------------------------------
-    float
-    CQuaternion::Normalize()
-    {
-        float len;
-        float invLen;
-
-        len = GetLength();
-        invLen = 1.0f / len;
-
-        *this = *this * invLen;
-
-        return len;
-    }
-
     //---------------------------------
 
     // roll = atan2(localx.y, localx.x)
@@ -722,6 +645,47 @@ namespace MindShake
         _angles.x = MindShake::ATan2(siny_cosp, cosy_cosp) * Float32::RADTODEG;
     }
 
+    //---------------------------------
+    CQuaternion &
+    CQuaternion::FromEulerAnglesXYZ(const CVector3 &_angles)
+    {
+        return FromEulerAnglesXYZ(_angles.x, _angles.y, _angles.z);
+    }
+
+    //---------------------------------
+    // qX * qY * qZ expanded
+    //---------------------------------
+    CQuaternion &
+    CQuaternion::FromEulerAnglesXYZ(float _angleX, float _angleY, float _angleZ)
+    {
+        float   angles[3] = { _angleX * 0.5f, _angleY * 0.5f, _angleZ * 0.5f };
+        float   sines[3], cosines[3];
+
+        MindShake::SinCosG(angles, sines, cosines, 3);
+
+        float sinX = sines[0], cosX = cosines[0];
+        float sinY = sines[1], cosY = cosines[1];
+        float sinZ = sines[2], cosZ = cosines[2];
+
+        w = cosX * cosY * cosZ - sinX * sinY * sinZ;
+        x = sinX * cosY * cosZ + cosX * sinY * sinZ;
+        y = cosX * sinY * cosZ - sinX * cosY * sinZ;
+        z = cosX * cosY * sinZ + sinX * sinY * cosZ;
+
+        return *this;
+    }
+
+    //---------------------------------
+    void
+    CQuaternion::ToEulerAnglesXYZ(CVector3 &_angles) const
+    {
+        CMatrix3    rot;
+
+        ToRotationMatrix(rot);
+        rot.ToEulerAnglesXYZ(_angles.x, _angles.y, _angles.z);
+        _angles *= Float32::RADTODEG;
+    }
+
     //---------------------------------
 
     //---------------------------------
@@ -754,12 +718,4 @@ namespace MindShake
 
     //---------------------------------
 
-    //---------------------------------
-    CQuaternion
-    operator * (float _value, const CQuaternion &_quat)
-    {
-        return CQuaternion(_value * _quat.w, _value * _quat.x, _value * _quat.y, _value * _quat.z);
-    }
-
 } // end of namespace
-
@@ -2,6 +2,9 @@
 
 //-------------------------------------
 #include <Common/Math/constants.h>
+#include <Common/Math/simd_funcs.h>
+#include <Common/Math/math_funcs.h>
+#include <Math/types/CVector3.h>
 //-------------------------------------
 #include <cstddef>
 #include <cassert>
@@ -14,7 +17,6 @@ namespace MindShake
 
     //---------------------------------
     class CMatrix3;
-    class CVector3;
     //---------------------------------
 
     //---------------------------------
@@ -27,17 +29,22 @@ namespace MindShake
                             CQuaternion(const CQuaternion &_other)              = default;
                             ~CQuaternion()                                      = default;
 
-                            CQuaternion(float _w = 1.0f, float _x = 0.0f, float _y = 0.0f, float _z = 0.0f) : w(_w), x(_x), y(_y), z(_z) { }
+                  constexpr CQuaternion(float _w = 1.0f, float _x = 0.0f, float _y = 0.0f, float _z = 0.0f) : w(_w), x(_x), y(_y), z(_z) { }
                             CQuaternion(const CMatrix3 &_rot)                                                   { this->FromRotationMatrix(_rot);       }
                             CQuaternion(float _angle, const CVector3 &_axis)                                    { this->FromAngleAxis(_angle, _axis);   }
                             CQuaternion(const CVector3 &_xAxis, const CVector3 &_yAxis, const CVector3 &_zAxis) { this->FromAxes(_xAxis, _yAxis, _zAxis); }
                             CQuaternion(const CVector3 *_pAxis)                                                 { this->FromAxes(_pAxis); }
                             CQuaternion(float *_pV)                                                             { w = _pV[0]; x = _pV[1]; y = _pV[2]; z = _pV[3]; }
+#if defined(MS_MATH_SSE)
+            explicit        CQuaternion(__m128 _v)                                                              { simd = _v; }
+
+            __m128          GetSIMD() const                                     { return simd; }
+#endif
 
             CQuaternion &   operator = (const CQuaternion &_other)              = default;
 
-            bool            operator == (const CQuaternion &_other) const       { return (_other.x == x) && (_other.y == y) && (_other.z == z) && (_other.w == w); }
-            bool            operator != (const CQuaternion &_other) const       { return (_other.x != x) || (_other.y != y) || (_other.z != z) || (_other.w != w); }
+            constexpr bool  operator == (const CQuaternion &_other) const       { return (_other.x == x) && (_other.y == y) && (_other.z == z) && (_other.w == w); }
+            constexpr bool  operator != (const CQuaternion &_other) const       { return (_other.x != x) || (_other.y != y) || (_other.z != z) || (_other.w != w); }
 
             // Do not compare the components, compare if the quaternion is similar enough
             bool            IsEqual   (const CQuaternion &_other, float _tolerance=Float32::EPSILON) const;
@@ -51,6 +58,17 @@ namespace MindShake
 
             void            Swap(CQuaternion &_rOther);
 
+#if defined(MS_MATH_SSE)
+            CQuaternion     operator + (const CQuaternion &_other) const        { return CQuaternion(_mm_add_ps(simd, _other.simd)); }
+
+            CQuaternion     operator - (const CQuaternion &_other) const        { return CQuaternion(_mm_sub_ps(simd, _other.simd)); }
+
+            CQuaternion     operator * (const CQuaternion &_other) const;
+            CVector3        operator * (const CVector3 &_vec3) const;           // rotation of a vector by a quaternion
+            CQuaternion     operator * (float _value) const                     { return CQuaternion(_mm_mul_ps(_mm_set1_ps(_value), simd)); }
+
+            CQuaternion     operator - () const                                 { return CQuaternion(_mm_xor_ps(simd, _mm_set1_ps(-0.0f))); }
+#else
             CQuaternion     operator + (const CQuaternion &_other) const        { return CQuaternion(w+_other.w, x+_other.x, y+_other.y, z+_other.z); }
 
             CQuaternion     operator - (const CQuaternion &_other) const        { return CQuaternion(w-_other.w, x-_other.x, y-_other.y, z-_other.z); }
@@ -60,6 +78,7 @@ namespace MindShake
             CQuaternion     operator * (float _value) const                     { return CQuaternion(_value * w, _value * x, _value * y, _value * z); }
 
             CQuaternion     operator - () const                                 { return CQuaternion(-w, -x, -y, -z); }
+#endif
 
             CVector3        XAxis() const;
             CVector3        YAxis() const;
@@ -73,6 +92,11 @@ namespace MindShake
             CQuaternion &   FromEulerAngles(float _roll, float _pitch, float _yaw); // roll (X), pitch (Y), yaw (Z)
             void            ToEulerAngles(CVector3 &_angles) const;
 
+            // Degrees. Same rotation as CMatrix4::MakeRotation(x, y, z)
+            CQuaternion &   FromEulerAnglesXYZ(const CVector3 &_angles);
+            CQuaternion &   FromEulerAnglesXYZ(float _angleX, float _angleY, float _angleZ);
+            void            ToEulerAnglesXYZ(CVector3 &_angles) const;
+
             CQuaternion &   FromRotationMatrix(const CMatrix3 &_rRot);
             void            ToRotationMatrix(CMatrix3 &_rRot) const;
 
@@ -85,11 +109,15 @@ namespace MindShake
             void            ToAxes(CVector3 * _pAxis) const;
             void            ToAxes(CVector3 & xAxis, CVector3 & yAxis, CVector3 & zAxis) const;
 
+#if defined(MS_MATH_SSE)
+            float           DotProduct(const CQuaternion &_other) const         { return _mm_cvtss_f32(SimdDot4(simd, _other.simd)); }
+#else
             float           DotProduct(const CQuaternion &_other) const         { return w*_other.w + x*_other.x + y*_other.y + z*_other.z; }
+#endif
 
-            float           GetLength() const;
-            float           GetSquaredLength() const                            { return w*w + x*x + y*y + z*z; }
-            float           GetInverseLength() const;
+            float           GetLength() const                                   { return MindShake::Sqrt(GetSquaredLength());    }
+            float           GetSquaredLength() const                            { return DotProduct(*this); }
+            float           GetInverseLength() const                            { return MindShake::InvSqrt(GetSquaredLength()); }
             float           GetFastInverseLength() const;
 
             float           Normalize(void);
@@ -126,7 +154,108 @@ namespace MindShake
             static const CQuaternion kIDENTITY;
 
         public:
-            float w, x, y, z;
+            union {
+                struct {
+                    float w, x, y, z;
+                };
+#if defined(MS_MATH_SSE)
+                __m128  simd;
+#endif
+            };
     };
 
+    //---------------------------------
+    inline constexpr CQuaternion CQuaternion::kZERO(0.0f, 0.0f, 0.0f, 0.0f);
+    inline constexpr CQuaternion CQuaternion::kIDENTITY(1.0f, 0.0f, 0.0f, 0.0f);
+
+    //---------------------------------
+    inline CQuaternion
+    operator * (float _value, const CQuaternion &_quat) {
+        return _quat * _value;
+    }
+
+    // NOTE:  Multiplication is not generally commutative, so in most
+    // cases p*q != q*p.
+    //---------------------------------
+    inline CQuaternion
+    CQuaternion::operator * (const CQuaternion &_other) const {
+#if defined(MS_MATH_SSE)
+        // Same products and order of the additions as the scalar code:
+        // ((w*o + {x,x,y,z}*{ox,ow,ow,ow}) + {y,y,z,x}*{oy,oz,ox,oy}) - {z,z,x,y}*{oz,oy,oz,ox}
+        // where the first two terms of w are subtracted
+        const __m128 sign = _mm_setr_ps(-0.0f, 0.0f, 0.0f, 0.0f);
+        __m128 a = simd;
+        __m128 b = _other.simd;
+        __m128 r;
+
+        r = _mm_mul_ps(SimdSplatX(a), b);
+        r = _mm_add_ps(r, _mm_xor_ps(_mm_mul_ps(MS_SWIZZLE(a, 1, 1, 2, 3), MS_SWIZZLE(b, 1, 0, 0, 0)), sign));
+        r = _mm_add_ps(r, _mm_xor_ps(_mm_mul_ps(MS_SWIZZLE(a, 2, 2, 3, 1), MS_SWIZZLE(b, 2, 3, 1, 2)), sign));
+        r = _mm_sub_ps(r, _mm_mul_ps(MS_SWIZZLE(a, 3, 3, 1, 2), MS_SWIZZLE(b, 3, 2, 3, 1)));
+
+        return CQuaternion(r);
+#else
+        return CQuaternion
+       (
+            w * _other.w - x * _other.x - y * _other.y - z * _other.z,
+            w * _other.x + x * _other.w + y * _other.z - z * _other.y,
+            w * _other.y + y * _other.w + z * _other.x - x * _other.z,
+            w * _other.z + z * _other.w + x * _other.y - y * _other.x
+       );
+#endif
+    }
+
+    // nVidia SDK implementation
+    //---------------------------------
+    inline CVector3
+    CQuaternion::operator * (const CVector3 &_vec3) const {
+#if defined(MS_MATH_SSE)
+        alignas(16) float out[4];
+        __m128 v    = _mm_setr_ps(_vec3.x, _vec3.y, _vec3.z, 0.0f);
+        __m128 qvec = MS_SWIZZLE(simd, 1, 2, 3, 0);
+        __m128 uv, uuv;
+
+        uv  = SimdCross3(qvec, v);
+        uuv = SimdCross3(qvec, uv);
+
+        uv  = _mm_mul_ps(uv,  _mm_set1_ps(2.0f * w));
+        uuv = _mm_mul_ps(uuv, _mm_set1_ps(2.0f));
+
+        _mm_store_ps(out, _mm_add_ps(_mm_add_ps(v, uv), uuv));
+        return CVector3(out[0], out[1], out[2]);
+#else
+        CVector3    uv, uuv;
+        CVector3    qvec(x, y, z);
+
+        uv  = qvec.CrossProduct(_vec3);
+        uuv = qvec.CrossProduct(uv);
+
+        uv  *= 2.0f * w;
+        uuv *= 2.0f;
+
+        return _vec3 + uv + uuv;
+#endif
+    }
+
+    //---------------------------------
+    inline float
+    CQuaternion::Normalize() {
+        float len = GetLength();
+
+        *this = *this * (1.0f / len);
+
+        return len;
+    }
+
+    //---------------------------------
+    inline CQuaternion
+    CQuaternion::UnitInverse() const {
+        // assert:  'this' is unit length
+#if defined(MS_MATH_SSE)
+        return CQuaternion(_mm_xor_ps(simd, _mm_setr_ps(0.0f, -0.0f, -0.0f, -0.0f)));
+#else
+        return CQuaternion(w, -x, -y, -z);
+#endif
+    }
+
 } // end of namespace
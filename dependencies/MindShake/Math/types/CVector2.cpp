@@ -12,15 +12,6 @@
 namespace MindShake 
 {
 
-    //---------------------------------
-    const CVector2  CVector2::kZERO(0.0f);
-    const CVector2  CVector2::kONE(1.0f);
-    const CVector2  CVector2::kUNIT_X(1, 0);
-    const CVector2  CVector2::kUNIT_Y(0, 1);
-    const CVector2  CVector2::kNEGATIVE_UNIT_X(-1, 0);
-    const CVector2  CVector2::kNEGATIVE_UNIT_Y( 0, -1);
-    //---------------------------------
-
     //---------------------------------
     void
     CVector2::Swap(CVector2 &_other)
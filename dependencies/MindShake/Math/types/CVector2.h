@@ -20,8 +20,8 @@ namespace MindShake
                             CVector2(const CVector2 &_other)                    = default;
                             ~CVector2()                                         = default;
 
-            explicit        CVector2(float _v)                                  { x = _v; y = _v; }
-                            CVector2(float _x, float _y)                        { x = _x; y = _y; }
+            explicit constexpr CVector2(float _v)                               : x(_v), y(_v) { }
+                  constexpr CVector2(float _x, float _y)                        : x(_x), y(_y) { }
 
             template <typename T>
             explicit        CVector2(const T *_ptr)                             { assert(_ptr != nullptr); x = float(_ptr[0]), y = float(_ptr[1]); }
@@ -42,17 +42,17 @@ namespace MindShake
 
             void            Swap(CVector2 &_other);
 
-            bool            operator == (const CVector2 &_other) const          { return ((x == _other.x) && (y == _other.y)); }
-            bool            operator != (const CVector2 &_other) const          { return ((x != _other.x) || (y != _other.y)); }
+            constexpr bool  operator == (const CVector2 &_other) const          { return ((x == _other.x) && (y == _other.y)); }
+            constexpr bool  operator != (const CVector2 &_other) const          { return ((x != _other.x) || (y != _other.y)); }
 
             bool            IsEqual   (const CVector2 &_other, float _tolerance = Float32::EPSILON) const;
             bool            IsNotEqual(const CVector2 &_other, float _tolerance = Float32::EPSILON) const;
 
-            bool            operator < (const CVector2 &_other) const           { return (x < _other.x) && (y < _other.y); }
-            bool            operator > (const CVector2 &_other) const           { return (x > _other.x) && (y > _other.y); }
+            constexpr bool  operator < (const CVector2 &_other) const           { return (x < _other.x) && (y < _other.y); }
+            constexpr bool  operator > (const CVector2 &_other) const           { return (x > _other.x) && (y > _other.y); }
 
             const CVector2 &operator + () const                                 { return *this; }
-            CVector2        operator - () const                                 { return CVector2(-x, -y); }
+            constexpr CVector2 operator - () const                              { return CVector2(-x, -y); }
 
             void            operator += (float _v)                              { x += _v;       y += _v;       }
             void            operator += (const CVector2 &_other)                { x += _other.x; y += _other.y; }
@@ -63,15 +63,15 @@ namespace MindShake
             void            operator /= (float _v);
             void            operator /= (const CVector2 &_other);
 
-            float           DotProduct(const CVector2 &_other) const            { return x * _other.x + y * _other.y; }
+            constexpr float DotProduct(const CVector2 &_other) const            { return x * _other.x + y * _other.y; }
             float           AbsDotProduct(const CVector2 &_other) const;
-            float           PerpendicularDotProduct (const CVector2 &_other) const  { return x * _other.y - y * _other.x; } // Left Handed
-            float           PerpendicularDotProductR(const CVector2 &_other) const  { return y * _other.x - x * _other.y; } // Right Handed
+            constexpr float PerpendicularDotProduct (const CVector2 &_other) const  { return x * _other.y - y * _other.x; } // Left Handed
+            constexpr float PerpendicularDotProductR(const CVector2 &_other) const  { return y * _other.x - x * _other.y; } // Right Handed
 
             float           CrossProduct(const CVector2 &_other) const          { return x * _other.y - y * _other.x; }
 
             float           GetLength() const;
-            float           GetSquaredLength() const                            { return x * x + y * y; }
+            constexpr float GetSquaredLength() const                            { return x * x + y * y; }
             float           GetInverseLength() const;
             float           GetFastInverseLength() const;
 
@@ -86,8 +86,8 @@ namespace MindShake
             void            FastNormalize();
             CVector2        GetFastNormalized() const;
 
-            CVector2        GetVector(const CVector2 &_other) const             { return CVector2(_other.x - x, _other.y - y); }
-            CVector2        GetMidPoint(const CVector2 &_other) const           { return CVector2((x + _other.x) * 0.5f, (y + _other.y) * 0.5f); }
+            constexpr CVector2 GetVector(const CVector2 &_other) const          { return CVector2(_other.x - x, _other.y - y); }
+            constexpr CVector2 GetMidPoint(const CVector2 &_other) const        { return CVector2((x + _other.x) * 0.5f, (y + _other.y) * 0.5f); }
 
             float           GetDistance(const CVector2 &_other) const           { return GetVector(_other).GetLength(); }
             float           GetSquaredDistance(const CVector2 &_other) const    { return GetVector(_other).GetSquaredLength(); }
@@ -139,10 +139,10 @@ namespace MindShake
             bool            IsZeroLength() const;
             bool            IsNaN() const;
 
-            CVector2        GetXX() const                                       { return CVector2(x);    }
-            CVector2        GetXY() const                                       { return *this;          }
-            CVector2        GetYX() const                                       { return CVector2(y, x); }
-            CVector2        GetYY() const                                       { return CVector2(y);    }
+            constexpr CVector2 GetXX() const                                    { return CVector2(x);    }
+            constexpr CVector2 GetXY() const                                    { return *this;          }
+            constexpr CVector2 GetYX() const                                    { return CVector2(y, x); }
+            constexpr CVector2 GetYY() const                                    { return CVector2(y);    }
 
         public:
 #pragma pack(push, 1)
@@ -159,39 +159,47 @@ namespace MindShake
     };
 
     //---------------------------------
-    inline CVector2 operator + (const CVector2 &_v1, const CVector2 &_v2)       { return CVector2(_v1.x + _v2.x, _v1.y + _v2.y); }
-    inline CVector2 operator + (const CVector2 &_v1, float           _v2)       { return CVector2(_v1.x + _v2,   _v1.y + _v2);   }
-    inline CVector2 operator + (float           _v1, const CVector2 &_v2)       { return CVector2(_v1   + _v2.x, _v1   + _v2.y); }
+    inline constexpr CVector2   CVector2::kZERO(0.0f);
+    inline constexpr CVector2   CVector2::kONE(1.0f);
+    inline constexpr CVector2   CVector2::kUNIT_X(1, 0);
+    inline constexpr CVector2   CVector2::kUNIT_Y(0, 1);
+    inline constexpr CVector2   CVector2::kNEGATIVE_UNIT_X(-1, 0);
+    inline constexpr CVector2   CVector2::kNEGATIVE_UNIT_Y( 0, -1);
 
-    inline CVector2 operator - (const CVector2 &_v1, const CVector2 &_v2)       { return CVector2(_v1.x - _v2.x, _v1.y - _v2.y); }
-    inline CVector2 operator - (const CVector2 &_v1, float           _v2)       { return CVector2(_v1.x - _v2,   _v1.y - _v2);   }
-    inline CVector2 operator - (float           _v1, const CVector2 &_v2)       { return CVector2(_v1   - _v2.x, _v1   - _v2.y); }
+    //---------------------------------
+    constexpr CVector2 operator + (const CVector2 &_v1, const CVector2 &_v2)    { return CVector2(_v1.x + _v2.x, _v1.y + _v2.y); }
+    constexpr CVector2 operator + (const CVector2 &_v1, float           _v2)    { return CVector2(_v1.x + _v2,   _v1.y + _v2);   }
+    constexpr CVector2 operator + (float           _v1, const CVector2 &_v2)    { return CVector2(_v1   + _v2.x, _v1   + _v2.y); }
+
+    constexpr CVector2 operator - (const CVector2 &_v1, const CVector2 &_v2)    { return CVector2(_v1.x - _v2.x, _v1.y - _v2.y); }
+    constexpr CVector2 operator - (const CVector2 &_v1, float           _v2)    { return CVector2(_v1.x - _v2,   _v1.y - _v2);   }
+    constexpr CVector2 operator - (float           _v1, const CVector2 &_v2)    { return CVector2(_v1   - _v2.x, _v1   - _v2.y); }
 
-    inline CVector2 operator * (const CVector2 &_v1, const CVector2 &_v2)       { return CVector2(_v1.x * _v2.x, _v1.y * _v2.y); }
-    inline CVector2 operator * (const CVector2 &_v1, float           _v2)       { return CVector2(_v1.x * _v2,   _v1.y * _v2);   }
-    inline CVector2 operator * (float           _v1, const CVector2 &_v2)       { return CVector2(_v1   * _v2.x, _v1   * _v2.y); }
+    constexpr CVector2 operator * (const CVector2 &_v1, const CVector2 &_v2)    { return CVector2(_v1.x * _v2.x, _v1.y * _v2.y); }
+    constexpr CVector2 operator * (const CVector2 &_v1, float           _v2)    { return CVector2(_v1.x * _v2,   _v1.y * _v2);   }
+    constexpr CVector2 operator * (float           _v1, const CVector2 &_v2)    { return CVector2(_v1   * _v2.x, _v1   * _v2.y); }
 
     CVector2        operator / (const CVector2 &_v1, const CVector2 &_v2);
     CVector2        operator / (const CVector2 &_v1, float           _v2);
     CVector2        operator / (float           _v1, const CVector2 &_v2);
 
-    inline float    DotProduct(const CVector2    &_v1, const CVector2 &_v2)             { return _v1.x * _v2.x + _v1.y * _v2.y; }
+    constexpr float DotProduct(const CVector2    &_v1, const CVector2 &_v2)             { return _v1.x * _v2.x + _v1.y * _v2.y; }
     float           AbsDotProduct(const CVector2 &_v1, const CVector2 &_v2);
-    inline float    PerpendicularDotProduct (const CVector2 &_v1, const CVector2 &_v2)  { return _v1.x * _v2.y - _v1.y * _v2.x; } // Left Handed
-    inline float    PerpendicularDotProductR(const CVector2 &_v1, const CVector2 &_v2)  { return _v1.y * _v2.x - _v1.x * _v2.y; } // Right Handed
+    constexpr float PerpendicularDotProduct (const CVector2 &_v1, const CVector2 &_v2)  { return _v1.x * _v2.y - _v1.y * _v2.x; } // Left Handed
+    constexpr float PerpendicularDotProductR(const CVector2 &_v1, const CVector2 &_v2)  { return _v1.y * _v2.x - _v1.x * _v2.y; } // Right Handed
 
-    inline float    CrossProduct(const CVector2 &_v1, const CVector2 &_v2)      { return _v1.x * _v2.y - _v1.y * _v2.x; }
-    inline CVector2 CrossProduct(const CVector2 &_v, float _value)              { return CVector2( _value * _v.y, -_value * _v.x); }
-    inline CVector2 CrossProduct(float _value, const CVector2 &_v)              { return CVector2(-_value * _v.y,  _value * _v.x); }
+    constexpr float CrossProduct(const CVector2 &_v1, const CVector2 &_v2)      { return _v1.x * _v2.y - _v1.y * _v2.x; }
+    constexpr CVector2 CrossProduct(const CVector2 &_v, float _value)           { return CVector2( _value * _v.y, -_value * _v.x); }
+    constexpr CVector2 CrossProduct(float _value, const CVector2 &_v)           { return CVector2(-_value * _v.y,  _value * _v.x); }
 
-    inline CVector2 GetVector(const CVector2 &_v1, const CVector2 &_v2)         { return CVector2(_v2.x - _v1.x, _v2.y - _v1.y); }
-    inline CVector2 GetMidPoint(const CVector2 &_v1, const CVector2 &_v2)       { return (_v1 + _v2) * 0.5f; }
+    constexpr CVector2 GetVector(const CVector2 &_v1, const CVector2 &_v2)      { return CVector2(_v2.x - _v1.x, _v2.y - _v1.y); }
+    constexpr CVector2 GetMidPoint(const CVector2 &_v1, const CVector2 &_v2)    { return (_v1 + _v2) * 0.5f; }
 
     inline float    GetDistance(const CVector2 &_v1, const CVector2 &_v2)        { return GetVector(_v1, _v2).GetLength(); }
     inline float    GetSquaredDistance(const CVector2 &_v1, const CVector2 &_v2) { return GetVector(_v1, _v2).GetSquaredLength(); }
 
-    inline CVector2 GetPerpendicular(const CVector2 &_vector)                   { return CVector2(-_vector.y,  _vector.x); } // Left Handed
-    inline CVector2 GetPerpendicularR(const CVector2 &_vector)                  { return CVector2( _vector.y, -_vector.x); } // Right Handed
+    constexpr CVector2 GetPerpendicular(const CVector2 &_vector)                { return CVector2(-_vector.y,  _vector.x); } // Left Handed
+    constexpr CVector2 GetPerpendicularR(const CVector2 &_vector)               { return CVector2( _vector.y, -_vector.x); } // Right Handed
     
     CVector2        GetProjection(const CVector2 &_from, const CVector2 &_to);      // Returns _from projected over _to vector
     CVector2        GetProjectionUnit(const CVector2 &_from, const CVector2 &_to);  // If _to vector is unitary, this method is faster than GetProjection
@@ -204,7 +212,7 @@ namespace MindShake
 
     float           GetAngleBetween(const CVector2 &_v1, const CVector2 &_v2);
 
-    inline CVector2 Lerp(const CVector2 &_v1, const CVector2 &_v2, float _theta) { return _v1 + ((_v2 - _v1) * _theta);}
+    constexpr CVector2 Lerp(const CVector2 &_v1, const CVector2 &_v2, float _theta) { return _v1 + ((_v2 - _v1) * _theta);}
     CVector2        Serp(const CVector2 &_v1, const CVector2 &_v2, float _theta);
 
     CVector2        Min   (const CVector2 &_v1, const CVector2 &_v2);
@@ -14,16 +14,6 @@
 namespace MindShake
 {
 
-    //---------------------------------
-    const CVector3 CVector3::kZERO(0.0f);
-    const CVector3 CVector3::kONE(1.0f);
-    const CVector3 CVector3::kUNIT_X(1, 0, 0);
-    const CVector3 CVector3::kUNIT_Y(0, 1, 0);
-    const CVector3 CVector3::kUNIT_Z(0, 0, 1);
-    const CVector3 CVector3::kNEGATIVE_UNIT_X(-1, 0, 0);
-    const CVector3 CVector3::kNEGATIVE_UNIT_Y(0, -1, 0);
-    const CVector3 CVector3::kNEGATIVE_UNIT_Z(0, 0, -1);
-
     //---------------------------------
     CVector3::CVector3(const CVector2 &_v2)
     {
@@ -147,16 +137,6 @@ namespace MindShake
         return MindShake::DotProduct(*this, MindShake::GetPerpendicular(_other));
     }
 
-    //---------------------------------
-    CVector3
-    CVector3::CrossProduct(const CVector3 &_other) const
-    {
-        return CVector3(
-            y * _other.z - z * _other.y,
-            z * _other.x - x * _other.z,
-            x * _other.y - y * _other.x);
-    }
-
     //---------------------------------
     float
     CVector3::GetLength() const
@@ -1113,16 +1093,6 @@ namespace MindShake
         return DotProduct(_v1, GetPerpendicular(_v2)); 
     }
     
-    //---------------------------------
-    CVector3
-    CrossProduct(const CVector3 &_v1, const CVector3 &_v2)
-    {
-        return CVector3(
-            _v1.y * _v2.z - _v1.z * _v2.y,
-            _v1.z * _v2.x - _v1.x * _v2.z,
-            _v1.x * _v2.y - _v1.y * _v2.x);
-    }
-
     //---------------------------------
     CVector3
     GetPerpendicular(const CVector3 &_vector)
@@ -23,8 +23,8 @@ namespace MindShake
                             CVector3(const CVector3 &_other)                    = default;
                             ~CVector3()                                         = default;
 
-            explicit        CVector3(float _v)                                  { x = _v; y = _v; z = _v; }
-                            CVector3(float _x, float _y, float _z)              { x = _x; y = _y; z = _z; }
+            explicit constexpr CVector3(float _v)                               : x(_v), y(_v), z(_v) { }
+                  constexpr CVector3(float _x, float _y, float _z)              : x(_x), y(_y), z(_z) { }
 
             template <typename T>
             explicit        CVector3(const T *_ptr)                             { assert(_ptr != nullptr); x = float(_ptr[0]), y = float(_ptr[1]), z = float(_ptr[2]); }
@@ -50,17 +50,17 @@ namespace MindShake
 
             void            Swap(CVector3 &_other);
 
-            bool            operator == (const CVector3 &_other) const          { return (x == _other.x) && (y == _other.y) && (z == _other.z); }
-            bool            operator != (const CVector3 &_other) const          { return (x != _other.x) || (y != _other.y) || (z != _other.z); }
+            constexpr bool  operator == (const CVector3 &_other) const          { return (x == _other.x) && (y == _other.y) && (z == _other.z); }
+            constexpr bool  operator != (const CVector3 &_other) const          { return (x != _other.x) || (y != _other.y) || (z != _other.z); }
 
             bool            IsEqual   (const CVector3 &_other, float _tolerance = Float32::EPSILON) const;
             bool            IsNotEqual(const CVector3 &_other, float _tolerance = Float32::EPSILON) const;
 
-            bool            operator < (const CVector3 &_other) const           { return (x < _other.x) && (y < _other.y) && (z < _other.z); }
-            bool            operator > (const CVector3 &_other) const           { return (x > _other.x) && (y > _other.y) && (z > _other.z); }
+            constexpr bool  operator < (const CVector3 &_other) const           { return (x < _other.x) && (y < _other.y) && (z < _other.z); }
+            constexpr bool  operator > (const CVector3 &_other) const           { return (x > _other.x) && (y > _other.y) && (z > _other.z); }
 
             const CVector3 &operator + () const                                 { return *this; }
-            CVector3        operator - () const                                 { return CVector3(-x, -y, -z); }
+            constexpr CVector3 operator - () const                              { return CVector3(-x, -y, -z); }
 
             void            operator += (float _v)                              { x += _v;       y += _v;       z += _v;       }
             void            operator += (const CVector3 &_other)                { x += _other.x; y += _other.y; z += _other.z; }
@@ -71,14 +71,14 @@ namespace MindShake
             void            operator /= (float _value);
             void            operator /= (const CVector3 &_other);
 
-            float           DotProduct(const CVector3 &_other) const            { return (x * _other.x) + (y * _other.y) + (z * _other.z); }
+            constexpr float DotProduct(const CVector3 &_other) const            { return (x * _other.x) + (y * _other.y) + (z * _other.z); }
             float           AbsDotProduct(const CVector3 &_other) const;
             float           PerpendicularDotProduct(const CVector3 &_other) const;
 
-            CVector3        CrossProduct(const CVector3 &_other) const;
+            constexpr CVector3 CrossProduct(const CVector3 &_other) const       { return CVector3(y * _other.z - z * _other.y, z * _other.x - x * _other.z, x * _other.y - y * _other.x); }
 
             float           GetLength() const;
-            float           GetSquaredLength() const                            { return x * x + y * y + z * z; }
+            constexpr float GetSquaredLength() const                            { return x * x + y * y + z * z; }
             float           GetInverseLength() const;
             float           GetFastInverseLength() const;
 
@@ -93,8 +93,8 @@ namespace MindShake
             void            FastNormalize();
             CVector3        GetFastNormalized() const;
 
-            CVector3        GetVector(const CVector3 &_other) const             { return CVector3(_other.x - x, _other.y - y, _other.z - z); }
-            CVector3        GetMidPoint(const CVector3& _other) const           { return CVector3((x + _other.x) * 0.5f, (y + _other.y) * 0.5f, (z + _other.z) * 0.5f); }
+            constexpr CVector3 GetVector(const CVector3 &_other) const          { return CVector3(_other.x - x, _other.y - y, _other.z - z); }
+            constexpr CVector3 GetMidPoint(const CVector3& _other) const        { return CVector3((x + _other.x) * 0.5f, (y + _other.y) * 0.5f, (z + _other.z) * 0.5f); }
 
             float           GetDistance(const CVector3 &_other) const           { return GetVector(_other).GetLength(); }
             float           GetSquaredDistance(const CVector3 &_other) const    { return GetVector(_other).GetSquaredLength(); }
@@ -210,30 +210,40 @@ namespace MindShake
     };
 
     //---------------------------------
-    inline CVector3 operator + (const CVector3 &_v1, const CVector3 &_v2)       { return CVector3(_v1.x + _v2.x, _v1.y + _v2.y, _v1.z + _v2.z); }
-    inline CVector3 operator + (const CVector3 &_v1, float           _v2)       { return CVector3(_v1.x + _v2,   _v1.y + _v2,   _v1.z + _v2);   }
-    inline CVector3 operator + (float           _v1, const CVector3 &_v2)       { return CVector3(_v1   + _v2.x, _v1   + _v2.y, _v1   + _v2.z); }
+    inline constexpr CVector3   CVector3::kZERO(0.0f);
+    inline constexpr CVector3   CVector3::kONE(1.0f);
+    inline constexpr CVector3   CVector3::kUNIT_X(1, 0, 0);
+    inline constexpr CVector3   CVector3::kUNIT_Y(0, 1, 0);
+    inline constexpr CVector3   CVector3::kUNIT_Z(0, 0, 1);
+    inline constexpr CVector3   CVector3::kNEGATIVE_UNIT_X(-1, 0, 0);
+    inline constexpr CVector3   CVector3::kNEGATIVE_UNIT_Y(0, -1, 0);
+    inline constexpr CVector3   CVector3::kNEGATIVE_UNIT_Z(0, 0, -1);
 
-    inline CVector3 operator - (const CVector3 &_v1, const CVector3 &_v2)       { return CVector3(_v1.x - _v2.x, _v1.y - _v2.y, _v1.z - _v2.z); }
-    inline CVector3 operator - (const CVector3 &_v1, float           _v2)       { return CVector3(_v1.x - _v2,   _v1.y - _v2,   _v1.z - _v2);   }
-    inline CVector3 operator - (float           _v1, const CVector3 &_v2)       { return CVector3(_v1   - _v2.x, _v1   - _v2.y, _v1   - _v2.z); }
+    //---------------------------------
+    constexpr CVector3 operator + (const CVector3 &_v1, const CVector3 &_v2)    { return CVector3(_v1.x + _v2.x, _v1.y + _v2.y, _v1.z + _v2.z); }
+    constexpr CVector3 operator + (const CVector3 &_v1, float           _v2)    { return CVector3(_v1.x + _v2,   _v1.y + _v2,   _v1.z + _v2);   }
+    constexpr CVector3 operator + (float           _v1, const CVector3 &_v2)    { return CVector3(_v1   + _v2.x, _v1   + _v2.y, _v1   + _v2.z); }
+
+    constexpr CVector3 operator - (const CVector3 &_v1, const CVector3 &_v2)    { return CVector3(_v1.x - _v2.x, _v1.y - _v2.y, _v1.z - _v2.z); }
+    constexpr CVector3 operator - (const CVector3 &_v1, float           _v2)    { return CVector3(_v1.x - _v2,   _v1.y - _v2,   _v1.z - _v2);   }
+    constexpr CVector3 operator - (float           _v1, const CVector3 &_v2)    { return CVector3(_v1   - _v2.x, _v1   - _v2.y, _v1   - _v2.z); }
 
-    inline CVector3 operator * (const CVector3 &_v1, const CVector3 &_v2)       { return CVector3(_v1.x * _v2.x, _v1.y * _v2.y, _v1.z * _v2.z); }
-    inline CVector3 operator * (const CVector3 &_v1, float           _v2)       { return CVector3(_v1.x * _v2,   _v1.y * _v2,   _v1.z * _v2);   }
-    inline CVector3 operator * (float           _v1, const CVector3 &_v2)       { return CVector3(_v1   * _v2.x, _v1   * _v2.y, _v1   * _v2.z); }
+    constexpr CVector3 operator * (const CVector3 &_v1, const CVector3 &_v2)    { return CVector3(_v1.x * _v2.x, _v1.y * _v2.y, _v1.z * _v2.z); }
+    constexpr CVector3 operator * (const CVector3 &_v1, float           _v2)    { return CVector3(_v1.x * _v2,   _v1.y * _v2,   _v1.z * _v2);   }
+    constexpr CVector3 operator * (float           _v1, const CVector3 &_v2)    { return CVector3(_v1   * _v2.x, _v1   * _v2.y, _v1   * _v2.z); }
 
     CVector3        operator / (const CVector3 &_v1, const CVector3 &_v2);
     CVector3        operator / (const CVector3 &_v1, float           _v2);
     CVector3        operator / (float           _v1, const CVector3 &_v2);
 
-    inline float    DotProduct(const CVector3    &_v1, const CVector3 &_v2)     { return _v1.x * _v2.x + _v1.y * _v2.y + _v1.z * _v2.z; }
+    constexpr float DotProduct(const CVector3    &_v1, const CVector3 &_v2)     { return _v1.x * _v2.x + _v1.y * _v2.y + _v1.z * _v2.z; }
     float           AbsDotProduct(const CVector3 &_v1, const CVector3 &_v2);
     float           PerpendicularDotProduct(const CVector3 &_v1, const CVector3 &_v2);
 
-    CVector3        CrossProduct(const CVector3 &_v1, const CVector3 &_v2);
+    constexpr CVector3 CrossProduct(const CVector3 &_v1, const CVector3 &_v2)   { return CVector3(_v1.y * _v2.z - _v1.z * _v2.y, _v1.z * _v2.x - _v1.x * _v2.z, _v1.x * _v2.y - _v1.y * _v2.x); }
 
-    inline CVector3 GetVector(const CVector3 &_v1, const CVector3 &_v2)         { return CVector3(_v2.x - _v1.x, _v2.y - _v1.y, _v2.z - _v1.z); }
-    inline CVector3 GetMidPoint(const CVector3& _v1, const CVector3& _v2)       { return CVector3((_v1.x + _v2.x) * 0.5f, (_v1.y + _v2.y) * 0.5f, (_v1.z + _v2.z) * 0.5f); }
+    constexpr CVector3 GetVector(const CVector3 &_v1, const CVector3 &_v2)      { return CVector3(_v2.x - _v1.x, _v2.y - _v1.y, _v2.z - _v1.z); }
+    constexpr CVector3 GetMidPoint(const CVector3& _v1, const CVector3& _v2)    { return CVector3((_v1.x + _v2.x) * 0.5f, (_v1.y + _v2.y) * 0.5f, (_v1.z + _v2.z) * 0.5f); }
 
     inline float    GetDistance(const CVector3 &_v1, const CVector3 &_v2)        { return GetVector(_v1, _v2).GetLength(); }
     inline float    GetSquaredDistance(const CVector3 &_v1, const CVector3 &_v2) { return GetVector(_v1, _v2).GetSquaredLength(); }
@@ -251,7 +261,7 @@ namespace MindShake
 
     float           GetAngleBetween(const CVector3 &_v1, const CVector3 &_v2);
 
-    inline CVector3 Lerp(const CVector3 &_v1, const CVector3 &_v2, float _theta) { return _v1 + ((_v2-_v1) * _theta); }
+    constexpr CVector3 Lerp(const CVector3 &_v1, const CVector3 &_v2, float _theta) { return _v1 + ((_v2-_v1) * _theta); }
     CVector3        Serp(const CVector3 &_v1, const CVector3 &_v2, float _theta);
 
     CVector3        Min   (const CVector3 &_v1, const CVector3 &_v2);
@@ -12,18 +12,6 @@
 namespace MindShake
 {
 
-    //---------------------------------
-    const CVector4 CVector4::kZERO(0.0f);
-    const CVector4 CVector4::kONE(1.0f);
-    const CVector4 CVector4::kUNIT_X(1, 0, 0, 0);
-    const CVector4 CVector4::kUNIT_Y(0, 1, 0, 0);
-    const CVector4 CVector4::kUNIT_Z(0, 0, 1, 0);
-    const CVector4 CVector4::kUNIT_W(0, 0, 0, 1);
-    const CVector4 CVector4::kNEGATIVE_UNIT_X(-1,  0,  0,  0);
-    const CVector4 CVector4::kNEGATIVE_UNIT_Y( 0, -1,  0,  0);
-    const CVector4 CVector4::kNEGATIVE_UNIT_Z( 0,  0, -1,  0);
-    const CVector4 CVector4::kNEGATIVE_UNIT_W( 0,  0,  0, -1);
-
     //---------------------------------
     CVector4::CVector4(const CVector2 &_v2)
         : x(_v2.x), y(_v2.y), z(0), w(1.0f)
@@ -156,39 +144,6 @@ namespace MindShake
 
     //---------------------------------
 
-    //---------------------------------
-    void
-    CVector4::operator /= (const CVector4 &_other)
-    {
-        if(_other.x != 0.0f)
-            x /= _other.x;
-
-        if(_other.y != 0.0f)
-            y /= _other.y;
-
-        if(_other.z != 0.0f)
-            z /= _other.z;
-
-        if(_other.w != 0.0f)
-            w /= _other.w;
-    }
-
-    //---------------------------------
-    void
-    CVector4::operator /= (float _value)
-    {
-        float inv;
-
-        if(IsNotZero(_value))
-        {
-            inv = 1.0f / _value;
-            x *= inv;
-            y *= inv;
-            z *= inv;
-            w *= inv;
-        }
-    }
-
     //---------------------------------
     //---------------------------------
 
@@ -202,20 +157,6 @@ namespace MindShake
     //---------------------------------
     //---------------------------------
 
-    //---------------------------------
-    float
-    CVector4::GetLength() const
-    {
-        return MindShake::Sqrt(x*x + y*y + z*z + w*w);
-    }
-
-    //---------------------------------
-    float
-    CVector4::GetInverseLength() const
-    {
-        return MindShake::InvSqrt(x*x + y*y + z*z + w*w);
-    }
-
     //---------------------------------
     float
     CVector4::GetFastInverseLength() const
@@ -296,19 +237,6 @@ namespace MindShake
         }
     }
 
-    //---------------------------------
-    void
-    CVector4::Normalize()
-    {
-        float invLength;
-
-        invLength = MindShake::InvSqrt(x*x + y*y + z*z + w*w);
-        x *= invLength;
-        y *= invLength;
-        z *= invLength;
-        w *= invLength;
-    }
-
     //---------------------------------
     float
     CVector4::NormalizeAndGetLength()
@@ -328,22 +256,6 @@ namespace MindShake
         return len;
     }
 
-    //---------------------------------
-    CVector4
-    CVector4::GetNormalized() const
-    {
-        float   invLength;
-        float   nx, ny, nz, nw;
-
-        invLength = MindShake::InvSqrt(x*x + y*y + z*z + w*w);
-        nx = x * invLength;
-        ny = y * invLength;
-        nz = z * invLength;
-        nw = w * invLength;
-
-        return CVector4(nx, ny, nz, nw);
-    }
-
     //---------------------------------
     void
     CVector4::FastNormalize()
@@ -662,67 +574,4 @@ namespace MindShake
     //---------------------------------
     //---------------------------------
 
-    //---------------------------------
-    CVector4
-    operator /(const CVector4 &_v1, const CVector4 &_v2)
-    {
-        CVector4    v(0);
-
-        if(_v2.x != 0.0f)
-            v.x = _v1.x / _v2.x;
-
-        if(_v2.y != 0.0f)
-            v.y = _v1.y / _v2.y;
-
-        if(_v2.z != 0.0f)
-            v.z = _v1.z / _v2.z;
-
-        if(_v2.w != 0.0f)
-            v.w = _v1.w / _v2.w;
-
-        return v;
-    }
-
-    //---------------------------------
-    CVector4
-    operator /(float _v1, const CVector4 &_v2)
-    {
-        CVector4    v(0);
-
-        if(_v2.x != 0.0f)
-            v.x = _v1 / _v2.x;
-
-        if(_v2.y != 0.0f)
-            v.y = _v1 / _v2.y;
-
-        if(_v2.z != 0.0f)
-            v.z = _v1 / _v2.z;
-
-        if(_v2.w != 0.0f)
-            v.w = _v1 / _v2.w;
-
-        return v;
-    }
-
-    //---------------------------------
-    CVector4
-    operator /(const CVector4 &_v1, float    _v2)
-    {
-        CVector4    v;
-        float       aux;
-
-        if(_v2 != 0.0f)
-        {
-            aux = 1.0f / _v2;
-            v.x = _v1.x * aux;
-            v.y = _v1.y * aux;
-            v.z = _v1.z * aux;
-            v.w = _v1.w * aux;
-
-            return v;
-        }
-
-        return CVector4(0);
-    }
-
 } // end of namespace
@@ -2,6 +2,8 @@
 
 //-------------------------------------
 #include <Common/Math/constants.h>
+#include <Common/Math/simd_funcs.h>
+#include <Common/Math/math_funcs.h>
 //-------------------------------------
 #include <cassert>
 #include <cstddef>
@@ -25,8 +27,8 @@ namespace MindShake
                             CVector4(const CVector4 &_other)                    = default;
                             ~CVector4()                                         = default;
 
-            explicit        CVector4(float _v)                                  { x = _v; y = _v; z = _v; w = _v; }
-                            CVector4(float _x, float _y, float _z, float _w)    { x = _x; y = _y; z = _z; w = _w; }
+            explicit constexpr CVector4(float _v)                               : x(_v), y(_v), z(_v), w(_v) { }
+                  constexpr CVector4(float _x, float _y, float _z, float _w)    : x(_x), y(_y), z(_z), w(_w) { }
 
                             template <typename T>
             explicit        CVector4(const T *_ptr)                             { assert(_ptr != nullptr); x = float(_ptr[0]), y = float(_ptr[1]), z = float(_ptr[2]), w = float(_ptr[3]); }
@@ -35,6 +37,11 @@ namespace MindShake
                             CVector4(const CVector2 &_v2, float _z, float _w);
                             CVector4(const CVector3 &_v3);
                             CVector4(const CVector3 &_v3, float _w);
+#if defined(MS_MATH_SSE)
+            explicit        CVector4(__m128 _v)                                 { simd = _v; }
+
+            __m128          GetSIMD() const                                     { return simd; }
+#endif
 
             CVector4 &      operator = (float _v)                               { x = _v; y = _v; z = _v; w = _v; return *this; }
             CVector4 &      operator = (const CVector3 &_v3);
@@ -58,16 +65,26 @@ namespace MindShake
 
             void            Swap(CVector4 &_rOther);
 
-            bool            operator == (const CVector4 &_other) const          { return (x == _other.x) && (y == _other.y) && (z == _other.z) && (w == _other.w); }
-            bool            operator != (const CVector4 &_other) const          { return (x != _other.x) || (y != _other.y) || (z != _other.z) || (w != _other.w); }
+            constexpr bool  operator == (const CVector4 &_other) const          { return (x == _other.x) && (y == _other.y) && (z == _other.z) && (w == _other.w); }
+            constexpr bool  operator != (const CVector4 &_other) const          { return (x != _other.x) || (y != _other.y) || (z != _other.z) || (w != _other.w); }
 
             bool            IsEqual   (const CVector4 &_other, float _tolerance = Float32::EPSILON) const;
             bool            IsNotEqual(const CVector4 &_other, float _tolerance = Float32::EPSILON) const;
 
-            bool            operator < (const CVector4 &_other) const           { return (x < _other.x) && (y < _other.y) && (z < _other.z) && (w < _other.w); }
-            bool            operator > (const CVector4 &_other) const           { return (x > _other.x) && (y > _other.y) && (z > _other.z) && (w > _other.w); }
+            constexpr bool  operator < (const CVector4 &_other) const           { return (x < _other.x) && (y < _other.y) && (z < _other.z) && (w < _other.w); }
+            constexpr bool  operator > (const CVector4 &_other) const           { return (x > _other.x) && (y > _other.y) && (z > _other.z) && (w > _other.w); }
 
             const CVector4 &operator + () const                                 { return *this; }
+#if defined(MS_MATH_SSE)
+            CVector4        operator - () const                                 { return CVector4(_mm_xor_ps(simd, _mm_set1_ps(-0.0f)));  }
+
+            void            operator += (float _v)                              { simd = _mm_add_ps(simd, _mm_set1_ps(_v));  }
+            void            operator += (const CVector4 &_other)                { simd = _mm_add_ps(simd, _other.simd);      }
+            void            operator -= (float _v)                              { simd = _mm_sub_ps(simd, _mm_set1_ps(_v));  }
+            void            operator -= (const CVector4 &_other)                { simd = _mm_sub_ps(simd, _other.simd);      }
+            void            operator *= (float _v)                              { simd = _mm_mul_ps(simd, _mm_set1_ps(_v));  }
+            void            operator *= (const CVector4 &_other)                { simd = _mm_mul_ps(simd, _other.simd);      }
+#else
             CVector4        operator - () const                                 { return CVector4(-x, -y, -z, -w);  }
 
             void            operator += (float _v)                              { x += _v;       y += _v;       z += _v;       w += _v;       }
@@ -76,14 +93,19 @@ namespace MindShake
             void            operator -= (const CVector4 &_other)                { x -= _other.x; y -= _other.y; z -= _other.z; w -= _other.w; }
             void            operator *= (float _v)                              { x *= _v;       y *= _v;       z *= _v;       w *= _v;       }
             void            operator *= (const CVector4 &_other)                { x *= _other.x; y *= _other.y; z *= _other.z; w *= _other.w; }
+#endif
             void            operator /= (float _value);
             void            operator /= (const CVector4 &_other);
 
+#if defined(MS_MATH_SSE)
+            float           DotProduct(const CVector4 &_other) const            { return _mm_cvtss_f32(SimdDot4(simd, _other.simd)); }
+#else
             float           DotProduct(const CVector4 &_other) const            { return x * _other.x + y * _other.y + z * _other.z + w * _other.w; }
+#endif
             float           AbsDotProduct(const CVector4 &_other) const;
 
             float           GetLength() const;
-            float           GetSquaredLength() const                            { return x * x + y * y + z * z + w * w; }
+            float           GetSquaredLength() const                            { return DotProduct(*this); }
             float           GetInverseLength() const;
             float           GetFastInverseLength() const;
 
@@ -98,8 +120,8 @@ namespace MindShake
             void            FastNormalize();
             CVector4        GetFastNormalized() const;
 
-            CVector4        GetVector(const CVector4 &_other) const             { return CVector4(_other.x - x, _other.y - y, _other.z - z, _other.w - w); }
-            CVector4        GetMidPoint(const CVector4& _other) const           { return CVector4((x + _other.x) * 0.5f, (y + _other.y) * 0.5f, (z + _other.z) * 0.5f, (w + _other.w) * 0.5f);
+            constexpr CVector4 GetVector(const CVector4 &_other) const          { return CVector4(_other.x - x, _other.y - y, _other.z - z, _other.w - w); }
+            constexpr CVector4 GetMidPoint(const CVector4& _other) const        { return CVector4((x + _other.x) * 0.5f, (y + _other.y) * 0.5f, (z + _other.z) * 0.5f, (w + _other.w) * 0.5f);
 }
 
             float           GetDistance(const CVector4 &_other) const           { return GetVector(_other).GetLength(); }
@@ -135,9 +157,14 @@ namespace MindShake
             CVector3        GetXYZ() const;
 
         public:
-#pragma pack(push, 1)
-            float x, y, z, w;
-#pragma pack(pop)
+            union {
+                struct {
+                    float x, y, z, w;
+                };
+#if defined(MS_MATH_SSE)
+                __m128  simd;
+#endif
+            };
 
         public:
             static const CVector4 kZERO;
@@ -154,6 +181,31 @@ namespace MindShake
     };
 
     //---------------------------------
+    inline constexpr CVector4   CVector4::kZERO(0.0f);
+    inline constexpr CVector4   CVector4::kONE(1.0f);
+    inline constexpr CVector4   CVector4::kUNIT_X(1, 0, 0, 0);
+    inline constexpr CVector4   CVector4::kUNIT_Y(0, 1, 0, 0);
+    inline constexpr CVector4   CVector4::kUNIT_Z(0, 0, 1, 0);
+    inline constexpr CVector4   CVector4::kUNIT_W(0, 0, 0, 1);
+    inline constexpr CVector4   CVector4::kNEGATIVE_UNIT_X(-1,  0,  0,  0);
+    inline constexpr CVector4   CVector4::kNEGATIVE_UNIT_Y( 0, -1,  0,  0);
+    inline constexpr CVector4   CVector4::kNEGATIVE_UNIT_Z( 0,  0, -1,  0);
+    inline constexpr CVector4   CVector4::kNEGATIVE_UNIT_W( 0,  0,  0, -1);
+
+    //---------------------------------
+#if defined(MS_MATH_SSE)
+    inline CVector4 operator + (const CVector4 &_v1, const CVector4 &_v2)       { return CVector4(_mm_add_ps(_v1.simd,          _v2.simd));          }
+    inline CVector4 operator + (const CVector4 &_v1, float           _v2)       { return CVector4(_mm_add_ps(_v1.simd,          _mm_set1_ps(_v2)));  }
+    inline CVector4 operator + (float           _v1, const CVector4 &_v2)       { return CVector4(_mm_add_ps(_mm_set1_ps(_v1),  _v2.simd));          }
+
+    inline CVector4 operator - (const CVector4 &_v1, const CVector4 &_v2)       { return CVector4(_mm_sub_ps(_v1.simd,          _v2.simd));          }
+    inline CVector4 operator - (const CVector4 &_v1, float           _v2)       { return CVector4(_mm_sub_ps(_v1.simd,          _mm_set1_ps(_v2)));  }
+    inline CVector4 operator - (float           _v1, const CVector4 &_v2)       { return CVector4(_mm_sub_ps(_mm_set1_ps(_v1),  _v2.simd));          }
+
+    inline CVector4 operator * (const CVector4 &_v1, const CVector4 &_v2)       { return CVector4(_mm_mul_ps(_v1.simd,          _v2.simd));          }
+    inline CVector4 operator * (const CVector4 &_v1, float           _v2)       { return CVector4(_mm_mul_ps(_v1.simd,          _mm_set1_ps(_v2)));  }
+    inline CVector4 operator * (float           _v1, const CVector4 &_v2)       { return CVector4(_mm_mul_ps(_mm_set1_ps(_v1),  _v2.simd));          }
+#else
     inline CVector4 operator + (const CVector4 &_v1, const CVector4 &_v2)       { return CVector4(_v1.x + _v2.x, _v1.y + _v2.y, _v1.z + _v2.z, _v1.w + _v2.w); }
     inline CVector4 operator + (const CVector4 &_v1, float           _v2)       { return CVector4(_v1.x + _v2,   _v1.y + _v2,   _v1.z + _v2,   _v1.w + _v2);   }
     inline CVector4 operator + (float           _v1, const CVector4 &_v2)       { return CVector4(_v1   + _v2.x, _v1   + _v2.y, _v1   + _v2.z, _v1   + _v2.w); }
@@ -165,8 +217,116 @@ namespace MindShake
     inline CVector4 operator * (const CVector4 &_v1, const CVector4 &_v2)       { return CVector4(_v1.x * _v2.x, _v1.y * _v2.y, _v1.z * _v2.z, _v1.w * _v2.w); }
     inline CVector4 operator * (const CVector4 &_v1, float           _v2)       { return CVector4(_v1.x * _v2,   _v1.y * _v2,   _v1.z * _v2,   _v1.w * _v2);   }
     inline CVector4 operator * (float           _v1, const CVector4 &_v2)       { return CVector4(_v1   * _v2.x, _v1   * _v2.y, _v1   * _v2.z, _v1   * _v2.w); }
+#endif
 
     CVector4        operator / (const CVector4 &_v1, const CVector4 &_v2);
     CVector4        operator / (const CVector4 &_v1, float           _v2);
     CVector4        operator / (float           _v1, const CVector4 &_v2);
-}
+
+    //---------------------------------
+    // Division: components divided by 0 are left as is (/=) or set to 0 (/)
+    //---------------------------------
+    inline void
+    CVector4::operator /= (const CVector4 &_other) {
+#if defined(MS_MATH_SSE)
+        __m128 isZero = _mm_cmpeq_ps(_other.simd, _mm_setzero_ps());
+
+        simd = _mm_or_ps(_mm_and_ps(isZero, simd), _mm_andnot_ps(isZero, _mm_div_ps(simd, _other.simd)));
+#else
+        if(_other.x != 0.0f)
+            x /= _other.x;
+
+        if(_other.y != 0.0f)
+            y /= _other.y;
+
+        if(_other.z != 0.0f)
+            z /= _other.z;
+
+        if(_other.w != 0.0f)
+            w /= _other.w;
+#endif
+    }
+
+    //---------------------------------
+    inline void
+    CVector4::operator /= (float _value) {
+        if(IsNotZero(_value)) {
+            *this *= 1.0f / _value;
+        }
+    }
+
+    //---------------------------------
+    inline CVector4
+    operator / (const CVector4 &_v1, const CVector4 &_v2) {
+#if defined(MS_MATH_SSE)
+        __m128 isZero = _mm_cmpeq_ps(_v2.simd, _mm_setzero_ps());
+
+        return CVector4(_mm_andnot_ps(isZero, _mm_div_ps(_v1.simd, _v2.simd)));
+#else
+        CVector4    v(0);
+
+        if(_v2.x != 0.0f)
+            v.x = _v1.x / _v2.x;
+
+        if(_v2.y != 0.0f)
+            v.y = _v1.y / _v2.y;
+
+        if(_v2.z != 0.0f)
+            v.z = _v1.z / _v2.z;
+
+        if(_v2.w != 0.0f)
+            v.w = _v1.w / _v2.w;
+
+        return v;
+#endif
+    }
+
+    //---------------------------------
+    inline CVector4
+    operator / (float _v1, const CVector4 &_v2) {
+        return CVector4(_v1) / _v2;
+    }
+
+    //---------------------------------
+    inline CVector4
+    operator / (const CVector4 &_v1, float _v2) {
+        if(_v2 != 0.0f)
+            return _v1 * (1.0f / _v2);
+
+        return CVector4(0.0f);
+    }
+
+    //---------------------------------
+    // Length
+    //---------------------------------
+    inline float
+    CVector4::GetLength() const {
+        return MindShake::Sqrt(GetSquaredLength());
+    }
+
+    //---------------------------------
+    inline float
+    CVector4::GetInverseLength() const {
+        return MindShake::InvSqrt(GetSquaredLength());
+    }
+
+    //---------------------------------
+    inline void
+    CVector4::Normalize() {
+#if defined(MS_MATH_SSE)
+        simd = SimdNormalize4(simd, SimdDot4(simd, simd));
+#else
+        *this *= MindShake::InvSqrt(GetSquaredLength());
+#endif
+    }
+
+    //---------------------------------
+    inline CVector4
+    CVector4::GetNormalized() const {
+        CVector4 r(*this);
+
+        r.Normalize();
+        return r;
+    }
+
+} // end of namespace
@@ -26,6 +26,12 @@ mfb_update_state    mfb_update(struct mfb_window *window, void *buffer);
 // Only updates the window events
 mfb_update_state    mfb_update_events(struct mfb_window *window);
 
+// Only pushes the buffer (no events, never closes the window), so it can run in a present thread
+// while the event thread calls mfb_update_events. That one destroys the window once it is closing:
+// stop presenting first. X11 only, the other backends return STATE_INTERNAL_ERROR
+mfb_update_state    mfb_update_present(struct mfb_window *window, void *buffer);
+bool                mfb_can_update_present(struct mfb_window *window);    // Whether the backend supports mfb_update_present
+
 // Close the window
 void                mfb_close(struct mfb_window *window);
 
@@ -44,9 +50,13 @@ void                mfb_set_mouse_button_callback(struct mfb_window *window, mfb
 void                mfb_set_mouse_move_callback(struct mfb_window *window, mfb_mouse_move_func callback);
 void                mfb_set_mouse_scroll_callback(struct mfb_window *window, mfb_mouse_scroll_func callback);
 
+// Replaces the 32 bit image scaler used when the window size differs from the buffer size (0x0 restores the default one)
+void                mfb_set_stretch_func(mfb_stretch_func func);
+
 const char *        mfb_get_key_name(mfb_key key);
 
 bool                mfb_is_window_active(struct mfb_window *window);
+bool                mfb_is_window_closing(struct mfb_window *window);     // Closed, destroyed by the next mfb_update / mfb_update_events
 unsigned            mfb_get_window_width(struct mfb_window *window);
 unsigned            mfb_get_window_height(struct mfb_window *window);
 int                 mfb_get_mouse_x(struct mfb_window *window);             // Last mouse pos X
@@ -119,6 +119,16 @@ mfb_is_window_active(struct mfb_window *window) {
     return false;
 }
 
+//-------------------------------------
+bool 
+mfb_is_window_closing(struct mfb_window *window) {
+    if(window != 0x0) {
+        SWindowData *window_data = (SWindowData *) window;
+        return window_data->close;
+    }
+    return true;
+}
+
 //-------------------------------------
 unsigned 
 mfb_get_window_width(struct mfb_window *window) {
@@ -38,17 +38,41 @@ interpolate(uint32_t *srcImage, uint32_t x, uint32_t y, uint32_t srcOffsetX, uin
 }
 #endif
 
+// Replaced from any thread while stretch_image may be running in the one that presents
+#if defined(_MSC_VER)
+    // Aligned pointer loads and stores are atomic on every MSVC target
+    static mfb_stretch_func volatile g_stretch_func = 0x0;
+    #define kLoadStretchFunc()          g_stretch_func
+    #define kStoreStretchFunc(func)     g_stretch_func = (func)
+#else
+    static mfb_stretch_func g_stretch_func = 0x0;
+    #define kLoadStretchFunc()          __atomic_load_n(&g_stretch_func, __ATOMIC_RELAXED)
+    #define kStoreStretchFunc(func)     __atomic_store_n(&g_stretch_func, (func), __ATOMIC_RELAXED)
+#endif
+
+void
+mfb_set_stretch_func(mfb_stretch_func func) {
+    kStoreStretchFunc(func);
+}
+
 // Only for 32 bits images
 void 
 stretch_image(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
               uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch) {
 
-    uint32_t    x, y;
-    uint32_t    srcOffsetX, srcOffsetY;
+    uint32_t            x, y;
+    uint32_t            srcOffsetX, srcOffsetY;
+    mfb_stretch_func    stretch_func;
 
     if(srcImage == 0x0 || dstImage == 0x0)
         return;
 
+    stretch_func = kLoadStretchFunc();
+    if(stretch_func != 0x0) {
+        stretch_func(srcImage, srcX, srcY, srcWidth, srcHeight, srcPitch, dstImage, dstX, dstY, dstWidth, dstHeight, dstPitch);
+        return;
+    }
+
     srcImage += srcX + srcY * srcPitch;
     dstImage += dstX + dstY * dstPitch;
 
@@ -771,6 +771,24 @@ mfb_update_events(struct mfb_window *window)
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Presenting outside the event thread is not supported by this backend
+mfb_update_state 
+mfb_update_present(struct mfb_window *window, void *buffer)
+{
+    kUnused(window);
+    kUnused(buffer);
+    return STATE_INTERNAL_ERROR;
+}
+
+bool 
+mfb_can_update_present(struct mfb_window *window)
+{
+    kUnused(window);
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 extern short int g_keycodes[512];
 
 void 
@@ -433,6 +433,22 @@ mfb_update_events(struct mfb_window *window) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Presenting outside the event thread is not supported by this backend
+mfb_update_state 
+mfb_update_present(struct mfb_window *window, void *buffer) {
+    kUnused(window);
+    kUnused(buffer);
+    return STATE_INTERNAL_ERROR;
+}
+
+bool 
+mfb_can_update_present(struct mfb_window *window) {
+    kUnused(window);
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void 
 destroy_window_data(SWindowData *window_data) {
     if (window_data == 0x0)
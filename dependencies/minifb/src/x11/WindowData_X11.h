@@ -2,7 +2,10 @@
 
 #include <MiniFB_enums.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
 #include <X11/Xlib.h>
+#include <X11/extensions/XShm.h>
 
 
 typedef struct {
@@ -17,4 +20,15 @@ typedef struct {
     XImage      *image_scaler;
     uint32_t    image_scaler_width;
     uint32_t    image_scaler_height;
+
+    pthread_mutex_t viewport_mutex;     // dst_* (resized by the event thread, read by the one that presents)
+
+    // MIT-SHM present (falls back to XPutImage when not available)
+    bool            use_shm;
+    bool            shm_pending;        // XShmPutImage sent, server may still be reading
+    int             shm_completion_type;
+    XImage          *shm_image;
+    XShmSegmentInfo shm_info;
+    uint32_t        shm_width;
+    uint32_t        shm_height;
 } SWindowData_X11;
@@ -4,6 +4,9 @@
 #include <X11/keysym.h>
 #include <X11/Xatom.h>
 #include <X11/cursorfont.h>
+#include <X11/extensions/XShm.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -20,6 +23,8 @@ stretch_image(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidt
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+static void install_error_handler(Display *display);
+
 struct mfb_window *
 mfb_open_ex(const char *title, unsigned width, unsigned height, unsigned flags) {
     int depth, i, formatCount, convDepth = -1;
@@ -42,12 +47,16 @@ mfb_open_ex(const char *title, unsigned width, unsigned height, unsigned flags)
     memset(window_data_x11, 0, sizeof(SWindowData_X11));
     window_data->specific = window_data_x11;
 
+    // mfb_update_present may run in another thread
+    XInitThreads();
     window_data_x11->display = XOpenDisplay(0);
     if (!window_data_x11->display) {
         free(window_data);
         free(window_data_x11);
         return 0x0;
     }
+    pthread_mutex_init(&window_data_x11->viewport_mutex, 0x0);
+    install_error_handler(window_data_x11->display);
     
     init_keycodes(window_data_x11);
 
@@ -185,6 +194,12 @@ mfb_open_ex(const char *title, unsigned width, unsigned height, unsigned flags)
 
     window_data_x11->image = XCreateImage(window_data_x11->display, CopyFromParent, depth, ZPixmap, 0, 0x0, width, height, 32, width * 4);
 
+    // The shared image is created on the first update (it follows the viewport size)
+    if (XShmQueryExtension(window_data_x11->display)) {
+        window_data_x11->use_shm             = true;
+        window_data_x11->shm_completion_type = XShmGetEventBase(window_data_x11->display) + ShmCompletion;
+    }
+
     mfb_set_keyboard_callback((struct mfb_window *) window_data, keyboard_default);
 
     printf("Window created using X11 API\n");
@@ -211,6 +226,12 @@ processEvents(SWindowData *window_data) {
     while ((window_data->close == false) && XPending(window_data_x11->display)) {
         XNextEvent(window_data_x11->display, &event);
 
+        // Not a constant, so it can not be a case
+        if (window_data_x11->use_shm && event.type == window_data_x11->shm_completion_type) {
+            window_data_x11->shm_pending = false;
+            continue;
+        }
+
         switch (event.type) {
             case KeyPress:
             case KeyRelease: 
@@ -268,10 +289,12 @@ processEvents(SWindowData *window_data) {
             {
                 window_data->window_width  = event.xconfigure.width;
                 window_data->window_height = event.xconfigure.height;
+                pthread_mutex_lock(&window_data_x11->viewport_mutex);
                 window_data->dst_offset_x = 0;
                 window_data->dst_offset_y = 0;
                 window_data->dst_width    = window_data->window_width;
                 window_data->dst_height   = window_data->window_height;
+                pthread_mutex_unlock(&window_data_x11->viewport_mutex);
 
                 XClearWindow(window_data_x11->display, window_data_x11->window);
                 kCall(resize_func, window_data->window_width, window_data->window_height);
@@ -302,28 +325,207 @@ processEvents(SWindowData *window_data) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void destroy(SWindowData *window_data);
+#if !defined(X_ShmAttach)
+    #define X_ShmAttach     1       // MIT-SHM minor opcode (X11/extensions/shmproto.h)
+#endif
 
-mfb_update_state 
-mfb_update(struct mfb_window *window, void *buffer) {
-    if (window == 0x0) {
-        return STATE_INVALID_WINDOW;
+// The error handler is process wide, so it is installed once (from the thread
+// that opens the display) instead of around each XShmAttach. The attach errors
+// may be handled by the event thread while the present thread waits in XSync
+static XErrorHandler    g_prev_error_handler = 0x0;
+static int              g_shm_opcode         = -1;
+static int              g_shm_error          = 0;
+
+static int 
+error_handler(Display *display, XErrorEvent *event) {
+    if (event->request_code == g_shm_opcode && event->minor_code == X_ShmAttach) {
+        __atomic_store_n(&g_shm_error, 1, __ATOMIC_RELEASE);
+        return 0;
     }
+    if (g_prev_error_handler != 0x0) {
+        return g_prev_error_handler(display, event);
+    }
+    return 0;
+}
 
-    SWindowData *window_data = (SWindowData *) window;
-    if (window_data->close) {
-        destroy(window_data);
-        return STATE_EXIT;
+static void 
+install_error_handler(Display *display) {
+    int first_event, first_error;
+
+    if (g_shm_opcode >= 0) {
+        return;
+    }
+    if (XQueryExtension(display, "MIT-SHM", &g_shm_opcode, &first_event, &first_error) == False) {
+        g_shm_opcode = -1;
+        return;
     }
+    g_prev_error_handler = XSetErrorHandler(error_handler);
+}
 
-    if (buffer == 0x0) {
-        return STATE_INVALID_BUFFER;
+static Bool 
+is_shm_completion(Display *display, XEvent *event, XPointer arg) {
+    SWindowData_X11 *window_data_x11 = (SWindowData_X11 *) arg;
+    (void) display;
+
+    return event->type == window_data_x11->shm_completion_type && ((XShmCompletionEvent *) event)->drawable == window_data_x11->window;
+}
+
+// The server reads the shared image after XShmPutImage returns: wait for it before writing again
+static void 
+wait_shm_completion(SWindowData_X11 *window_data_x11) {
+    XEvent  event;
+
+    if (window_data_x11->shm_pending) {
+        XIfEvent(window_data_x11->display, &event, is_shm_completion, (XPointer) window_data_x11);
+        window_data_x11->shm_pending = false;
+    }
+}
+
+static void 
+destroy_shm_image(SWindowData_X11 *window_data_x11) {
+    XEvent  event;
+
+    if (window_data_x11->shm_image == 0x0) {
+        return;
+    }
+
+    // After the round trip the server is done with any pending put. Its completion
+    // event is dropped, so it is not taken for the one of the next image
+    XShmDetach(window_data_x11->display, &window_data_x11->shm_info);
+    XSync(window_data_x11->display, False);
+    while (XCheckIfEvent(window_data_x11->display, &event, is_shm_completion, (XPointer) window_data_x11)) {
+    }
+    window_data_x11->shm_pending = false;
+    shmdt(window_data_x11->shm_info.shmaddr);
+
+    window_data_x11->shm_image->data = 0x0;
+    XDestroyImage(window_data_x11->shm_image);
+    window_data_x11->shm_image  = 0x0;
+    window_data_x11->shm_width  = 0;
+    window_data_x11->shm_height = 0;
+}
+
+// On any failure (ie. remote display, no shm segments left) SHM is disabled for this window
+static bool 
+create_shm_image(SWindowData_X11 *window_data_x11, uint32_t width, uint32_t height) {
+    XShmSegmentInfo *shm_info = &window_data_x11->shm_info;
+    XImage          *image;
+
+    if (window_data_x11->shm_image != 0x0 && window_data_x11->shm_width == width && window_data_x11->shm_height == height) {
+        return true;
+    }
+    destroy_shm_image(window_data_x11);
+
+    Visual  *visual = DefaultVisual(window_data_x11->display, window_data_x11->screen);
+    int     depth   = DefaultDepth(window_data_x11->display, window_data_x11->screen);
+    image = XShmCreateImage(window_data_x11->display, visual, depth, ZPixmap, 0x0, shm_info, width, height);
+    if (image == 0x0) {
+        window_data_x11->use_shm = false;
+        return false;
+    }
+
+    shm_info->shmid = shmget(IPC_PRIVATE, (size_t) image->bytes_per_line * image->height, IPC_CREAT | 0600);
+    if (shm_info->shmid < 0) {
+        XDestroyImage(image);
+        window_data_x11->use_shm = false;
+        return false;
+    }
+
+    shm_info->shmaddr = image->data = (char *) shmat(shm_info->shmid, 0x0, 0);
+    shm_info->readOnly = False;
+    if (shm_info->shmaddr == (char *) -1) {
+        shmctl(shm_info->shmid, IPC_RMID, 0x0);
+        image->data = 0x0;
+        XDestroyImage(image);
+        window_data_x11->use_shm = false;
+        return false;
     }
 
+    // Attach errors arrive asynchronously
+    __atomic_store_n(&g_shm_error, 0, __ATOMIC_RELEASE);
+    XShmAttach(window_data_x11->display, shm_info);
+    XSync(window_data_x11->display, False);
+
+    // The segment goes away once both sides detach
+    shmctl(shm_info->shmid, IPC_RMID, 0x0);
+
+    if (__atomic_load_n(&g_shm_error, __ATOMIC_ACQUIRE)) {
+        shmdt(shm_info->shmaddr);
+        image->data = 0x0;
+        XDestroyImage(image);
+        window_data_x11->use_shm = false;
+        return false;
+    }
+
+    window_data_x11->shm_image  = image;
+    window_data_x11->shm_width  = width;
+    window_data_x11->shm_height = height;
+
+    return true;
+}
+
+// The viewport is read once, under the lock the event thread takes to change
+// it while another thread presents (mfb_update_present)
+typedef struct {
+    uint32_t    x, y;
+    uint32_t    width, height;
+} SViewport_X11;
+
+// One copy into the shared image (or the stretch straight into it) instead of
+// pushing the whole buffer through the socket. With sync the server is done
+// with the image on return, instead of tracking it with completion events
+static bool 
+update_shm(SWindowData *window_data, SWindowData_X11 *window_data_x11, void *buffer, const SViewport_X11 *viewport, bool sync) {
+    if (create_shm_image(window_data_x11, viewport->width, viewport->height) == false) {
+        return false;
+    }
+
+    wait_shm_completion(window_data_x11);
+
+    XImage      *image = window_data_x11->shm_image;
+    uint32_t    pitch  = (uint32_t) image->bytes_per_line / 4;
+    if (window_data->buffer_width != viewport->width || window_data->buffer_height != viewport->height) {
+        stretch_image((uint32_t *) buffer, 0, 0, window_data->buffer_width, window_data->buffer_height, window_data->buffer_width, (uint32_t *) image->data, 0, 0, viewport->width, viewport->height, pitch);
+    }
+    else if (pitch == window_data->buffer_width) {
+        memcpy(image->data, buffer, (size_t) window_data->buffer_width * window_data->buffer_height * 4);
+    }
+    else {
+        for (uint32_t y = 0; y < window_data->buffer_height; ++y) {
+            memcpy(image->data + (size_t) y * image->bytes_per_line, (uint32_t *) buffer + (size_t) y * window_data->buffer_width, window_data->buffer_width * 4);
+        }
+    }
+
+    XShmPutImage(window_data_x11->display, window_data_x11->window, window_data_x11->gc, image, 0, 0, viewport->x, viewport->y, viewport->width, viewport->height, sync ? False : True);
+    if (sync) {
+        XSync(window_data_x11->display, False);
+    }
+    else {
+        window_data_x11->shm_pending = true;
+    }
+
+    return true;
+}
+
+static mfb_update_state 
+present_buffer(SWindowData *window_data, void *buffer, bool sync) {
     SWindowData_X11 *window_data_x11 = (SWindowData_X11 *) window_data->specific;
+    SViewport_X11   viewport;
+
+    pthread_mutex_lock(&window_data_x11->viewport_mutex);
+    viewport.x      = window_data->dst_offset_x;
+    viewport.y      = window_data->dst_offset_y;
+    viewport.width  = window_data->dst_width;
+    viewport.height = window_data->dst_height;
+    pthread_mutex_unlock(&window_data_x11->viewport_mutex);
+
+    if (window_data_x11->use_shm && update_shm(window_data, window_data_x11, buffer, &viewport, sync)) {
+        XFlush(window_data_x11->display);
+        return STATE_OK;
+    }
 
-    if (window_data->buffer_width != window_data->dst_width || window_data->buffer_height != window_data->dst_height) {
-        if (window_data_x11->image_scaler_width != window_data->dst_width || window_data_x11->image_scaler_height != window_data->dst_height) {
+    if (window_data->buffer_width != viewport.width || window_data->buffer_height != viewport.height) {
+        if (window_data_x11->image_scaler_width != viewport.width || window_data_x11->image_scaler_height != viewport.height) {
             if (window_data_x11->image_scaler != 0x0) {
                 window_data_x11->image_scaler->data = 0x0;
                 XDestroyImage(window_data_x11->image_scaler);
@@ -333,26 +535,54 @@ mfb_update(struct mfb_window *window, void *buffer) {
                 window_data_x11->image_buffer = 0x0;
             }
             int depth = DefaultDepth(window_data_x11->display, window_data_x11->screen);
-            window_data_x11->image_buffer = malloc(window_data->dst_width * window_data->dst_height * 4);
+            window_data_x11->image_buffer = malloc(viewport.width * viewport.height * 4);
             if(window_data_x11->image_buffer == 0x0) {
                 return STATE_INTERNAL_ERROR;
             }
-            window_data_x11->image_scaler_width  = window_data->dst_width;
-            window_data_x11->image_scaler_height = window_data->dst_height;
+            window_data_x11->image_scaler_width  = viewport.width;
+            window_data_x11->image_scaler_height = viewport.height;
             window_data_x11->image_scaler = XCreateImage(window_data_x11->display, CopyFromParent, depth, ZPixmap, 0, 0x0, window_data_x11->image_scaler_width, window_data_x11->image_scaler_height, 32, window_data_x11->image_scaler_width * 4);
         }
     }
 
     if (window_data_x11->image_scaler != 0x0) {
-        stretch_image((uint32_t *) buffer, 0, 0, window_data->buffer_width, window_data->buffer_height, window_data->buffer_width, (uint32_t *) window_data_x11->image_buffer, 0, 0, window_data->dst_width, window_data->dst_height, window_data->dst_width);
+        stretch_image((uint32_t *) buffer, 0, 0, window_data->buffer_width, window_data->buffer_height, window_data->buffer_width, (uint32_t *) window_data_x11->image_buffer, 0, 0, window_data_x11->image_scaler_width, window_data_x11->image_scaler_height, window_data_x11->image_scaler_width);
         window_data_x11->image_scaler->data = (char *) window_data_x11->image_buffer;
-        XPutImage(window_data_x11->display, window_data_x11->window, window_data_x11->gc, window_data_x11->image_scaler, 0, 0, window_data->dst_offset_x, window_data->dst_offset_y, window_data->dst_width, window_data->dst_height);
+        XPutImage(window_data_x11->display, window_data_x11->window, window_data_x11->gc, window_data_x11->image_scaler, 0, 0, viewport.x, viewport.y, window_data_x11->image_scaler_width, window_data_x11->image_scaler_height);
     }
     else {
         window_data_x11->image->data = (char *) buffer;
-        XPutImage(window_data_x11->display, window_data_x11->window, window_data_x11->gc, window_data_x11->image, 0, 0, window_data->dst_offset_x, window_data->dst_offset_y, window_data->dst_width, window_data->dst_height);
+        XPutImage(window_data_x11->display, window_data_x11->window, window_data_x11->gc, window_data_x11->image, 0, 0, viewport.x, viewport.y, viewport.width, viewport.height);
     }
     XFlush(window_data_x11->display);
+
+    return STATE_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void destroy(SWindowData *window_data);
+
+mfb_update_state 
+mfb_update(struct mfb_window *window, void *buffer) {
+    if (window == 0x0) {
+        return STATE_INVALID_WINDOW;
+    }
+
+    SWindowData *window_data = (SWindowData *) window;
+    if (window_data->close) {
+        destroy(window_data);
+        return STATE_EXIT;
+    }
+
+    if (buffer == 0x0) {
+        return STATE_INVALID_BUFFER;
+    }
+
+    mfb_update_state state = present_buffer(window_data, buffer, false);
+    if (state != STATE_OK) {
+        return state;
+    }
     processEvents(window_data);
     
     return STATE_OK;
@@ -360,6 +590,26 @@ mfb_update(struct mfb_window *window, void *buffer) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+mfb_update_state 
+mfb_update_present(struct mfb_window *window, void *buffer) {
+    if (window == 0x0) {
+        return STATE_INVALID_WINDOW;
+    }
+
+    if (buffer == 0x0) {
+        return STATE_INVALID_BUFFER;
+    }
+
+    return present_buffer((SWindowData *) window, buffer, true);
+}
+
+bool 
+mfb_can_update_present(struct mfb_window *window) {
+    return window != 0x0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 mfb_update_state 
 mfb_update_events(struct mfb_window *window) {
     if (window == 0x0) {
@@ -386,12 +636,14 @@ destroy(SWindowData *window_data)  {
     if (window_data != 0x0) {
         if (window_data->specific != 0x0) {
             SWindowData_X11   *window_data_x11 = (SWindowData_X11 *) window_data->specific;
+            destroy_shm_image(window_data_x11);
             if (window_data_x11->image != 0x0) {
                 window_data_x11->image->data = 0x0;
                 XDestroyImage(window_data_x11->image);
                 XDestroyWindow(window_data_x11->display, window_data_x11->window);
                 XCloseDisplay(window_data_x11->display);
             }
+            pthread_mutex_destroy(&window_data_x11->viewport_mutex);
             memset(window_data_x11, 0, sizeof(SWindowData_X11));
             free(window_data_x11);
         }
@@ -671,7 +923,8 @@ translate_mod_ex(int key, int state, int is_pressed) {
 
 bool 
 mfb_set_viewport(struct mfb_window *window, unsigned offset_x, unsigned offset_y, unsigned width, unsigned height)  {
-    SWindowData *window_data = (SWindowData *) window;
+    SWindowData     *window_data     = (SWindowData *) window;
+    SWindowData_X11 *window_data_x11 = (SWindowData_X11 *) window_data->specific;
 
     if (offset_x + width > window_data->window_width) {
         return false;
@@ -680,10 +933,12 @@ mfb_set_viewport(struct mfb_window *window, unsigned offset_x, unsigned offset_y
         return false;
     }
 
+    pthread_mutex_lock(&window_data_x11->viewport_mutex);
     window_data->dst_offset_x = offset_x;
     window_data->dst_offset_y = offset_y;
     window_data->dst_width    = width;
     window_data->dst_height   = height;
+    pthread_mutex_unlock(&window_data_x11->viewport_mutex);
     
     return true;
 }
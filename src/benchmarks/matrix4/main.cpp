@@ -0,0 +1,335 @@
+#include <Math/types/CMatrix4.h>
+#include <Math/types/CMatrix3.h>
+#include <Math/types/CMatrix3x4.h>
+#include <Math/types/CVector3.h>
+#include <Math/types/CVector4.h>
+#include <Kernel/timer/CChronoTimer.h>
+#include <Kernel/cpu/CCpuKernel.h>
+//-------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+//-------------------------------------
+
+using namespace MindShake;
+
+//-------------------------------------
+#define kNumMatrices    4096
+#define kNumRounds      256
+#define kNumPoints      65536
+#define kNumNodes       100000
+
+using Matrices = std::vector<CMatrix4>;
+using Affines  = std::vector<CMatrix3x4>;
+using Function = void (*)(const CMatrix4 &, const CMatrix4 &, CMatrix4 &);
+using Unary    = void (*)(const CMatrix4 &, CMatrix4 &);
+
+//-------------------------------------
+static float
+Random(float _min, float _max) {
+    return _min + (_max - _min) * (float(rand()) / float(RAND_MAX));
+}
+
+//-------------------------------------
+static CMatrix4
+RandomAffine() {
+    CMatrix4 mat;
+
+    mat.MakeTransform(CVector3(Random(-100, 100), Random(-100, 100), Random(-100, 100)),
+                      CVector3(Random(0.5f, 2.0f), Random(0.5f, 2.0f), Random(0.5f, 2.0f)),
+                      CVector3(Random(0, 360), Random(0, 360), Random(0, 360)));
+    return mat;
+}
+
+//-------------------------------------
+// Previous InvertAffine: round trip through CMatrix3
+//-------------------------------------
+static void
+InvertAffineMatrix3(const CMatrix4 &_in, CMatrix4 &_out) {
+    const float *v = _in.GetPtr();
+    CMatrix3    mat3(v[0], v[1], v[2],
+                     v[4], v[5], v[6],
+                     v[8], v[9], v[10]);
+
+    mat3.Invert();
+
+    const float *r = mat3.GetPtr();
+    _out = CMatrix4(r[0], r[1], r[2], 0.0f,
+                    r[3], r[4], r[5], 0.0f,
+                    r[6], r[7], r[8], 0.0f,
+                    -(r[0] * v[12] + r[3] * v[13] + r[6] * v[14]),
+                    -(r[1] * v[12] + r[4] * v[13] + r[7] * v[14]),
+                    -(r[2] * v[12] + r[5] * v[13] + r[8] * v[14]), 1.0f);
+}
+
+#if defined(MS_MATH_SSE)
+//-------------------------------------
+static float
+MaxDifference(const Matrices &_a, const Matrices &_b) {
+    float diff = 0.0f;
+
+    for (size_t i = 0; i < _a.size(); ++i) {
+        for (size_t j = 0; j < 16; ++j) {
+            float d = fabsf(_a[i].GetPtr()[j] - _b[i].GetPtr()[j]) / fmaxf(1.0f, fabsf(_a[i].GetPtr()[j]));
+            if (d > diff)
+                diff = d;
+        }
+    }
+
+    return diff;
+}
+#endif
+
+//-------------------------------------
+static double
+Bench(Function _func, const Matrices &_a, const Matrices &_b, Matrices &_out) {
+    CChronoTimer timer;
+
+    double ini = timer.GetTime();
+    for (size_t round = 0; round < kNumRounds; ++round) {
+        for (size_t i = 0; i < _a.size(); ++i)
+            _func(_a[i], _b[i], _out[i]);
+    }
+
+    return (timer.GetTime() - ini) * 1e9 / double(kNumRounds * _a.size());
+}
+
+//-------------------------------------
+static double
+Bench(Unary _func, const Matrices &_in, Matrices &_out) {
+    CChronoTimer timer;
+
+    double ini = timer.GetTime();
+    for (size_t round = 0; round < kNumRounds; ++round) {
+        for (size_t i = 0; i < _in.size(); ++i)
+            _func(_in[i], _out[i]);
+    }
+
+    return (timer.GetTime() - ini) * 1e9 / double(kNumRounds * _in.size());
+}
+
+//-------------------------------------
+static double
+BenchAffine(const Affines &_a, const Affines &_b, Affines &_out) {
+    CChronoTimer timer;
+
+    double ini = timer.GetTime();
+    for (size_t round = 0; round < kNumRounds; ++round) {
+        for (size_t i = 0; i < _a.size(); ++i)
+            _out[i] = _a[i] * _b[i];
+    }
+
+    return (timer.GetTime() - ini) * 1e9 / double(kNumRounds * _a.size());
+}
+
+//-------------------------------------
+// Previous per point transform (ie. CMesh::Transform): operator * (CVector4) and divide
+//-------------------------------------
+static double
+BenchPointsOld(const CMatrix4 &_mat, const std::vector<CVector3> &_in, std::vector<CVector3> &_out) {
+    CChronoTimer timer;
+
+    double ini = timer.GetTime();
+    for (size_t round = 0; round < kNumRounds; ++round) {
+        CVector4 aux(1), tmp;
+        for (size_t i = 0; i < _in.size(); ++i) {
+            aux.x = _in[i].x;
+            aux.y = _in[i].y;
+            aux.z = _in[i].z;
+            tmp = _mat * aux;
+            if (tmp.w != 0) {
+                float invW = 1.0f / tmp.w;
+                _out[i] = CVector3(tmp.x * invW, tmp.y * invW, tmp.z * invW);
+            }
+            else {
+                _out[i].z = Float32::POS_INFINITY;
+            }
+        }
+    }
+
+    return (timer.GetTime() - ini) * 1e9 / double(kNumRounds * _in.size());
+}
+
+//-------------------------------------
+static double
+BenchPoints(const CMatrix4 &_mat, const std::vector<CVector3> &_in, std::vector<CVector3> &_out) {
+    CChronoTimer timer;
+
+    double ini = timer.GetTime();
+    for (size_t round = 0; round < kNumRounds; ++round) {
+        _mat.TransformPointsDivide(_in.data(), _out.data(), _in.size());
+    }
+
+    return (timer.GetTime() - ini) * 1e9 / double(kNumRounds * _in.size());
+}
+
+//-------------------------------------
+// Previous MakeTransform (ie. CSceneNode::BuildLocalMatrix3D): SinG / CosG per angle
+//-------------------------------------
+static void
+MakeTransformLibm(const CVector3 &_pos, const CVector3 &_scale, const CVector3 &_angles, CMatrix4 &_out) {
+    float sinX = SinG(_angles.x), cosX = CosG(_angles.x);
+    float sinY = SinG(_angles.y), cosY = CosG(_angles.y);
+    float sinZ = SinG(_angles.z), cosZ = CosG(_angles.z);
+
+    _out = CMatrix4( cosY * cosZ * _scale.x, (cosX * sinZ + sinX * sinY * cosZ) * _scale.x, (sinX * sinZ - cosX * sinY * cosZ) * _scale.x, 0,
+                    -cosY * sinZ * _scale.y, (cosX * cosZ - sinX * sinY * sinZ) * _scale.y, (sinX * cosZ + cosX * sinY * sinZ) * _scale.y, 0,
+                     sinY * _scale.z,        -sinX * cosY * _scale.z,                        cosX * cosY * _scale.z,                        0,
+                     _pos.x, _pos.y, _pos.z, 1);
+}
+
+//-------------------------------------
+static double
+BenchTransformsOld(const std::vector<CVector3> &_pos, const std::vector<CVector3> &_scale, const std::vector<CVector3> &_angles, Matrices &_out) {
+    CChronoTimer timer;
+
+    double ini = timer.GetTime();
+    for (size_t round = 0; round < kNumRounds / 16; ++round) {
+        for (size_t i = 0; i < _pos.size(); ++i)
+            MakeTransformLibm(_pos[i], _scale[i], _angles[i], _out[i]);
+    }
+
+    return (timer.GetTime() - ini) * 1e9 / double(kNumRounds / 16 * _pos.size());
+}
+
+//-------------------------------------
+static double
+BenchTransforms(const std::vector<CVector3> &_pos, const std::vector<CVector3> &_scale, const std::vector<CVector3> &_angles, Matrices &_out) {
+    CChronoTimer timer;
+
+    double ini = timer.GetTime();
+    for (size_t round = 0; round < kNumRounds / 16; ++round) {
+        CMatrix4::MakeTransforms(_pos.data(), _scale.data(), _angles.data(), _out.data(), _pos.size());
+    }
+
+    return (timer.GetTime() - ini) * 1e9 / double(kNumRounds / 16 * _pos.size());
+}
+
+//-------------------------------------
+static void
+Report(const char *_name, double _scalar, double _simd, float _diff) {
+    if (_simd > 0.0)
+        printf("%-16s scalar %7.2f ns   simd %7.2f ns   x%.2f   max rel diff %g\n", _name, _scalar, _simd, _scalar / _simd, _diff);
+    else
+        printf("%-16s scalar %7.2f ns\n", _name, _scalar);
+}
+
+//-------------------------------------
+int
+main(int, char *[]) {
+    Matrices    a(kNumMatrices), b(kNumMatrices), proj(kNumMatrices);
+    Matrices    outScalar(kNumMatrices), outSIMD(kNumMatrices);
+    double      timeScalar, timeSIMD = 0.0;
+    float       diff = 0.0f;
+
+    srand(1234);
+    for (size_t i = 0; i < kNumMatrices; ++i) {
+        a[i]    = RandomAffine();
+        b[i]    = RandomAffine();
+        proj[i] = CMatrix4::Perspective(Random(45, 90), Random(1, 2), Random(0.1f, 1), Random(100, 1000)) * a[i];
+    }
+
+    printf("CPU level: %s (detected %s)\n", GetCpuLevelName(GetCpuLevel()), GetCpuLevelName(GetDetectedCpuLevel()));
+    for (const CCpuKernelBase *kernel = CCpuKernelBase::GetFirst(); kernel != nullptr; kernel = kernel->GetNext()) {
+        printf("  %-36s %s\n", kernel->GetName(), GetCpuLevelName(kernel->GetVariant()));
+    }
+#if defined(MS_MATH_SSE)
+    printf("SIMD: SSE\n");
+#else
+    printf("SIMD: none (MS_MATH_NO_SIMD)\n");
+#endif
+
+    // Multiply
+    timeScalar = Bench(&CMatrix4::MultiplyScalar, a, b, outScalar);
+#if defined(MS_MATH_SSE)
+    timeSIMD   = Bench(&CMatrix4::MultiplySSE, a, b, outSIMD);
+    diff       = MaxDifference(outScalar, outSIMD);
+#endif
+    Report("Multiply", timeScalar, timeSIMD, diff);
+
+    // General inverse
+    timeScalar = Bench(&CMatrix4::InvertScalar, proj, outScalar);
+#if defined(MS_MATH_SSE)
+    timeSIMD   = Bench(&CMatrix4::InvertSSE, proj, outSIMD);
+    diff       = MaxDifference(outScalar, outSIMD);
+#endif
+    Report("Inverse", timeScalar, timeSIMD, diff);
+
+    // Affine inverse
+    timeScalar = Bench(&InvertAffineMatrix3, a, outSIMD);
+    Report("InvAffine (old)", timeScalar, 0.0, 0.0f);
+    timeScalar = Bench(&CMatrix4::InvertAffineScalar, a, outScalar);
+#if defined(MS_MATH_SSE)
+    timeSIMD   = Bench(&CMatrix4::InvertAffineSSE, a, outSIMD);
+    diff       = MaxDifference(outScalar, outSIMD);
+#endif
+    Report("InvAffine", timeScalar, timeSIMD, diff);
+
+    // Affine concatenation (ie. node world matrices): CMatrix4 vs CMatrix3x4
+    Affines     a34(kNumMatrices), b34(kNumMatrices), out34(kNumMatrices);
+    for (size_t i = 0; i < kNumMatrices; ++i) {
+        a34[i] = CMatrix3x4(a[i]);
+        b34[i] = CMatrix3x4(b[i]);
+    }
+
+#if defined(MS_MATH_SSE)
+    timeScalar = Bench(&CMatrix4::MultiplySSE, a, b, outScalar);
+#else
+    timeScalar = Bench(&CMatrix4::MultiplyScalar, a, b, outScalar);
+#endif
+    timeSIMD   = BenchAffine(a34, b34, out34);
+    diff       = 0.0f;
+    for (size_t i = 0; i < kNumMatrices; ++i) {
+        CMatrix4 promoted(out34[i]);
+        for (size_t j = 0; j < 16; ++j)
+            diff = fmaxf(diff, fabsf(outScalar[i].GetPtr()[j] - promoted.GetPtr()[j]));
+    }
+    printf("%-16s mat4   %7.2f ns   3x4   %7.2f ns   x%.2f   max abs diff %g\n", "Concat (affine)", timeScalar, timeSIMD, timeScalar / timeSIMD, diff);
+
+    // Points
+    std::vector<CVector3>   points(kNumPoints), pointsOld(kNumPoints), pointsNew(kNumPoints);
+    for (CVector3 &point : points)
+        point = CVector3(Random(-100, 100), Random(-100, 100), Random(-100, 100));
+
+    timeScalar = BenchPointsOld(proj[0], points, pointsOld);
+    timeSIMD   = BenchPoints(proj[0], points, pointsNew);
+    diff       = 0.0f;
+    for (size_t i = 0; i < kNumPoints; ++i) {
+        diff = fmaxf(diff, fabsf(pointsOld[i].x - pointsNew[i].x) / fmaxf(1.0f, fabsf(pointsOld[i].x)));
+    }
+    printf("%-16s old    %7.2f ns   batch %7.2f ns   x%.2f   max rel diff %g\n", "Points (per pt)", timeScalar, timeSIMD, timeScalar / timeSIMD, diff);
+
+    // Every variant of the batch transform the CPU can run
+    ECpuLevel level = GetCpuLevel();
+    for (int l = int(ECpuLevel::Scalar); l <= int(level); ++l) {
+        SetCpuLevel(ECpuLevel(l));
+        timeSIMD = BenchPoints(proj[0], points, pointsNew);
+        diff     = 0.0f;
+        for (size_t i = 0; i < kNumPoints; ++i) {
+            diff = fmaxf(diff, fabsf(pointsOld[i].x - pointsNew[i].x) / fmaxf(1.0f, fabsf(pointsOld[i].x)));
+        }
+        printf("  %-14s %-6s %7.2f ns   x%.2f   max rel diff %g\n", "Points", GetCpuLevelName(ECpuLevel(l)), timeSIMD, timeScalar / timeSIMD, diff);
+    }
+    SetCpuLevel(level);
+
+    // Local matrices of animated nodes
+    std::vector<CVector3>   positions(kNumNodes), scales(kNumNodes), angles(kNumNodes);
+    Matrices                transformsOld(kNumNodes), transformsNew(kNumNodes);
+    for (size_t i = 0; i < kNumNodes; ++i) {
+        positions[i] = CVector3(Random(-100, 100), Random(-100, 100), Random(-100, 100));
+        scales[i]    = CVector3(Random(0.5f, 2.0f), Random(0.5f, 2.0f), Random(0.5f, 2.0f));
+        angles[i]    = CVector3(Random(-720, 720), Random(-720, 720), Random(-720, 720));
+    }
+
+    timeScalar = BenchTransformsOld(positions, scales, angles, transformsOld);
+    timeSIMD   = BenchTransforms(positions, scales, angles, transformsNew);
+    diff       = 0.0f;
+    for (size_t i = 0; i < kNumNodes; ++i) {
+        for (size_t j = 0; j < 16; ++j)
+            diff = fmaxf(diff, fabsf(transformsOld[i].GetPtr()[j] - transformsNew[i].GetPtr()[j]));
+    }
+    printf("%-16s old    %7.2f ns   batch %7.2f ns   x%.2f   max abs diff %g\n", "Transform (node)", timeScalar, timeSIMD, timeScalar / timeSIMD, diff);
+
+    return 0;
+}
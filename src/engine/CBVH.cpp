@@ -0,0 +1,473 @@
+#include "CBVH.h"
+//-------------------------------------
+#include <engine/CMesh.h>
+//-------------------------------------
+#include <algorithm>
+#include <cmath>
+
+//-------------------------------------
+const aabb CBVH::kEmptyBounds;
+
+//-------------------------------------
+void
+CBVH::Clear() {
+    mNodes.clear();
+    mItems.clear();
+    mItemBounds.Clear();
+    mParents.clear();
+    mLeafOfItem.clear();
+    mItemOfSlot.clear();
+    mBuildCost = 0.0f;
+    mCost      = 0.0f;
+    mAreaSum   = 0.0;
+    mIsDirty   = true;
+}
+
+//-------------------------------------
+void
+CBVH::Build(const vector<CMesh *> &meshes) {
+    mNodes.clear();
+    mItems.clear();
+    mItemBounds.Clear();
+    mParents.clear();
+    mLeafOfItem.clear();
+    mItemOfSlot.clear();
+    mIsDirty = false;
+    ++mNumRebuilds;
+
+    if(meshes.empty()) {
+        mBuildCost = 0.0f;
+        mCost      = 0.0f;
+        mAreaSum   = 0.0;
+        return;
+    }
+
+    mItems.reserve(meshes.size());
+    for(CMesh *mesh : meshes) {
+        Item item;
+
+        item.pMesh    = mesh;
+        item.bounds   = mesh->GetWorldBounds();
+        item.centroid = item.bounds.GetCenter();
+        ClearMoved(mesh);
+
+        mItems.push_back(item);
+    }
+
+    // A binary tree with leaves of at least one item never needs more than 2n - 1 nodes
+    mNodes.reserve(mItems.size() * 2);
+    mParents.reserve(mItems.size() * 2);
+    mLeafOfItem.resize(mItems.size());
+    mNodes.emplace_back();
+    mParents.push_back(kNone);
+    Subdivide(0, kNone, 0, uint32_t(mItems.size()), 0);
+
+    // Subdivide reorders the items
+    mItemBounds.Resize(mItems.size());
+    for(size_t i = 0; i < mItems.size(); ++i) {
+        uint32_t slot = mItems[i].pMesh->GetHandle().GetIndex();
+
+        mItemBounds.Set(i, mItems[i].bounds);
+        if(slot >= mItemOfSlot.size()) {
+            mItemOfSlot.resize(slot + 1, kNone);
+        }
+        mItemOfSlot[slot] = uint32_t(i);
+    }
+
+    mAreaSum   = ComputeAreaSum();
+    mBuildCost = ComputeSAHCost();
+    mCost      = mBuildCost;
+}
+
+//-------------------------------------
+void
+CBVH::Subdivide(uint32_t nodeIndex, uint32_t parent, uint32_t first, uint32_t count, uint32_t depth) {
+    aabb    bounds, centroidBounds;
+    size_t  axis;
+    float   position;
+    Item    *pBegin, *pEnd, *pMid;
+
+    for(uint32_t i = first; i < first + count; ++i) {
+        bounds.Expand(mItems[i].bounds);
+        centroidBounds.Expand(mItems[i].centroid);
+    }
+    mNodes[nodeIndex].bounds = bounds;
+    mParents[nodeIndex]      = parent;
+
+    // The items of a leaf are not moved anymore
+    auto makeLeaf = [&]() {
+        mNodes[nodeIndex].first = first;
+        mNodes[nodeIndex].count = count;
+        for(uint32_t i = first; i < first + count; ++i) {
+            mLeafOfItem[i] = nodeIndex;
+        }
+    };
+
+    if(count <= kMaxLeafItems) {
+        makeLeaf();
+        return;
+    }
+
+    pBegin = mItems.data() + first;
+    pEnd   = pBegin + count;
+    if(depth < kMaxSAHDepth) {
+        if(FindSplit(first, count, bounds, centroidBounds, axis, position) == false) {
+            makeLeaf();
+            return;
+        }
+        pMid = std::partition(pBegin, pEnd, [axis, position](const Item &item) { return item.centroid[axis] < position; });
+    }
+    else {
+        axis = centroidBounds.GetLongestAxis();
+        pMid = pBegin;
+    }
+
+    // Degenerated split (all centroids in one side) or too deep: cut in the middle
+    if(pMid == pBegin || pMid == pEnd) {
+        pMid = pBegin + (count >> 1);
+        std::nth_element(pBegin, pMid, pEnd, [axis](const Item &a, const Item &b) { return a.centroid[axis] < b.centroid[axis]; });
+    }
+
+    uint32_t leftCount = uint32_t(pMid - pBegin);
+    uint32_t left      = uint32_t(mNodes.size());
+
+    mNodes.emplace_back();
+    mNodes.emplace_back();
+    mParents.resize(mNodes.size());
+    mNodes[nodeIndex].first = left;
+    mNodes[nodeIndex].count = 0;
+
+    Subdivide(left,     nodeIndex, first,             leftCount,         depth + 1);
+    Subdivide(left + 1, nodeIndex, first + leftCount, count - leftCount, depth + 1);
+}
+
+// Binned SAH: the cost of a split is area(left) * n(left) + area(right) * n(right).
+// Returns false if no split is cheaper than keeping the items in a leaf.
+//-------------------------------------
+bool
+CBVH::FindSplit(uint32_t first, uint32_t count, const aabb &bounds, const aabb &centroidBounds, size_t &axis, float &position) const {
+    struct Bin {
+        aabb        bounds;
+        uint32_t    count { 0 };
+    };
+
+    float   bestCost = float(count) * bounds.GetSurfaceArea();
+    bool    found    = false;
+
+    for(size_t a = 0; a < 3; ++a) {
+        float   minC   = centroidBounds.min[a];
+        float   maxC   = centroidBounds.max[a];
+        if(maxC <= minC)
+            continue;
+
+        Bin     bins[kNumBins];
+        float   scale = float(kNumBins) / (maxC - minC);
+
+        for(uint32_t i = first; i < first + count; ++i) {
+            const Item  &item = mItems[i];
+            uint32_t    b     = std::min(kNumBins - 1, uint32_t((item.centroid[a] - minC) * scale));
+
+            bins[b].count++;
+            bins[b].bounds.Expand(item.bounds);
+        }
+
+        // Sweep from the right storing the cost, then from the left
+        float       rightArea[kNumBins - 1];
+        uint32_t    rightCount[kNumBins - 1];
+        aabb        box;
+        uint32_t    sum = 0;
+        for(uint32_t b = kNumBins - 1; b > 0; --b) {
+            box.Expand(bins[b].bounds);
+            sum += bins[b].count;
+            rightArea[b - 1]  = box.GetSurfaceArea();
+            rightCount[b - 1] = sum;
+        }
+
+        box.Reset();
+        sum = 0;
+        for(uint32_t b = 0; b < kNumBins - 1; ++b) {
+            box.Expand(bins[b].bounds);
+            sum += bins[b].count;
+
+            float cost = float(sum) * box.GetSurfaceArea() + float(rightCount[b]) * rightArea[b];
+            if(sum > 0 && rightCount[b] > 0 && cost < bestCost) {
+                bestCost = cost;
+                axis     = a;
+                position = minC + float(b + 1) / scale;
+                found    = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+//-------------------------------------
+// Walks up from the leaf of each moved mesh and stops at the first node whose
+// box does not change: its ancestors can not change either
+//-------------------------------------
+bool
+CBVH::Refit(const vector<CMesh *> &moved) {
+    bool    refitted = false;
+
+    for(CMesh *mesh : moved) {
+        uint32_t itemIndex = GetItemIndex(mesh);
+        if(itemIndex == kNone)
+            continue;
+
+        Item &item = mItems[itemIndex];
+        item.bounds   = mesh->GetWorldBounds();
+        item.centroid = item.bounds.GetCenter();
+        mItemBounds.Set(itemIndex, item.bounds);
+        ClearMoved(mesh);
+        refitted = true;
+
+        for(uint32_t nodeIndex = mLeafOfItem[itemIndex]; nodeIndex != kNone; nodeIndex = mParents[nodeIndex]) {
+            Node    &node = mNodes[nodeIndex];
+            aabb    bounds;
+
+            if(node.IsLeaf()) {
+                for(uint32_t j = node.first; j < node.first + node.count; ++j) {
+                    bounds.Expand(mItems[j].bounds);
+                }
+            }
+            else {
+                bounds.Expand(mNodes[node.first].bounds);
+                bounds.Expand(mNodes[node.first + 1].bounds);
+            }
+
+            if(bounds == node.bounds)
+                break;
+
+            mAreaSum   += (double(bounds.GetSurfaceArea()) - double(node.bounds.GetSurfaceArea())) * (node.IsLeaf() ? double(node.count) : 1.0);
+            node.bounds = bounds;
+        }
+    }
+
+    return refitted;
+}
+
+//-------------------------------------
+uint32_t
+CBVH::GetItemIndex(const CMesh *mesh) const {
+    uint32_t slot = mesh->GetHandle().GetIndex();
+
+    if(slot >= mItemOfSlot.size())
+        return kNone;
+
+    uint32_t itemIndex = mItemOfSlot[slot];
+    if(itemIndex == kNone || mItems[itemIndex].pMesh != mesh)
+        return kNone;
+
+    return itemIndex;
+}
+
+//-------------------------------------
+double
+CBVH::ComputeAreaSum() const {
+    double  sum = 0.0;
+
+    for(const Node &node : mNodes) {
+        double area = node.bounds.GetSurfaceArea();
+        sum += node.IsLeaf() ? area * double(node.count) : area;
+    }
+
+    return sum;
+}
+
+//-------------------------------------
+float
+CBVH::ComputeSAHCost() const {
+    if(mNodes.empty())
+        return 0.0f;
+
+    float rootArea = mNodes[0].bounds.GetSurfaceArea();
+
+    return (rootArea > 0.0f) ? float(mAreaSum / rootArea) : 0.0f;
+}
+
+//-------------------------------------
+void
+CBVH::Update(const vector<CMesh *> &meshes, const vector<CMesh *> &moved) {
+    if(mIsDirty) {
+        Build(meshes);
+        return;
+    }
+
+    if(moved.empty() == false && Refit(moved)) {
+        mCost = ComputeSAHCost();
+        if(mCost > mBuildCost * mRebuildThreshold) {
+            Build(meshes);
+        }
+    }
+}
+
+//-------------------------------------
+void
+CBVH::QueryFrustum(const plane *planes, size_t numPlanes, vector<CMesh *> &result) const {
+    // Node index + the planes its box straddles (the ones its children still need to test)
+    struct Entry {
+        uint32_t    node;
+        uint32_t    mask;
+    };
+    Entry           stack[kMaxDepth + 1];
+    size_t          top = 0;
+    frustumCuller   culler(planes, numPlanes);
+    const uint32_t  kBatch = 64;
+    uint32_t        visible[kBatch];
+
+    if(mNodes.empty())
+        return;
+
+    stack[top++] = { 0, culler.GetAllPlanesMask() };
+    while(top > 0) {
+        Entry       entry = stack[--top];
+        const Node  &node = mNodes[entry.node];
+
+        if(entry.mask != 0 && culler.TestAABB(node.bounds, entry.mask) == false)
+            continue;
+
+        if(node.IsLeaf()) {
+            if(entry.mask == 0) {
+                for(uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    result.push_back(mItems[i].pMesh);
+                }
+                continue;
+            }
+
+            // The items of a leaf are contiguous: test them in batches
+            for(uint32_t first = node.first; first < node.first + node.count; first += kBatch) {
+                size_t count      = std::min(node.first + node.count - first, kBatch);
+                size_t numVisible = culler.CullAABBs(mItemBounds.GetView().GetOffset(first), count, entry.mask, visible);
+
+                for(size_t i = 0; i < numVisible; ++i) {
+                    result.push_back(mItems[first + visible[i]].pMesh);
+                }
+            }
+        }
+        else {
+            stack[top++] = { node.first,     entry.mask };
+            stack[top++] = { node.first + 1, entry.mask };
+        }
+    }
+}
+
+//-------------------------------------
+void
+CBVH::QuerySphere(const vec3 &center, float radius, vector<CMesh *> &result) const {
+    uint32_t    stack[kMaxDepth + 1];
+    size_t      top = 0;
+    float       radius2 = radius * radius;
+
+    if(mNodes.empty())
+        return;
+
+    stack[top++] = 0;
+    while(top > 0) {
+        const Node &node = mNodes[stack[--top]];
+
+        if(node.bounds.GetSquaredDistance(center) > radius2)
+            continue;
+
+        if(node.IsLeaf()) {
+            for(uint32_t i = node.first; i < node.first + node.count; ++i) {
+                if(mItems[i].bounds.GetSquaredDistance(center) <= radius2)
+                    result.push_back(mItems[i].pMesh);
+            }
+        }
+        else {
+            stack[top++] = node.first;
+            stack[top++] = node.first + 1;
+        }
+    }
+}
+
+//-------------------------------------
+void
+CBVH::QueryAABB(const aabb &box, vector<CMesh *> &result) const {
+    uint32_t    stack[kMaxDepth + 1];
+    size_t      top = 0;
+
+    if(mNodes.empty())
+        return;
+
+    stack[top++] = 0;
+    while(top > 0) {
+        const Node &node = mNodes[stack[--top]];
+
+        if(node.bounds.Intersects(box) == false)
+            continue;
+
+        if(node.IsLeaf()) {
+            for(uint32_t i = node.first; i < node.first + node.count; ++i) {
+                if(mItems[i].bounds.Intersects(box))
+                    result.push_back(mItems[i].pMesh);
+            }
+        }
+        else {
+            stack[top++] = node.first;
+            stack[top++] = node.first + 1;
+        }
+    }
+}
+
+//-------------------------------------
+CMesh *
+CBVH::RayCast(const vec3 &origin, const vec3 &direction, float maxDistance, float *pDistance) const {
+    uint32_t    stack[kMaxDepth + 1];
+    size_t      top = 0;
+    CMesh       *pBest = nullptr;
+    float       best = maxDistance;
+    float       tNear, tLeft, tRight;
+    vec3        invDir;
+
+    if(mNodes.empty())
+        return nullptr;
+
+    invDir.x = (direction.x != 0.0f) ? 1.0f / direction.x : MindShake::Float32::POS_INFINITY;
+    invDir.y = (direction.y != 0.0f) ? 1.0f / direction.y : MindShake::Float32::POS_INFINITY;
+    invDir.z = (direction.z != 0.0f) ? 1.0f / direction.z : MindShake::Float32::POS_INFINITY;
+
+    if(mNodes[0].bounds.IntersectsRay(origin, invDir, best, tNear) == false)
+        return nullptr;
+
+    stack[top++] = 0;
+    while(top > 0) {
+        const Node &node = mNodes[stack[--top]];
+
+        if(node.IsLeaf()) {
+            for(uint32_t i = node.first; i < node.first + node.count; ++i) {
+                if(mItems[i].bounds.IntersectsRay(origin, invDir, best, tNear) && tNear < best) {
+                    best  = tNear;
+                    pBest = mItems[i].pMesh;
+                }
+            }
+            continue;
+        }
+
+        // Visit the nearest child first so the farther one is more likely to be pruned
+        bool hitLeft  = mNodes[node.first].bounds.IntersectsRay(origin, invDir, best, tLeft);
+        bool hitRight = mNodes[node.first + 1].bounds.IntersectsRay(origin, invDir, best, tRight);
+        if(hitLeft && hitRight) {
+            if(tLeft <= tRight) {
+                stack[top++] = node.first + 1;
+                stack[top++] = node.first;
+            }
+            else {
+                stack[top++] = node.first;
+                stack[top++] = node.first + 1;
+            }
+        }
+        else if(hitLeft) {
+            stack[top++] = node.first;
+        }
+        else if(hitRight) {
+            stack[top++] = node.first + 1;
+        }
+    }
+
+    if(pBest != nullptr && pDistance != nullptr)
+        *pDistance = best;
+
+    return pBest;
+}
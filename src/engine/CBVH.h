@@ -0,0 +1,84 @@
+#pragma once
+
+#include <engine/CSpatialIndex.h>
+
+//-------------------------------------
+// Bounding volume hierarchy over the world bounds of the meshes.
+// Built with binned SAH (surface area heuristic). Moved meshes only refit
+// their leaf and the ancestors whose box changes, so a refit costs moved
+// meshes * depth at most. The tree is rebuilt when the SAH cost grows past
+// RebuildThreshold times the cost it had after the last build, or when
+// meshes are added / removed.
+//-------------------------------------
+class CBVH : public CSpatialIndex {
+public:
+    void                Build(const vector<CMesh *> &meshes) override;
+    // Refits the moved meshes (and rebuilds if quality degraded)
+    void                Update(const vector<CMesh *> &meshes, const vector<CMesh *> &moved) override;
+    // Membership changes need a rebuild
+    void                Insert(CMesh *)                     override { mIsDirty = true;     }
+    void                Remove(CMesh *)                     override { mIsDirty = true;     }
+    void                Clear() override;
+
+    void                QueryFrustum(const plane *planes, size_t numPlanes, vector<CMesh *> &result) const override;
+    void                QuerySphere(const vec3 &center, float radius, vector<CMesh *> &result) const override;
+    void                QueryAABB(const aabb &box, vector<CMesh *> &result) const override;
+    CMesh *             RayCast(const vec3 &origin, const vec3 &direction, float maxDistance, float *pDistance = nullptr) const override;
+
+    void                SetRebuildThreshold(float ratio)    { mRebuildThreshold = ratio;    }
+    float               GetRebuildThreshold() const         { return mRebuildThreshold;     }
+    float               GetSAHCost() const                  { return mCost;                 }
+    float               GetBuildSAHCost() const             { return mBuildCost;            }
+    size_t              GetNumNodes() const                 { return mNodes.size();         }
+    size_t              GetNumRebuilds() const              { return mNumRebuilds;          }
+    const aabb &        GetBounds() const                   { return mNodes.empty() ? kEmptyBounds : mNodes[0].bounds; }
+
+protected:
+    // Leaves have count > 0 and own mItems[first, first + count).
+    // Inner nodes have count == 0 and their children at first and first + 1.
+    // Children always have a greater index than their parent.
+    struct Node {
+        aabb        bounds;
+        uint32_t    first { 0 };
+        uint32_t    count { 0 };
+
+        bool        IsLeaf() const                          { return count > 0;             }
+    };
+
+    struct Item {
+        CMesh       *pMesh;
+        aabb        bounds;
+        vec3        centroid;
+    };
+
+    void                Subdivide(uint32_t nodeIndex, uint32_t parent, uint32_t first, uint32_t count, uint32_t depth);
+    bool                FindSplit(uint32_t first, uint32_t count, const aabb &bounds, const aabb &centroidBounds, size_t &axis, float &position) const;
+    bool                Refit(const vector<CMesh *> &moved);
+    uint32_t            GetItemIndex(const CMesh *mesh) const;
+    // Sum of the node areas, weighted by their number of items for the leaves
+    double              ComputeAreaSum() const;
+    float               ComputeSAHCost() const;
+
+protected:
+    static const uint32_t   kMaxLeafItems = 4;
+    static const uint32_t   kNumBins      = 12;
+    // Below this depth only median splits are done, so the tree depth (and the
+    // query stacks) stay under kMaxDepth for any input
+    static const uint32_t   kMaxSAHDepth  = 32;
+    static const uint32_t   kMaxDepth     = 64;
+    static constexpr uint32_t kNone       = 0xffffffff;
+    static const aabb       kEmptyBounds;
+
+    aligned_vector<Node> mNodes;
+    aligned_vector<Item> mItems;
+    aabbArraySoA         mItemBounds;        // mItems[i].bounds for the batch frustum test
+    vector<uint32_t>     mParents;           // Parent of each node (kNone for the root)
+    vector<uint32_t>     mLeafOfItem;        // Leaf of each item
+    vector<uint32_t>     mItemOfSlot;        // Item index by handle index
+
+    float               mRebuildThreshold { 1.5f };
+    float               mBuildCost        { 0.0f };
+    float               mCost             { 0.0f };
+    double              mAreaSum          { 0.0 };      // ComputeAreaSum, kept up to date by Refit
+    size_t              mNumRebuilds      { 0 };
+};
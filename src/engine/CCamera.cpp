@@ -12,7 +12,7 @@ CCamera::GetViewMatrix() {
         CSceneNode::GetMatrixWorld();
         mIsDirtyView = false;
 
-        mView = mMatrixWorld.GetInverseAffine();
+        mView = mMatrixWorld.GetInverse();
     }
 
     return mView;
@@ -38,6 +38,7 @@ CCamera::GetViewProjectionMatrix() {
 
     if (mIsDirtyTransform || mIsDirtyProjection || mIsDirtyViewProjection) {
         mIsDirtyViewProjection = false;
+        mIsDirtyFrustum        = true;
 
         mViewProjection = GetProjectionMatrix() * GetViewMatrix();
     }
@@ -46,7 +47,7 @@ CCamera::GetViewProjectionMatrix() {
 }
 
 //-------------------------------------
-const mat4 &
+const mat3x4 &
 CCamera::GetMatrixWorld() {
 
     if (IsDirtyTransformWorld()) {
@@ -57,57 +58,70 @@ CCamera::GetMatrixWorld() {
     return mMatrixWorld;
 }
 
+// Gribb & Hartmann: planes are combinations of the view projection rows
+//-------------------------------------
+const plane *
+CCamera::GetFrustumPlanes() {
+    const mat4 &vp = GetViewProjectionMatrix();
+
+    if (mIsDirtyFrustum) {
+        mIsDirtyFrustum = false;
+
+        auto row = [&vp](size_t r, size_t c) { return vp[c][r]; };
+        for (size_t i = 0; i < 4; ++i) {
+            size_t  r    = i >> 1;
+            float   sign = (i & 1) ? -1.0f : 1.0f;
+
+            mFrustumPlanes[i].Set(row(3, 0) + sign * row(r, 0),
+                                  row(3, 1) + sign * row(r, 1),
+                                  row(3, 2) + sign * row(r, 2),
+                                  row(3, 3) + sign * row(r, 3));
+        }
+        // Reverse Z: z <= w
+        mFrustumPlanes[4].Set(row(3, 0) - row(2, 0), row(3, 1) - row(2, 1), row(3, 2) - row(2, 2), row(3, 3) - row(2, 3));
+
+        for (plane &p : mFrustumPlanes) {
+            p.Normalize();
+        }
+    }
+
+    return mFrustumPlanes;
+}
+
 //-------------------------------------
 void
 CCamera::LookAt(const vec3 &target, const vec3 &up) {
-#if 0
-    mView = mat4::InverseLookAt(CSceneNode::GetMatrixWorld().GetTranslation(), target, up);
-    mIsDirtyView = false;
-    mIsDirtyViewProjection = true;
-
-    // The user must or use LookAt or use Euler angles, but not both
-    CVector3 angles;
-    mView.Extract3x3Matrix().GetTransposed().ToEulerAnglesXYZ(angles.x, angles.y, angles.z);
-    angles *= Float32::RADTODEG;
-    SetRotation(angles);
-#else
-    CVector3 angles;
+    // Straight to the orientation, no round trip through Euler angles
     mat4 mat = mat4::LookAt(CSceneNode::GetMatrixWorld().GetTranslation(), target, up);
-    mat.Extract3x3Matrix().ToEulerAnglesXYZ(angles.x, angles.y, angles.z);
-    angles *= Float32::RADTODEG;
-    SetRotation(angles);
-#endif
+    SetOrientation(quat(mat.Extract3x3Matrix()));
 }
 
 //-------------------------------------
 vec3
 CCamera::Project(const vec3& pos) {
-    mat4    mvp;
-    vec4    tmp;
     vec3    out;
 
-    mvp = GetViewProjectionMatrix();
-
-    // Clip coordinates
-    tmp = mvp * vec4(pos, 1);
-    if (tmp.w != 0) {
-        float invW = 1.0f / tmp.w;
-
-        // Normalized Device Coordinates (NDC)
-        out = vec3(tmp.x * invW, tmp.y * invW, tmp.z * invW);
-
-        // Window Coordinates (Screen Coordinates)
-        out.x = (out.x + 1) * (mViewportWidth  * 0.5f) + mViewportX;
-        out.y = (out.y + 1) * (mViewportHeight * 0.5f) + mViewportY;
-        // let Z as z/w
-    }
-    else {
-        out.Set(0, 0, Float32::POS_INFINITY);
-    }
+    Project(&pos, &out, 1);
 
     return out;
 }
 
+//-------------------------------------
+void
+CCamera::Project(const vec3 *in, vec3 *out, size_t count) {
+    float   halfWidth  = mViewportWidth  * 0.5f;
+    float   halfHeight = mViewportHeight * 0.5f;
+
+    // NDC to window coordinates folded into the matrix (let Z as z/w)
+    mat4    screen(halfWidth,               0,                        0, 0,
+                   0,                       halfHeight,               0, 0,
+                   0,                       0,                        1, 0,
+                   halfWidth + mViewportX,  halfHeight + mViewportY,  0, 1);
+
+    // Points with w == 0 get (0, 0, +inf)
+    (screen * GetViewProjectionMatrix()).TransformPointsDivide(in, out, count);
+}
+
 //-------------------------------------
 vec3
 CCamera::UnProject(const vec3 &pos) {
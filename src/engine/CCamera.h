@@ -4,8 +4,14 @@
 
 //-------------------------------------
 class CCamera : public CSceneNode {
+    friend class CSceneManager;
+
+public:
+    // The reverse Z projection has no far plane
+    static const size_t kNumFrustumPlanes = 5;
+
 public:
-                        CCamera()                           = default;
+                        CCamera()                           { mType = ENodeType::Camera; }
     virtual             ~CCamera()                          = default;
 
     void                SetFOV(float angle)                 { SetDirtyTransformProjection(); mFOV = angle; }
@@ -30,7 +36,10 @@ public:
     const mat4 &        GetViewMatrix();
     const mat4 &        GetProjectionMatrix();
     const mat4 &        GetViewProjectionMatrix();
-    const mat4 &        GetMatrixWorld() override;
+    const mat3x4 &      GetMatrixWorld() override;
+
+    // World space, normals pointing inside: left, right, bottom, top, near
+    const plane *       GetFrustumPlanes();
 
     void                SetDirtyTransformView()             { mIsDirtyViewProjection = true; mIsDirtyView = true;          }
     bool                IsDirtyTransformView() const        { return mIsDirtyView;          }
@@ -41,11 +50,15 @@ public:
     void                LookAt(const vec3 &target, const vec3 &up = vec3(0, -1, 0));
 
     vec3                Project(const vec3& pos);
+    void                Project(const vec3 *in, vec3 *out, size_t count);    // in and out must not overlap
     vec3                UnProject(const vec3 &pos);
 
+protected:
+    void                OnMatrixWorldChanged() override     { SetDirtyTransformView();  }
+
 private:
                         CCamera(const CCamera &)   = delete;
-                        CCamera(CCamera &&)        = delete;
+                        CCamera(CCamera &&)        = default;
 
     CCamera &           operator=(const CCamera &) = delete;
     CCamera &           operator=(CCamera &&)      = delete;
@@ -54,6 +67,7 @@ private:
     mat4        mView           { mat4::kIDENTITY };
     mat4        mProjection     { mat4::kIDENTITY };
     mat4        mViewProjection { mat4::kIDENTITY };
+    plane       mFrustumPlanes[kNumFrustumPlanes];
 
     float       mFOV            { 45 };
     float       mAspectRatio    { 4.0f / 3.0f };
@@ -68,6 +82,7 @@ private:
     bool        mIsDirtyView           { true };
     bool        mIsDirtyProjection     { true };
     bool        mIsDirtyViewProjection { true };
+    bool        mIsDirtyFrustum        { true };
 };
 
 //-------------------------------------
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+//-------------------------------------
+class CSceneNode;
+class CMesh;
+class CCamera;
+class CLight;
+
+//-------------------------------------
+// Generational handle: index into the CSceneManager handle table plus the
+// generation the slot had when the handle was issued. A handle whose
+// generation does not match the slot is stale and resolves to nullptr.
+// 32 bits: 20 index bits (1M objects) + 12 generation bits
+// 64 bits: 32 index bits + 32 generation bits
+// Value 0 is always invalid (generations start at 1).
+//-------------------------------------
+template <typename T, typename TValue = uint32_t>
+class CHandle {
+    static_assert(std::is_same<TValue, uint32_t>::value || std::is_same<TValue, uint64_t>::value, "Handles must be 32 or 64 bits");
+
+    template <typename, typename> friend class CHandle;
+
+public:
+    using value_type = TValue;
+
+    static constexpr uint32_t kIndexBits      = (sizeof(TValue) == 8) ? 32 : 20;
+    static constexpr uint32_t kGenerationBits = (sizeof(TValue) * 8) - kIndexBits;
+    static constexpr TValue   kIndexMask      = (TValue(1) << kIndexBits) - 1;
+    static constexpr TValue   kGenerationMask = (TValue(1) << kGenerationBits) - 1;
+    static constexpr uint32_t kMaxIndex       = uint32_t(kIndexMask);
+
+public:
+    constexpr           CHandle()                                       = default;
+    constexpr           CHandle(uint32_t index, uint32_t generation)    : mValue((TValue(generation) & kGenerationMask) << kIndexBits | (TValue(index) & kIndexMask)) { }
+
+    // Allow CHandle<CMesh> -> CHandle<CSceneNode>
+    template <typename U, typename = typename std::enable_if<std::is_base_of<T, U>::value>::type>
+    constexpr           CHandle(const CHandle<U, TValue> &other)        : mValue(other.mValue) { }
+
+    // Retypes the handle (ie. NodeHandle -> MeshHandle). Not checked here:
+    // CSceneManager::Resolve returns nullptr if the node is of another type
+    template <typename U>
+    constexpr CHandle<U, TValue> Cast() const                           { CHandle<U, TValue> r; r.mValue = mValue; return r;          }
+
+    constexpr uint32_t  GetIndex() const                                { return uint32_t(mValue & kIndexMask);                         }
+    constexpr uint32_t  GetGeneration() const                           { return uint32_t((mValue >> kIndexBits) & kGenerationMask);   }
+    constexpr TValue    GetValue() const                                { return mValue;                                                }
+
+    constexpr bool      IsNull() const                                  { return mValue == 0;                                           }
+    explicit constexpr  operator bool() const                           { return mValue != 0;                                           }
+
+    constexpr bool      operator == (const CHandle &other) const        { return mValue == other.mValue;                                }
+    constexpr bool      operator != (const CHandle &other) const        { return mValue != other.mValue;                                }
+
+    // Keeps a generation inside the representable range, skipping 0
+    static constexpr uint32_t NextGeneration(uint32_t generation)       { return (uint32_t((generation + 1) & kGenerationMask) == 0) ? 1 : uint32_t((generation + 1) & kGenerationMask); }
+
+protected:
+    TValue      mValue { 0 };
+};
+
+//-------------------------------------
+// Live scene objects are limited by the index bits: 2^20 (1M) with 32 bit
+// handles, 2^32 with ENGINE_USE_64BIT_HANDLES. Past that the Create*
+// functions of CSceneManager return a null handle
+//-------------------------------------
+#if defined(ENGINE_USE_64BIT_HANDLES)
+    using HandleValue = uint64_t;
+#else
+    using HandleValue = uint32_t;
+#endif
+
+using NodeHandle   = CHandle<CSceneNode, HandleValue>;
+using MeshHandle   = CHandle<CMesh,      HandleValue>;
+using CameraHandle = CHandle<CCamera,    HandleValue>;
+using LightHandle  = CHandle<CLight,     HandleValue>;
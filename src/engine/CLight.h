@@ -11,4 +11,12 @@ enum class ELightType {
 
 //-------------------------------------
 class CLight : public CSceneNode {
+    friend class CSceneManager;
+
+public:
+                        CLight()                            { mType = ENodeType::Light; }
+    virtual             ~CLight()                           = default;
+
+protected:
+                        CLight(CLight &&)                   = default;
 };
\ No newline at end of file
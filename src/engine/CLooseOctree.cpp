@@ -0,0 +1,410 @@
+#include "CLooseOctree.h"
+//-------------------------------------
+#include <engine/CMesh.h>
+//-------------------------------------
+#include <algorithm>
+
+//-------------------------------------
+void
+CLooseOctree::SetWorldBounds(const vec3 &center, float halfSize) {
+    mCenter   = center;
+    mHalfSize = halfSize;
+    mIsDirty  = true;
+}
+
+//-------------------------------------
+void
+CLooseOctree::SetNumLevels(uint32_t numLevels) {
+    mNumLevels = std::min(std::max(numLevels, 1u), kMaxLevels);
+    mIsDirty   = true;
+}
+
+//-------------------------------------
+void
+CLooseOctree::Allocate() {
+    uint32_t    total = 0;
+
+    for(uint32_t level = 0; level < mNumLevels; ++level) {
+        uint32_t dim = 1u << level;
+
+        mLevelOffset[level] = total;
+        total += dim * dim * dim;
+    }
+    mLevelOffset[mNumLevels] = total;
+
+    mCells.assign(total, Cell());
+    for(uint32_t level = 1; level < mNumLevels; ++level) {
+        uint32_t dim = 1u << level;
+
+        for(uint32_t z = 0; z < dim; ++z) {
+            for(uint32_t y = 0; y < dim; ++y) {
+                for(uint32_t x = 0; x < dim; ++x) {
+                    mCells[GetCellIndex({ level, x, y, z })].parent = GetCellIndex({ level - 1, x >> 1, y >> 1, z >> 1 });
+                }
+            }
+        }
+    }
+}
+
+//-------------------------------------
+void
+CLooseOctree::Clear() {
+    mCells.clear();
+    mOutside = Cell();
+    mItems.clear();
+    mFreeItems.clear();
+    mItemOfSlot.clear();
+    mNumItems = 0;
+    mIsDirty  = true;
+}
+
+//-------------------------------------
+void
+CLooseOctree::Build(const vector<CMesh *> &meshes) {
+    Clear();
+    Allocate();
+    mIsDirty = false;
+
+    mItems.reserve(meshes.size());
+    for(CMesh *mesh : meshes) {
+        Insert(mesh);
+    }
+}
+
+//-------------------------------------
+void
+CLooseOctree::Update(const vector<CMesh *> &meshes, const vector<CMesh *> &moved) {
+    if(mIsDirty) {
+        Build(meshes);
+        return;
+    }
+
+    for(CMesh *mesh : moved) {
+        // The same mesh can be queued twice if the index was rebuilt meanwhile
+        if(mesh->IsMoved() == false)
+            continue;
+
+        uint32_t itemIndex = GetItemIndex(mesh);
+        if(itemIndex == kNone)
+            continue;
+
+        Item &item = mItems[itemIndex];
+        item.bounds = mesh->GetWorldBounds();
+        ClearMoved(mesh);
+
+        uint32_t cellIndex = FindCell(item.bounds);
+        if(cellIndex != item.cell) {
+            Unlink(itemIndex);
+            Link(itemIndex, cellIndex);
+        }
+    }
+}
+
+//-------------------------------------
+void
+CLooseOctree::Insert(CMesh *mesh) {
+    uint32_t    itemIndex;
+    uint32_t    slot;
+
+    // Build will add it
+    if(mIsDirty)
+        return;
+
+    if(mFreeItems.empty() == false) {
+        itemIndex = mFreeItems.back();
+        mFreeItems.pop_back();
+    }
+    else {
+        itemIndex = uint32_t(mItems.size());
+        mItems.emplace_back();
+    }
+
+    slot = mesh->GetHandle().GetIndex();
+    if(slot >= mItemOfSlot.size()) {
+        mItemOfSlot.resize(slot + 1, kNone);
+    }
+    mItemOfSlot[slot] = itemIndex;
+
+    Item &item = mItems[itemIndex];
+    item.pMesh  = mesh;
+    item.bounds = mesh->GetWorldBounds();
+    ClearMoved(mesh);
+
+    Link(itemIndex, FindCell(item.bounds));
+    ++mNumItems;
+}
+
+//-------------------------------------
+void
+CLooseOctree::Remove(CMesh *mesh) {
+    if(mIsDirty)
+        return;
+
+    uint32_t itemIndex = GetItemIndex(mesh);
+    if(itemIndex == kNone)
+        return;
+
+    Unlink(itemIndex);
+    mItems[itemIndex].pMesh = nullptr;
+    mItemOfSlot[mesh->GetHandle().GetIndex()] = kNone;
+    mFreeItems.push_back(itemIndex);
+    --mNumItems;
+}
+
+//-------------------------------------
+uint32_t
+CLooseOctree::GetItemIndex(const CMesh *mesh) const {
+    uint32_t slot = mesh->GetHandle().GetIndex();
+
+    if(slot >= mItemOfSlot.size())
+        return kNone;
+
+    uint32_t itemIndex = mItemOfSlot[slot];
+    if(itemIndex == kNone || mItems[itemIndex].pMesh != mesh)
+        return kNone;
+
+    return itemIndex;
+}
+
+//-------------------------------------
+uint32_t
+CLooseOctree::GetCellIndex(const CellCoord &coord) const {
+    uint32_t dim = 1u << coord.level;
+
+    return mLevelOffset[coord.level] + (coord.z * dim + coord.y) * dim + coord.x;
+}
+
+// With looseness 2 an object fits in any cell of half size >= its radius
+// that contains its center, so the level comes from the size and the cell
+// from the center.
+//-------------------------------------
+uint32_t
+CLooseOctree::FindCell(const aabb &bounds) const {
+    vec3        extents = bounds.GetExtents();
+    vec3        rel     = bounds.GetCenter() - (mCenter - mHalfSize);
+    float       radius  = std::max(extents.x, std::max(extents.y, extents.z));
+    float       size    = mHalfSize * 2.0f;
+    float       half    = mHalfSize;
+    uint32_t    level   = 0;
+
+    if(radius > mHalfSize ||
+       rel.x < 0.0f || rel.y < 0.0f || rel.z < 0.0f ||
+       rel.x >= size || rel.y >= size || rel.z >= size) {
+        return kOutside;
+    }
+
+    while(level + 1 < mNumLevels && radius <= half * 0.5f) {
+        half *= 0.5f;
+        ++level;
+    }
+
+    uint32_t    dim     = 1u << level;
+    float       invCell = 1.0f / (half * 2.0f);
+    CellCoord   coord;
+
+    coord.level = level;
+    coord.x     = std::min(dim - 1, uint32_t(rel.x * invCell));
+    coord.y     = std::min(dim - 1, uint32_t(rel.y * invCell));
+    coord.z     = std::min(dim - 1, uint32_t(rel.z * invCell));
+
+    return GetCellIndex(coord);
+}
+
+//-------------------------------------
+aabb
+CLooseOctree::GetLooseBounds(const CellCoord &coord) const {
+    float   half   = mHalfSize / float(1u << coord.level);
+    vec3    center = mCenter - mHalfSize;
+
+    center.x += (float(coord.x) * 2.0f + 1.0f) * half;
+    center.y += (float(coord.y) * 2.0f + 1.0f) * half;
+    center.z += (float(coord.z) * 2.0f + 1.0f) * half;
+
+    return aabb(center - half * 2.0f, center + half * 2.0f);
+}
+
+//-------------------------------------
+void
+CLooseOctree::Link(uint32_t itemIndex, uint32_t cellIndex) {
+    Item    &item = mItems[itemIndex];
+    Cell    &cell = GetCell(cellIndex);
+
+    item.cell = cellIndex;
+    item.prev = kNone;
+    item.next = cell.first;
+    if(cell.first != kNone) {
+        mItems[cell.first].prev = itemIndex;
+    }
+    cell.first = itemIndex;
+
+    for(uint32_t c = cellIndex; c != kNone; c = GetCell(c).parent) {
+        GetCell(c).count++;
+    }
+}
+
+//-------------------------------------
+void
+CLooseOctree::Unlink(uint32_t itemIndex) {
+    Item    &item = mItems[itemIndex];
+    Cell    &cell = GetCell(item.cell);
+
+    if(item.prev != kNone)
+        mItems[item.prev].next = item.next;
+    else
+        cell.first = item.next;
+
+    if(item.next != kNone)
+        mItems[item.next].prev = item.prev;
+
+    for(uint32_t c = item.cell; c != kNone; c = GetCell(c).parent) {
+        GetCell(c).count--;
+    }
+
+    item.cell = kNone;
+    item.prev = kNone;
+    item.next = kNone;
+}
+
+//-------------------------------------
+template <typename Visitor>
+void
+CLooseOctree::VisitCellItems(const Cell &cell, Visitor &visitor) const {
+    for(uint32_t i = cell.first; i != kNone; i = mItems[i].next) {
+        visitor(mItems[i]);
+    }
+}
+
+//-------------------------------------
+template <typename CellTest, typename Visitor>
+void
+CLooseOctree::Traverse(const CellCoord &coord, CellTest &cellTest, Visitor &visitor) const {
+    const Cell &cell = mCells[GetCellIndex(coord)];
+
+    if(cell.count == 0 || cellTest(GetLooseBounds(coord)) == false)
+        return;
+
+    VisitCellItems(cell, visitor);
+
+    if(coord.level + 1 < mNumLevels) {
+        for(uint32_t i = 0; i < 8; ++i) {
+            CellCoord child { coord.level + 1, (coord.x << 1) | (i & 1), (coord.y << 1) | ((i >> 1) & 1), (coord.z << 1) | (i >> 2) };
+            Traverse(child, cellTest, visitor);
+        }
+    }
+}
+
+//-------------------------------------
+void
+CLooseOctree::TraverseFrustum(const CellCoord &coord, const frustumCuller &culler, uint32_t mask, vector<CMesh *> &result) const {
+    const Cell &cell = mCells[GetCellIndex(coord)];
+
+    if(cell.count == 0 || (mask != 0 && culler.TestAABB(GetLooseBounds(coord), mask) == false))
+        return;
+
+    // Items are inside the loose bounds of their cell: they only test the planes it straddles
+    for(uint32_t i = cell.first; i != kNone; i = mItems[i].next) {
+        uint32_t itemMask = mask;
+        if(itemMask == 0 || culler.TestAABB(mItems[i].bounds, itemMask))
+            result.push_back(mItems[i].pMesh);
+    }
+
+    if(coord.level + 1 < mNumLevels) {
+        for(uint32_t i = 0; i < 8; ++i) {
+            CellCoord child { coord.level + 1, (coord.x << 1) | (i & 1), (coord.y << 1) | ((i >> 1) & 1), (coord.z << 1) | (i >> 2) };
+            TraverseFrustum(child, culler, mask, result);
+        }
+    }
+}
+
+//-------------------------------------
+void
+CLooseOctree::QueryFrustum(const plane *planes, size_t numPlanes, vector<CMesh *> &result) const {
+    frustumCuller   culler(planes, numPlanes);
+    uint32_t        allPlanes = culler.GetAllPlanesMask();
+
+    auto visit = [&culler, allPlanes, &result](const Item &item) {
+        uint32_t mask = allPlanes;
+        if(culler.TestAABB(item.bounds, mask))
+            result.push_back(item.pMesh);
+    };
+
+    if(mCells.empty())
+        return;
+
+    TraverseFrustum({ 0, 0, 0, 0 }, culler, allPlanes, result);
+    VisitCellItems(mOutside, visit);
+}
+
+//-------------------------------------
+void
+CLooseOctree::QuerySphere(const vec3 &center, float radius, vector<CMesh *> &result) const {
+    float   radius2 = radius * radius;
+
+    auto test = [&center, radius2](const aabb &bounds) {
+        return bounds.GetSquaredDistance(center) <= radius2;
+    };
+    auto visit = [&test, &result](const Item &item) {
+        if(test(item.bounds))
+            result.push_back(item.pMesh);
+    };
+
+    if(mCells.empty())
+        return;
+
+    Traverse({ 0, 0, 0, 0 }, test, visit);
+    VisitCellItems(mOutside, visit);
+}
+
+//-------------------------------------
+void
+CLooseOctree::QueryAABB(const aabb &box, vector<CMesh *> &result) const {
+    auto test = [&box](const aabb &bounds) {
+        return bounds.Intersects(box);
+    };
+    auto visit = [&test, &result](const Item &item) {
+        if(test(item.bounds))
+            result.push_back(item.pMesh);
+    };
+
+    if(mCells.empty())
+        return;
+
+    Traverse({ 0, 0, 0, 0 }, test, visit);
+    VisitCellItems(mOutside, visit);
+}
+
+//-------------------------------------
+CMesh *
+CLooseOctree::RayCast(const vec3 &origin, const vec3 &direction, float maxDistance, float *pDistance) const {
+    CMesh   *pBest = nullptr;
+    float   best   = maxDistance;
+    vec3    invDir;
+
+    if(mCells.empty())
+        return nullptr;
+
+    invDir.x = (direction.x != 0.0f) ? 1.0f / direction.x : MindShake::Float32::POS_INFINITY;
+    invDir.y = (direction.y != 0.0f) ? 1.0f / direction.y : MindShake::Float32::POS_INFINITY;
+    invDir.z = (direction.z != 0.0f) ? 1.0f / direction.z : MindShake::Float32::POS_INFINITY;
+
+    // Cells farther than the best hit so far are skipped
+    auto test = [&origin, &invDir, &best](const aabb &bounds) {
+        float tNear;
+        return bounds.IntersectsRay(origin, invDir, best, tNear);
+    };
+    auto visit = [&origin, &invDir, &best, &pBest](const Item &item) {
+        float tNear;
+        if(item.bounds.IntersectsRay(origin, invDir, best, tNear) && tNear < best) {
+            best  = tNear;
+            pBest = item.pMesh;
+        }
+    };
+
+    Traverse({ 0, 0, 0, 0 }, test, visit);
+    VisitCellItems(mOutside, visit);
+
+    if(pBest != nullptr && pDistance != nullptr)
+        *pDistance = best;
+
+    return pBest;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <engine/CSpatialIndex.h>
+
+//-------------------------------------
+// Loose octree (looseness 2) over the world bounds of the meshes.
+// Cells are stored densely per level, so the cell of an object is computed
+// directly from its center and size: inserting, removing or moving a mesh is
+// O(1) (plus updating the occupancy counters of its ancestors). Meant for
+// scenes where many objects move every frame and a BVH refit degrades.
+// Objects outside the world bounds are kept in a list tested by every query.
+//-------------------------------------
+class CLooseOctree : public CSpatialIndex {
+public:
+    static constexpr uint32_t kMaxLevels = 7;
+
+public:
+    // Changing the world bounds or the number of levels rebuilds on the next update
+    void                SetWorldBounds(const vec3 &center, float halfSize);
+    void                SetNumLevels(uint32_t numLevels);
+
+    const vec3 &        GetWorldCenter() const              { return mCenter;               }
+    float               GetWorldHalfSize() const            { return mHalfSize;             }
+    uint32_t            GetNumLevels() const                { return mNumLevels;            }
+    size_t              GetNumItems() const                 { return mNumItems;             }
+    size_t              GetNumOutside() const               { return mOutside.count;        }
+
+    void                Build(const vector<CMesh *> &meshes) override;
+    // Moves the moved meshes to their new cell
+    void                Update(const vector<CMesh *> &meshes, const vector<CMesh *> &moved) override;
+    void                Insert(CMesh *mesh) override;
+    void                Remove(CMesh *mesh) override;
+    void                Clear() override;
+
+    void                QueryFrustum(const plane *planes, size_t numPlanes, vector<CMesh *> &result) const override;
+    void                QuerySphere(const vec3 &center, float radius, vector<CMesh *> &result) const override;
+    void                QueryAABB(const aabb &box, vector<CMesh *> &result) const override;
+    CMesh *             RayCast(const vec3 &origin, const vec3 &direction, float maxDistance, float *pDistance = nullptr) const override;
+
+protected:
+    static constexpr uint32_t kNone    = 0xffffffff;
+    static constexpr uint32_t kOutside = 0xfffffffe;
+
+    struct Cell {
+        uint32_t    first  { kNone };   // Items of this cell (linked list)
+        uint32_t    count  { 0 };       // Items of this cell and its descendants
+        uint32_t    parent { kNone };
+    };
+
+    struct Item {
+        CMesh       *pMesh { nullptr };
+        aabb        bounds;
+        uint32_t    cell   { kNone };
+        uint32_t    prev   { kNone };
+        uint32_t    next   { kNone };
+    };
+
+    // Cell of a level and its integer coordinates (used while traversing)
+    struct CellCoord {
+        uint32_t    level;
+        uint32_t    x, y, z;
+    };
+
+    void                Allocate();
+    uint32_t            GetCellIndex(const CellCoord &coord) const;
+    uint32_t            FindCell(const aabb &bounds) const;
+    aabb                GetLooseBounds(const CellCoord &coord) const;
+
+    void                Link(uint32_t itemIndex, uint32_t cellIndex);
+    void                Unlink(uint32_t itemIndex);
+    Cell &              GetCell(uint32_t cellIndex)         { return (cellIndex == kOutside) ? mOutside : mCells[cellIndex]; }
+    uint32_t            GetItemIndex(const CMesh *mesh) const;
+
+    // Calls visitor(item) for every item of the cells whose loose bounds pass cellTest(bounds)
+    template <typename CellTest, typename Visitor>
+    void                Traverse(const CellCoord &coord, CellTest &cellTest, Visitor &visitor) const;
+    template <typename Visitor>
+    void                VisitCellItems(const Cell &cell, Visitor &visitor) const;
+    // Frustum traversal with plane coherency: mask holds the planes the parent straddles
+    void                TraverseFrustum(const CellCoord &coord, const frustumCuller &culler, uint32_t mask, vector<CMesh *> &result) const;
+
+protected:
+    vec3                 mCenter     { 0.0f };
+    float                mHalfSize   { 1024.0f };
+    uint32_t             mNumLevels  { 6 };
+    uint32_t             mLevelOffset[kMaxLevels + 1] { };
+
+    aligned_vector<Cell> mCells;
+    Cell                 mOutside;
+
+    aligned_vector<Item> mItems;
+    vector<uint32_t>     mFreeItems;
+    vector<uint32_t>     mItemOfSlot;        // Item index by handle index
+    size_t               mNumItems   { 0 };
+};
@@ -1,50 +1,68 @@
 #include "CMesh.h"
 //-------------------------------------
 #include <engine/CCamera.h>
+#include <engine/CSceneSnapshot.h>
 //-------------------------------------
-#include <Common/Math/constants.h>
 
 using namespace MindShake;
 
 //-------------------------------------
 void
 CMesh::Transform(CCamera &camera) {
-    size_t  i, size;
-    float   viewX, viewY, viewHalfWidth, viewHalfHeight;
+    mat4    mvp = camera.GetViewProjectionMatrix() * GetMatrixWorld();
+
+    TransformVertices(mvp, camera.GetViewportX(), camera.GetViewportY(), camera.GetViewportWidth(), camera.GetViewportHeight());
+}
+
+//-------------------------------------
+void
+CMesh::Transform(const CameraState &camera, const mat3x4 &world) {
+    mat4    mvp = camera.viewProjection * world;
+
+    TransformVertices(mvp, camera.viewportX, camera.viewportY, camera.viewportWidth, camera.viewportHeight);
+}
+
+//-------------------------------------
+void
+CMesh::TransformVertices(const mat4 &mvp, uint32_t viewportX, uint32_t viewportY, uint32_t viewportWidth, uint32_t viewportHeight) {
+    size_t  size;
+    float   viewHalfWidth, viewHalfHeight;
 
-    viewX          = float(camera.GetViewportX());
-    viewY          = float(camera.GetViewportY());
-    viewHalfWidth  = float(camera.GetViewportWidth()  >> 1);
-    viewHalfHeight = float(camera.GetViewportHeight() >> 1);
+    viewHalfWidth  = float(viewportWidth  >> 1);
+    viewHalfHeight = float(viewportHeight >> 1);
+
+    // NDC to window coordinates folded into the matrix: x' = (x / w + 1) * halfWidth + viewX
+    // (let Z as z / w)
+    mat4    screen(viewHalfWidth,                     0,                                  0, 0,
+                   0,                                 viewHalfHeight,                     0, 0,
+                   0,                                 0,                                  1, 0,
+                   viewHalfWidth + float(viewportX),  viewHalfHeight + float(viewportY),  0, 1);
 
     size = mVertexPos.size();
     if(mVertexPosTrans.size() != size)
         mVertexPosTrans.resize(size);
 
-    vec4    aux(1), tmp;
-    mat4    mvp = camera.GetViewProjectionMatrix() * GetMatrixWorld();
-    for(i=0; i<size; ++i) {
-        const vec3 &pos = mVertexPos[i];
-        vec3 &trans = mVertexPosTrans[i];
-
-        aux.x = pos.x;
-        aux.y = pos.y;
-        aux.z = pos.z;
-        // Clip coordinates
-        tmp = mvp * aux;
-        if (tmp.w != 0) {
-            float invW = 1.0f / tmp.w;
-
-            // Normalized Device Coordinates (NDC)
-            trans = vec3(tmp.x * invW, tmp.y * invW, tmp.z * invW);
-
-            // Window Coordinates (Screen Coordinates)
-            trans.x = (trans.x + 1) * viewHalfWidth  + viewX;
-            trans.y = (trans.y + 1) * viewHalfHeight + viewY;
-            // let Z as z/w
+    // Vertices with w == 0 get z = +inf
+    (screen * mvp).TransformPointsDivide(mVertexPos.data(), mVertexPosTrans.data(), size);
+}
+
+//-------------------------------------
+const aabb &
+CMesh::GetLocalBounds() {
+
+    if(mIsDirtyBounds) {
+        mIsDirtyBounds = false;
+
+        mLocalBounds.Reset();
+        for(const vec3 &pos : mVertexPos) {
+            mLocalBounds.Expand(pos);
         }
-        else {
-            trans.z = Float32::POS_INFINITY;
+
+        // Meshes without vertices are treated as a point
+        if(mLocalBounds.IsEmpty()) {
+            mLocalBounds = aabb(vec3(0), vec3(0));
         }
     }
-}
\ No newline at end of file
+
+    return mLocalBounds;
+}
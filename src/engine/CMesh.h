@@ -2,13 +2,20 @@
 
 #include "CSceneNode.h"
 //-------------------------------------
+#include <Core/memory/allocators.h>
+//-------------------------------------
 #include <vector>
 
 //-------------------------------------
 class CCamera;
+struct CameraState;
 
 using std::vector;
 
+// Vertex and index arrays: the big ones get huge pages (see MindShake::LargeMalloc)
+template <typename T>
+using stream_vector = vector<T, MindShake::CLargePageAllocator<T, MindShake::EMemoryTag::Mesh>>;
+
 //-------------------------------------
 struct Edge {
     uint32_t v1, v2;
@@ -16,15 +23,34 @@ struct Edge {
 
 //-------------------------------------
 class CMesh : public CSceneNode {
+    friend class CSceneManager;
+
 public:
+            CMesh()     { mType = ENodeType::Mesh; }
+
     void    Transform(CCamera &camera);
+    // From a snapshot (does not touch the scene node state)
+    void    Transform(const CameraState &camera, const mat3x4 &world);
+
+    // Bounds of mVertexPos. Call SetDirtyBounds after editing the vertices
+    const aabb &    GetLocalBounds();
+    aabb            GetWorldBounds()    { return GetLocalBounds().GetTransformed(GetMatrixWorld()); }
+    void            SetDirtyBounds()    { mIsDirtyBounds = true; MarkMoved(); }
+
+    stream_vector<vec3>     mVertexPos;
+    stream_vector<vec3>     mVertexPosTrans;
+    stream_vector<vec3>     mVertexNormal;
+    stream_vector<vec2>     mVertexTextCoord;
+    stream_vector<uint32_t> mVertexColor;
+
+    stream_vector<int32_t>  mIndices;
+    stream_vector<Edge>     mEdges;
+
+protected:
+            CMesh(CMesh &&) = default;
 
-    vector<vec3>        mVertexPos;
-    vector<vec3>        mVertexPosTrans;
-    vector<vec3>        mVertexNormal;
-    vector<vec2>        mVertexTextCoord;
-    vector<uint32_t>    mVertexColor;
+    void    TransformVertices(const mat4 &mvp, uint32_t viewportX, uint32_t viewportY, uint32_t viewportWidth, uint32_t viewportHeight);
 
-    vector<int32_t>     mIndices;
-    vector<Edge>        mEdges;
+    aabb                mLocalBounds;
+    bool                mIsDirtyBounds { true };
 };
\ No newline at end of file
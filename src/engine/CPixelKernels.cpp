@@ -0,0 +1,772 @@
+#include "CPixelKernels.h"
+//-------------------------------------
+#include <Kernel/cpu/CCpuKernel.h>
+//-------------------------------------
+#include <cstring>
+#include <vector>
+
+using namespace MindShake;
+
+//-------------------------------------
+using FillFunc    = void (*)(uint32_t *dst, uint32_t color, size_t count);
+using StretchFunc = void (*)(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
+                             uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch);
+using TriangleFunc = void (*)(uint32_t *dst, uint32_t pitch, uint32_t width, uint32_t height,
+                              const int32_t edge[3], const int32_t stepX[3], const int32_t stepY[3], uint32_t color);
+
+// Buffers bigger than this do not fit in the cache anyway: the SIMD fills
+// use non temporal stores, so clearing does not evict the rest of the data
+static const size_t kStreamBytes = 256 * 1024;
+
+//-------------------------------------
+// Fill
+//-------------------------------------
+static void
+FillScalar(uint32_t *dst, uint32_t color, size_t count) {
+    for(size_t i = 0; i < count; ++i) {
+        dst[i] = color;
+    }
+}
+
+#if defined(MS_CPU_X86)
+//-------------------------------------
+// Pixels until dst + i is aligned to align bytes (at most count)
+//-------------------------------------
+static inline size_t
+GetAlignedStart(const uint32_t *dst, size_t align, size_t count) {
+    size_t misalign = uintptr_t(dst) & (align - 1);
+    size_t start    = (misalign != 0) ? (align - misalign) / sizeof(uint32_t) : 0;
+
+    return (start < count) ? start : count;
+}
+
+//-------------------------------------
+static void
+FillSSE2(uint32_t *dst, uint32_t color, size_t count) {
+    __m128i value = _mm_set1_epi32(int32_t(color));
+    size_t  i     = GetAlignedStart(dst, 16, count);
+
+    FillScalar(dst, color, i);
+    if(count * sizeof(uint32_t) >= kStreamBytes) {
+        for(; i + 4 <= count; i += 4)
+            _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i), value);
+        _mm_sfence();
+    }
+    else {
+        for(; i + 4 <= count; i += 4)
+            _mm_store_si128(reinterpret_cast<__m128i *>(dst + i), value);
+    }
+    FillScalar(dst + i, color, count - i);
+}
+
+//-------------------------------------
+MS_TARGET_AVX2 static void
+FillAVX2(uint32_t *dst, uint32_t color, size_t count) {
+    __m256i value = _mm256_set1_epi32(int32_t(color));
+    size_t  i     = GetAlignedStart(dst, 32, count);
+
+    FillScalar(dst, color, i);
+    if(count * sizeof(uint32_t) >= kStreamBytes) {
+        for(; i + 8 <= count; i += 8)
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + i), value);
+        _mm_sfence();
+    }
+    else {
+        for(; i + 8 <= count; i += 8)
+            _mm256_store_si256(reinterpret_cast<__m256i *>(dst + i), value);
+    }
+    FillScalar(dst + i, color, count - i);
+}
+
+//-------------------------------------
+MS_TARGET_AVX512 static void
+FillAVX512(uint32_t *dst, uint32_t color, size_t count) {
+    __m512i value = _mm512_set1_epi32(int32_t(color));
+    size_t  i     = GetAlignedStart(dst, 64, count);
+
+    FillScalar(dst, color, i);
+    if(count * sizeof(uint32_t) >= kStreamBytes) {
+        for(; i + 16 <= count; i += 16)
+            _mm512_stream_si512(reinterpret_cast<__m512i *>(dst + i), value);
+        _mm_sfence();
+    }
+    else {
+        for(; i + 16 <= count; i += 16)
+            _mm512_store_si512(dst + i, value);
+    }
+    FillScalar(dst + i, color, count - i);
+}
+#endif
+
+//-------------------------------------
+// Stretch
+// Columns and rows map to the source ones with the 16.16 steps of minifb's
+// stretch_image, except for exact integer factors (up to kMaxReplicate),
+// which map x / factor: the truncated 3x step drifts one pixel to the left.
+// Each source row is resampled once; the destination rows repeating it are
+// copies of the first one
+//-------------------------------------
+static const uint32_t kMaxReplicate = 4;
+
+using ResampleRowFunc  = void (*)(const uint32_t *src, uint32_t *dst, const uint32_t *columns, uint32_t width);
+using ReplicateRowFunc = void (*)(const uint32_t *src, uint32_t *dst, uint32_t srcWidth, uint32_t factor);
+
+//-------------------------------------
+static inline uint32_t
+GetIntegerFactor(uint32_t srcSize, uint32_t dstSize) {
+    if(srcSize == 0 || dstSize % srcSize != 0)
+        return 0;
+
+    return (dstSize / srcSize <= kMaxReplicate) ? dstSize / srcSize : 0;
+}
+
+//-------------------------------------
+static void
+StretchRows(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
+            uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch,
+            ResampleRowFunc resampleRow, ReplicateRowFunc replicateRow) {
+    static thread_local std::vector<uint32_t>   tlsColumns;
+    const uint32_t                              *lastSrc = nullptr;
+    const uint32_t                              *lastDst = nullptr;
+
+    if(srcImage == nullptr || dstImage == nullptr || dstWidth == 0 || dstHeight == 0)
+        return;
+
+    srcImage += srcX + srcY * srcPitch;
+    dstImage += dstX + dstY * dstPitch;
+
+    const uint32_t deltaX  = (srcWidth  << 16) / dstWidth;
+    const uint32_t deltaY  = (srcHeight << 16) / dstHeight;
+    const uint32_t factorX = GetIntegerFactor(srcWidth,  dstWidth);
+    const uint32_t factorY = GetIntegerFactor(srcHeight, dstHeight);
+
+    if(factorX == 0) {
+        tlsColumns.resize(dstWidth);
+        for(uint32_t x = 0; x < dstWidth; ++x) {
+            tlsColumns[x] = uint32_t((uint64_t(x) * deltaX) >> 16);
+        }
+    }
+
+    for(uint32_t y = 0; y < dstHeight; ++y) {
+        uint32_t        row = (factorY != 0) ? y / factorY : uint32_t((uint64_t(y) * deltaY) >> 16);
+        const uint32_t  *src = srcImage + size_t(row) * srcPitch;
+
+        if(src == lastSrc)
+            memcpy(dstImage, lastDst, dstWidth * sizeof(uint32_t));
+        else if(factorX != 0)
+            replicateRow(src, dstImage, srcWidth, factorX);
+        else
+            resampleRow(src, dstImage, tlsColumns.data(), dstWidth);
+
+        lastSrc   = src;
+        lastDst   = dstImage;
+        dstImage += dstPitch;
+    }
+}
+
+//-------------------------------------
+static void
+ResampleRowScalar(const uint32_t *src, uint32_t *dst, const uint32_t *columns, uint32_t width) {
+    for(uint32_t x = 0; x < width; ++x) {
+        dst[x] = src[columns[x]];
+    }
+}
+
+//-------------------------------------
+static void
+ReplicateRowScalar(const uint32_t *src, uint32_t *dst, uint32_t srcWidth, uint32_t factor) {
+    for(uint32_t x = 0; x < srcWidth; ++x) {
+        for(uint32_t i = 0; i < factor; ++i) {
+            *dst++ = src[x];
+        }
+    }
+}
+
+//-------------------------------------
+static void
+StretchScalar(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
+              uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch) {
+    StretchRows(srcImage, srcX, srcY, srcWidth, srcHeight, srcPitch, dstImage, dstX, dstY, dstWidth, dstHeight, dstPitch,
+                ResampleRowScalar, ReplicateRowScalar);
+}
+
+#if defined(MS_CPU_X86)
+//-------------------------------------
+// Each block of 4 source pixels is shuffled into factor blocks of 4
+// destination ones (pshufb, so SSE4.1 level)
+//-------------------------------------
+MS_TARGET_SSE41 static void
+ReplicateRowSSE41(const uint32_t *src, uint32_t *dst, uint32_t srcWidth, uint32_t factor) {
+    __m128i     control[kMaxReplicate];
+    uint32_t    x = 0;
+
+    // Byte control of pixel p: 4p, 4p + 1, 4p + 2, 4p + 3
+    for(uint32_t i = 0; i < factor; ++i) {
+        control[i] = _mm_setr_epi32(int32_t(0x03020100 + ((i * 4 + 0) / factor) * 0x04040404),
+                                    int32_t(0x03020100 + ((i * 4 + 1) / factor) * 0x04040404),
+                                    int32_t(0x03020100 + ((i * 4 + 2) / factor) * 0x04040404),
+                                    int32_t(0x03020100 + ((i * 4 + 3) / factor) * 0x04040404));
+    }
+
+    for(; x + 4 <= srcWidth; x += 4) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+
+        for(uint32_t i = 0; i < factor; ++i) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), _mm_shuffle_epi8(pixels, control[i]));
+        }
+        dst += factor * 4;
+    }
+    ReplicateRowScalar(src + x, dst, srcWidth - x, factor);
+}
+
+//-------------------------------------
+static void
+StretchSSE41(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
+             uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch) {
+    StretchRows(srcImage, srcX, srcY, srcWidth, srcHeight, srcPitch, dstImage, dstX, dstY, dstWidth, dstHeight, dstPitch,
+                ResampleRowScalar, ReplicateRowSSE41);
+}
+
+//-------------------------------------
+// 8 destination pixels per gather from the column table
+//-------------------------------------
+MS_TARGET_AVX2 static void
+ResampleRowAVX2(const uint32_t *src, uint32_t *dst, const uint32_t *columns, uint32_t width) {
+    uint32_t    x = 0;
+
+    for(; x + 8 <= width; x += 8) {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(columns + x));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x), _mm256_i32gather_epi32(reinterpret_cast<const int *>(src), index, 4));
+    }
+    ResampleRowScalar(src, dst + x, columns + x, width - x);
+}
+
+//-------------------------------------
+MS_TARGET_AVX2 static void
+ReplicateRowAVX2(const uint32_t *src, uint32_t *dst, uint32_t srcWidth, uint32_t factor) {
+    __m256i     index[kMaxReplicate];
+    uint32_t    x = 0;
+
+    for(uint32_t i = 0; i < factor; ++i) {
+        index[i] = _mm256_setr_epi32(int32_t((i * 8 + 0) / factor), int32_t((i * 8 + 1) / factor),
+                                     int32_t((i * 8 + 2) / factor), int32_t((i * 8 + 3) / factor),
+                                     int32_t((i * 8 + 4) / factor), int32_t((i * 8 + 5) / factor),
+                                     int32_t((i * 8 + 6) / factor), int32_t((i * 8 + 7) / factor));
+    }
+
+    for(; x + 8 <= srcWidth; x += 8) {
+        __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + x));
+
+        for(uint32_t i = 0; i < factor; ++i) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 8), _mm256_permutevar8x32_epi32(pixels, index[i]));
+        }
+        dst += factor * 8;
+    }
+    ReplicateRowSSE41(src + x, dst, srcWidth - x, factor);
+}
+
+//-------------------------------------
+static void
+StretchAVX2(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
+            uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch) {
+    StretchRows(srcImage, srcX, srcY, srcWidth, srcHeight, srcPitch, dstImage, dstX, dstY, dstWidth, dstHeight, dstPitch,
+                ResampleRowAVX2, ReplicateRowAVX2);
+}
+#endif
+
+//-------------------------------------
+// StretchBilinear
+// Pixel centers map to pixel centers. Every source row a destination row
+// needs is filtered horizontally once, into 8.7 fixed point 16 bit lanes
+// (7 bit weights: a * 128 + (b - a) * w fits in an int16). The two rows
+// around each destination row are then blended with a Q15 weight (the
+// rounding of pmulhrsw) and rounded back to 8 bits
+//-------------------------------------
+using FilterRowFunc = void (*)(const uint32_t *src, int16_t *dst, const uint32_t *columns, const int16_t *weights, uint32_t width);
+using BlendRowsFunc = void (*)(const int16_t *row0, const int16_t *row1, uint32_t *dst, int16_t weight, uint32_t width);
+
+//-------------------------------------
+// Left / top source pixel and 16 bit fraction of destination pixel i. The
+// last source pixel is reached as index size - 2 plus a whole step, so the
+// pair [index, index + 1] is always inside (size >= 2)
+//-------------------------------------
+static inline void
+GetBilinearSample(uint32_t srcSize, uint32_t dstSize, uint32_t i, uint32_t &index, uint32_t &frac) {
+    int64_t pos = ((int64_t(2 * i + 1) * srcSize) << 16) / (int64_t(2) * dstSize) - 0x8000;
+
+    if(pos < 0)
+        pos = 0;
+
+    index = uint32_t(pos >> 16);
+    frac  = uint32_t(pos & 0xffff);
+    if(index >= srcSize - 1) {
+        index = srcSize - 2;
+        frac  = 0x10000;
+    }
+}
+
+//-------------------------------------
+static void
+StretchBilinearRows(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
+                    uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch,
+                    FilterRowFunc filterRow, BlendRowsFunc blendRows) {
+    static thread_local std::vector<uint32_t>   tlsColumns;
+    static thread_local std::vector<int16_t>    tlsWeights;
+    static thread_local std::vector<int16_t>    tlsRows[2];
+    uint32_t                                    rowIndex[2] = { UINT32_MAX, UINT32_MAX };
+    uint32_t                                    index, frac;
+
+    if(srcImage == nullptr || dstImage == nullptr || dstWidth == 0 || dstHeight == 0)
+        return;
+
+    // Nothing to blend across
+    if(srcWidth < 2 || srcHeight < 2) {
+        CPixelKernels::Stretch(srcImage, srcX, srcY, srcWidth, srcHeight, srcPitch, dstImage, dstX, dstY, dstWidth, dstHeight, dstPitch);
+        return;
+    }
+
+    srcImage += srcX + srcY * srcPitch;
+    dstImage += dstX + dstY * dstPitch;
+
+    // Per column: source pixel and its weight, once per channel lane
+    tlsColumns.resize(dstWidth);
+    tlsWeights.resize(size_t(dstWidth) * 4);
+    tlsRows[0].resize(size_t(dstWidth) * 4);
+    tlsRows[1].resize(size_t(dstWidth) * 4);
+    for(uint32_t x = 0; x < dstWidth; ++x) {
+        GetBilinearSample(srcWidth, dstWidth, x, index, frac);
+
+        int16_t weight = int16_t((frac + 0x100) >> 9);
+        tlsColumns[x] = index;
+        tlsWeights[x * 4 + 0] = weight;
+        tlsWeights[x * 4 + 1] = weight;
+        tlsWeights[x * 4 + 2] = weight;
+        tlsWeights[x * 4 + 3] = weight;
+    }
+
+    for(uint32_t y = 0; y < dstHeight; ++y) {
+        GetBilinearSample(srcHeight, dstHeight, y, index, frac);
+
+        // frac 0x10000 is the next row alone
+        if(frac >= 0x10000) {
+            ++index;
+            frac = 0;
+        }
+
+        // Consecutive rows have different parity: each one keeps its slot
+        // while the destination rows between them are blended
+        uint32_t rows  = (frac != 0) ? 2 : 1;
+        for(uint32_t i = 0; i < rows; ++i) {
+            uint32_t row  = index + i;
+            uint32_t slot = row & 1;
+            if(rowIndex[slot] != row) {
+                filterRow(srcImage + size_t(row) * srcPitch, tlsRows[slot].data(), tlsColumns.data(), tlsWeights.data(), dstWidth);
+                rowIndex[slot] = row;
+            }
+        }
+
+        const int16_t *row0 = tlsRows[index & 1].data();
+        const int16_t *row1 = tlsRows[(index + rows - 1) & 1].data();
+        blendRows(row0, row1, dstImage, int16_t(frac >> 1), dstWidth);
+        dstImage += dstPitch;
+    }
+}
+
+//-------------------------------------
+static void
+FilterRowScalar(const uint32_t *src, int16_t *dst, const uint32_t *columns, const int16_t *weights, uint32_t width) {
+    for(uint32_t x = 0; x < width; ++x) {
+        const uint8_t   *a = reinterpret_cast<const uint8_t *>(src + columns[x]);
+        const uint8_t   *b = a + 4;
+        int32_t         w  = weights[x * 4];
+
+        for(uint32_t c = 0; c < 4; ++c) {
+            dst[x * 4 + c] = int16_t((a[c] << 7) + (b[c] - a[c]) * w);
+        }
+    }
+}
+
+//-------------------------------------
+static void
+BlendRowsScalar(const int16_t *row0, const int16_t *row1, uint32_t *dst, int16_t weight, uint32_t width) {
+    uint8_t *pixels = reinterpret_cast<uint8_t *>(dst);
+
+    for(uint32_t i = 0; i < width * 4; ++i) {
+        int32_t value = row0[i] + (((row1[i] - row0[i]) * weight + 0x4000) >> 15);
+        pixels[i] = uint8_t((value + 64) >> 7);
+    }
+}
+
+//-------------------------------------
+static void
+StretchBilinearScalar(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
+                      uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch) {
+    StretchBilinearRows(srcImage, srcX, srcY, srcWidth, srcHeight, srcPitch, dstImage, dstX, dstY, dstWidth, dstHeight, dstPitch,
+                        FilterRowScalar, BlendRowsScalar);
+}
+
+#if defined(MS_CPU_X86)
+//-------------------------------------
+// 2 pixels per step: each one loads its source pair with a single 64 bit load
+//-------------------------------------
+MS_TARGET_SSE41 static void
+FilterRowSSE41(const uint32_t *src, int16_t *dst, const uint32_t *columns, const int16_t *weights, uint32_t width) {
+    // [a0 b0 a1 b1] -> [a0 a1 b0 b1]
+    const __m128i   order = _mm_setr_epi8(0, 1, 2, 3, 8, 9, 10, 11, 4, 5, 6, 7, 12, 13, 14, 15);
+    const __m128i   zero  = _mm_setzero_si128();
+    uint32_t        x     = 0;
+
+    for(; x + 2 <= width; x += 2) {
+        __m128i pair0  = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + columns[x + 0]));
+        __m128i pair1  = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + columns[x + 1]));
+        __m128i pixels = _mm_shuffle_epi8(_mm_unpacklo_epi64(pair0, pair1), order);
+        __m128i a      = _mm_unpacklo_epi8(pixels, zero);
+        __m128i b      = _mm_unpackhi_epi8(pixels, zero);
+        __m128i w      = _mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + x * 4));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * 4), _mm_add_epi16(_mm_slli_epi16(a, 7), _mm_mullo_epi16(_mm_sub_epi16(b, a), w)));
+    }
+    FilterRowScalar(src, dst + x * 4, columns + x, weights + x * 4, width - x);
+}
+
+//-------------------------------------
+MS_TARGET_SSE41 static void
+BlendRowsSSE41(const int16_t *row0, const int16_t *row1, uint32_t *dst, int16_t weight, uint32_t width) {
+    const __m128i   w     = _mm_set1_epi16(weight);
+    const __m128i   round = _mm_set1_epi16(64);
+    uint32_t        x     = 0;
+
+    for(; x + 4 <= width; x += 4) {
+        __m128i h00 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + x * 4));
+        __m128i h01 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + x * 4 + 8));
+        __m128i h10 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x * 4));
+        __m128i h11 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x * 4 + 8));
+        __m128i v0  = _mm_add_epi16(h00, _mm_mulhrs_epi16(_mm_sub_epi16(h10, h00), w));
+        __m128i v1  = _mm_add_epi16(h01, _mm_mulhrs_epi16(_mm_sub_epi16(h11, h01), w));
+
+        v0 = _mm_srli_epi16(_mm_add_epi16(v0, round), 7);
+        v1 = _mm_srli_epi16(_mm_add_epi16(v1, round), 7);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), _mm_packus_epi16(v0, v1));
+    }
+    BlendRowsScalar(row0 + x * 4, row1 + x * 4, dst + x, weight, width - x);
+}
+
+//-------------------------------------
+static void
+StretchBilinearSSE41(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
+                     uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch) {
+    StretchBilinearRows(srcImage, srcX, srcY, srcWidth, srcHeight, srcPitch, dstImage, dstX, dstY, dstWidth, dstHeight, dstPitch,
+                        FilterRowSSE41, BlendRowsSSE41);
+}
+
+//-------------------------------------
+// 4 pixels per step: one gather of 4 source pairs
+//-------------------------------------
+MS_TARGET_AVX2 static void
+FilterRowAVX2(const uint32_t *src, int16_t *dst, const uint32_t *columns, const int16_t *weights, uint32_t width) {
+    const __m256i   order = _mm256_setr_epi8(0, 1, 2, 3, 8, 9, 10, 11, 4, 5, 6, 7, 12, 13, 14, 15,
+                                             0, 1, 2, 3, 8, 9, 10, 11, 4, 5, 6, 7, 12, 13, 14, 15);
+    const __m256i   zero  = _mm256_setzero_si256();
+    uint32_t        x     = 0;
+
+    for(; x + 4 <= width; x += 4) {
+        __m128i index  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(columns + x));
+        __m256i pairs  = _mm256_i32gather_epi64(reinterpret_cast<const long long *>(src), index, 4);
+        __m256i pixels = _mm256_shuffle_epi8(pairs, order);
+        __m256i a      = _mm256_unpacklo_epi8(pixels, zero);
+        __m256i b      = _mm256_unpackhi_epi8(pixels, zero);
+        __m256i w      = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(weights + x * 4));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x * 4), _mm256_add_epi16(_mm256_slli_epi16(a, 7), _mm256_mullo_epi16(_mm256_sub_epi16(b, a), w)));
+    }
+    FilterRowSSE41(src, dst + x * 4, columns + x, weights + x * 4, width - x);
+}
+
+//-------------------------------------
+MS_TARGET_AVX2 static void
+BlendRowsAVX2(const int16_t *row0, const int16_t *row1, uint32_t *dst, int16_t weight, uint32_t width) {
+    const __m256i   w     = _mm256_set1_epi16(weight);
+    const __m256i   round = _mm256_set1_epi16(64);
+    uint32_t        x     = 0;
+
+    for(; x + 8 <= width; x += 8) {
+        __m256i h00 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row0 + x * 4));
+        __m256i h01 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row0 + x * 4 + 16));
+        __m256i h10 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row1 + x * 4));
+        __m256i h11 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row1 + x * 4 + 16));
+        __m256i v0  = _mm256_add_epi16(h00, _mm256_mulhrs_epi16(_mm256_sub_epi16(h10, h00), w));
+        __m256i v1  = _mm256_add_epi16(h01, _mm256_mulhrs_epi16(_mm256_sub_epi16(h11, h01), w));
+
+        v0 = _mm256_srli_epi16(_mm256_add_epi16(v0, round), 7);
+        v1 = _mm256_srli_epi16(_mm256_add_epi16(v1, round), 7);
+        // packus works per 128 bit lane: pixels 0 1 4 5 2 3 6 7
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x), _mm256_permute4x64_epi64(_mm256_packus_epi16(v0, v1), _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    BlendRowsSSE41(row0 + x * 4, row1 + x * 4, dst + x, weight, width - x);
+}
+
+//-------------------------------------
+static void
+StretchBilinearAVX2(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
+                    uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch) {
+    StretchBilinearRows(srcImage, srcX, srcY, srcWidth, srcHeight, srcPitch, dstImage, dstX, dstY, dstWidth, dstHeight, dstPitch,
+                        FilterRowAVX2, BlendRowsAVX2);
+}
+#endif
+
+//-------------------------------------
+// FillTriangle
+//-------------------------------------
+static void
+FillTriangleScalar(uint32_t *dst, uint32_t pitch, uint32_t width, uint32_t height,
+                   const int32_t edge[3], const int32_t stepX[3], const int32_t stepY[3], uint32_t color) {
+    int32_t e0 = edge[0], e1 = edge[1], e2 = edge[2];
+
+    for(uint32_t y = 0; y < height; ++y) {
+        int32_t w0 = e0, w1 = e1, w2 = e2;
+        bool    inside = false;
+
+        for(uint32_t x = 0; x < width; ++x) {
+            // All three non negative <=> no sign bit in the or
+            if((w0 | w1 | w2) >= 0) {
+                dst[x] = color;
+                inside = true;
+            }
+            else if(inside) {
+                break;  // Triangles are convex: the span is over
+            }
+            w0 += stepX[0];
+            w1 += stepX[1];
+            w2 += stepX[2];
+        }
+
+        e0 += stepY[0];
+        e1 += stepY[1];
+        e2 += stepY[2];
+        dst += pitch;
+    }
+}
+
+#if defined(MS_CPU_X86)
+//-------------------------------------
+// 4 pixels per step. SSE4.1 for mullo (lane offsets) and blendv (partial blocks)
+//-------------------------------------
+MS_TARGET_SSE41 static void
+FillTriangleSSE41(uint32_t *dst, uint32_t pitch, uint32_t width, uint32_t height,
+                  const int32_t edge[3], const int32_t stepX[3], const int32_t stepY[3], uint32_t color) {
+    const __m128i   lanes   = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i   value   = _mm_set1_epi32(int32_t(color));
+    const __m128i   offset0 = _mm_mullo_epi32(_mm_set1_epi32(stepX[0]), lanes);
+    const __m128i   offset1 = _mm_mullo_epi32(_mm_set1_epi32(stepX[1]), lanes);
+    const __m128i   offset2 = _mm_mullo_epi32(_mm_set1_epi32(stepX[2]), lanes);
+    const __m128i   step0   = _mm_slli_epi32(_mm_set1_epi32(stepX[0]), 2);
+    const __m128i   step1   = _mm_slli_epi32(_mm_set1_epi32(stepX[1]), 2);
+    const __m128i   step2   = _mm_slli_epi32(_mm_set1_epi32(stepX[2]), 2);
+    int32_t         e0 = edge[0], e1 = edge[1], e2 = edge[2];
+
+    for(uint32_t y = 0; y < height; ++y) {
+        __m128i w0 = _mm_add_epi32(_mm_set1_epi32(e0), offset0);
+        __m128i w1 = _mm_add_epi32(_mm_set1_epi32(e1), offset1);
+        __m128i w2 = _mm_add_epi32(_mm_set1_epi32(e2), offset2);
+        bool    inside = false;
+
+        for(uint32_t x = 0; x < width; x += 4) {
+            // Sign bit set => outside
+            __m128  outside = _mm_castsi128_ps(_mm_or_si128(_mm_or_si128(w0, w1), w2));
+            int     mask    = _mm_movemask_ps(outside);
+
+            if(x + 4 > width)
+                mask |= (0xf << (width - x)) & 0xf;
+
+            if(mask == 0) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), value);
+                inside = true;
+            }
+            else if(mask != 0xf) {
+                if(x + 4 <= width) {
+                    __m128 pixels = _mm_loadu_ps(reinterpret_cast<const float *>(dst + x));
+                    _mm_storeu_ps(reinterpret_cast<float *>(dst + x), _mm_blendv_ps(_mm_castsi128_ps(value), pixels, outside));
+                }
+                else {
+                    for(uint32_t i = 0; i < width - x; ++i) {
+                        if((mask & (1 << i)) == 0)
+                            dst[x + i] = color;
+                    }
+                }
+                inside = true;
+            }
+            else if(inside) {
+                break;
+            }
+            w0 = _mm_add_epi32(w0, step0);
+            w1 = _mm_add_epi32(w1, step1);
+            w2 = _mm_add_epi32(w2, step2);
+        }
+
+        e0 += stepY[0];
+        e1 += stepY[1];
+        e2 += stepY[2];
+        dst += pitch;
+    }
+}
+
+//-------------------------------------
+MS_TARGET_AVX2 static void
+FillTriangleAVX2(uint32_t *dst, uint32_t pitch, uint32_t width, uint32_t height,
+                 const int32_t edge[3], const int32_t stepX[3], const int32_t stepY[3], uint32_t color) {
+    const __m256i   lanes   = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i   value   = _mm256_set1_epi32(int32_t(color));
+    const __m256i   offset0 = _mm256_mullo_epi32(_mm256_set1_epi32(stepX[0]), lanes);
+    const __m256i   offset1 = _mm256_mullo_epi32(_mm256_set1_epi32(stepX[1]), lanes);
+    const __m256i   offset2 = _mm256_mullo_epi32(_mm256_set1_epi32(stepX[2]), lanes);
+    const __m256i   step0   = _mm256_slli_epi32(_mm256_set1_epi32(stepX[0]), 3);
+    const __m256i   step1   = _mm256_slli_epi32(_mm256_set1_epi32(stepX[1]), 3);
+    const __m256i   step2   = _mm256_slli_epi32(_mm256_set1_epi32(stepX[2]), 3);
+    int32_t         e0 = edge[0], e1 = edge[1], e2 = edge[2];
+
+    for(uint32_t y = 0; y < height; ++y) {
+        __m256i w0 = _mm256_add_epi32(_mm256_set1_epi32(e0), offset0);
+        __m256i w1 = _mm256_add_epi32(_mm256_set1_epi32(e1), offset1);
+        __m256i w2 = _mm256_add_epi32(_mm256_set1_epi32(e2), offset2);
+        bool    inside = false;
+
+        for(uint32_t x = 0; x < width; x += 8) {
+            __m256i outside = _mm256_or_si256(_mm256_or_si256(w0, w1), w2);
+
+            if(x + 8 > width)
+                outside = _mm256_or_si256(outside, _mm256_cmpgt_epi32(lanes, _mm256_set1_epi32(int32_t(width - x - 1))));
+
+            int mask = _mm256_movemask_ps(_mm256_castsi256_ps(outside));
+            if(mask == 0) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x), value);
+                inside = true;
+            }
+            else if(mask != 0xff) {
+                // Stores the lanes with the sign bit set, so the negated outside mask
+                _mm256_maskstore_epi32(reinterpret_cast<int *>(dst + x), _mm256_xor_si256(outside, _mm256_set1_epi32(-1)), value);
+                inside = true;
+            }
+            else if(inside) {
+                break;
+            }
+            w0 = _mm256_add_epi32(w0, step0);
+            w1 = _mm256_add_epi32(w1, step1);
+            w2 = _mm256_add_epi32(w2, step2);
+        }
+
+        e0 += stepY[0];
+        e1 += stepY[1];
+        e2 += stepY[2];
+        dst += pitch;
+    }
+}
+
+//-------------------------------------
+MS_TARGET_AVX512 static void
+FillTriangleAVX512(uint32_t *dst, uint32_t pitch, uint32_t width, uint32_t height,
+                   const int32_t edge[3], const int32_t stepX[3], const int32_t stepY[3], uint32_t color) {
+    const __m512i   lanes   = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m512i   value   = _mm512_set1_epi32(int32_t(color));
+    const __m512i   offset0 = _mm512_mullo_epi32(_mm512_set1_epi32(stepX[0]), lanes);
+    const __m512i   offset1 = _mm512_mullo_epi32(_mm512_set1_epi32(stepX[1]), lanes);
+    const __m512i   offset2 = _mm512_mullo_epi32(_mm512_set1_epi32(stepX[2]), lanes);
+    // Zero masking with all lanes set: GCC 12 warns about the undefined source of the unmasked shift
+    const __m512i   step0   = _mm512_maskz_slli_epi32(0xffff, _mm512_set1_epi32(stepX[0]), 4);
+    const __m512i   step1   = _mm512_maskz_slli_epi32(0xffff, _mm512_set1_epi32(stepX[1]), 4);
+    const __m512i   step2   = _mm512_maskz_slli_epi32(0xffff, _mm512_set1_epi32(stepX[2]), 4);
+    int32_t         e0 = edge[0], e1 = edge[1], e2 = edge[2];
+
+    for(uint32_t y = 0; y < height; ++y) {
+        __m512i w0 = _mm512_add_epi32(_mm512_set1_epi32(e0), offset0);
+        __m512i w1 = _mm512_add_epi32(_mm512_set1_epi32(e1), offset1);
+        __m512i w2 = _mm512_add_epi32(_mm512_set1_epi32(e2), offset2);
+        bool    inside = false;
+
+        for(uint32_t x = 0; x < width; x += 16) {
+            __m512i     edges = _mm512_or_si512(_mm512_or_si512(w0, w1), w2);
+            __mmask16   mask  = _mm512_cmpge_epi32_mask(edges, _mm512_setzero_si512());
+
+            if(x + 16 > width)
+                mask &= __mmask16((1u << (width - x)) - 1);
+
+            if(mask != 0) {
+                _mm512_mask_storeu_epi32(dst + x, mask, value);
+                inside = true;
+            }
+            else if(inside) {
+                break;
+            }
+            w0 = _mm512_add_epi32(w0, step0);
+            w1 = _mm512_add_epi32(w1, step1);
+            w2 = _mm512_add_epi32(w2, step2);
+        }
+
+        e0 += stepY[0];
+        e1 += stepY[1];
+        e2 += stepY[2];
+        dst += pitch;
+    }
+}
+#endif
+
+//-------------------------------------
+static CCpuKernel<FillFunc> sFill("CPixelKernels::Fill", {
+    { ECpuLevel::Scalar, FillScalar },
+#if defined(MS_CPU_X86)
+    { ECpuLevel::SSE2,   FillSSE2   },
+    { ECpuLevel::AVX2,   FillAVX2   },
+    { ECpuLevel::AVX512, FillAVX512 },
+#endif
+});
+
+static CCpuKernel<StretchFunc> sStretch("CPixelKernels::Stretch", {
+    { ECpuLevel::Scalar, StretchScalar },
+#if defined(MS_CPU_X86)
+    { ECpuLevel::SSE41,  StretchSSE41  },
+    { ECpuLevel::AVX2,   StretchAVX2   },
+#endif
+});
+
+static CCpuKernel<StretchFunc> sStretchBilinear("CPixelKernels::StretchBilinear", {
+    { ECpuLevel::Scalar, StretchBilinearScalar },
+#if defined(MS_CPU_X86)
+    { ECpuLevel::SSE41,  StretchBilinearSSE41  },
+    { ECpuLevel::AVX2,   StretchBilinearAVX2   },
+#endif
+});
+
+static CCpuKernel<TriangleFunc> sFillTriangle("CPixelKernels::FillTriangle", {
+    { ECpuLevel::Scalar, FillTriangleScalar },
+#if defined(MS_CPU_X86)
+    { ECpuLevel::SSE41,  FillTriangleSSE41  },
+    { ECpuLevel::AVX2,   FillTriangleAVX2   },
+    { ECpuLevel::AVX512, FillTriangleAVX512 },
+#endif
+});
+
+//-------------------------------------
+void
+CPixelKernels::Fill(uint32_t *dst, uint32_t color, size_t count) {
+    sFill(dst, color, count);
+}
+
+//-------------------------------------
+void
+CPixelKernels::Stretch(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
+                       uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch) {
+    sStretch(srcImage, srcX, srcY, srcWidth, srcHeight, srcPitch, dstImage, dstX, dstY, dstWidth, dstHeight, dstPitch);
+}
+
+//-------------------------------------
+void
+CPixelKernels::StretchBilinear(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
+                               uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch) {
+    sStretchBilinear(srcImage, srcX, srcY, srcWidth, srcHeight, srcPitch, dstImage, dstX, dstY, dstWidth, dstHeight, dstPitch);
+}
+
+//-------------------------------------
+void
+CPixelKernels::FillTriangle(uint32_t *dst, uint32_t pitch, uint32_t width, uint32_t height,
+                            const int32_t edge[3], const int32_t stepX[3], const int32_t stepY[3], uint32_t color) {
+    sFillTriangle(dst, pitch, width, height, edge, stepX, stepY, color);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//-------------------------------------
+// 32 bit pixel kernels. Each one is bound at startup to the widest variant
+// the CPU supports (see MindShake::CCpuKernel, MindShake::SetCpuLevel).
+//-------------------------------------
+class CPixelKernels {
+public:
+    // dst[0, count) = color
+    static void         Fill(uint32_t *dst, uint32_t color, size_t count);
+
+    // Nearest neighbour scale in 16.16 fixed point. Same signature and results
+    // as minifb's stretch_image, so it can be installed with mfb_set_stretch_func.
+    // Exact 1x to 4x factors replicate pixels and rows (dst x maps to x / factor)
+    static void         Stretch(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
+                                uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch);
+
+    // Bilinear scale (pixel centers aligned, 7 bit horizontal and 15 bit vertical
+    // weights), same signature as Stretch. Sources under 2x2 pixels use Stretch
+    static void         StretchBilinear(uint32_t *srcImage, uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch,
+                                        uint32_t *dstImage, uint32_t dstX, uint32_t dstY, uint32_t dstWidth, uint32_t dstHeight, uint32_t dstPitch);
+
+    // Integer edge function stepping over a width x height rectangle. dst[y * pitch + x] = color
+    // when edge[i] + x * stepX[i] + y * stepY[i] >= 0 for the three edges. The caller (the
+    // fixed point setup in CRenderer) guarantees every value in the rectangle, plus one step
+    // past its right and bottom sides, fits in 32 bits
+    static void         FillTriangle(uint32_t *dst, uint32_t pitch, uint32_t width, uint32_t height,
+                                     const int32_t edge[3], const int32_t stepX[3], const int32_t stepY[3], uint32_t color);
+};
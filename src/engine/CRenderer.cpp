@@ -1,8 +1,13 @@
 #include "CRenderer.h"
+#include "CPixelKernels.h"
+#include "CMesh.h"
 //-------------------------------------
 #include <Core/memory/memory.h>
 //-------------------------------------
-#include <memory.h>
+#include <algorithm>
+#include <cmath>
+#include <climits>
+//-------------------------------------
 
 using namespace MindShake;
 
@@ -11,18 +16,205 @@ CRenderer::CRenderer(uint32_t width, uint32_t height) {
     mWidth       = width;
     mHeight      = height;
 
-    mColorBuffer = (uint32_t *) AlignedMalloc(width * height * sizeof(uint32_t), 64);
+    // Huge pages when it is big enough: the rasterizer touches it at random
+    mColorBuffers[0] = (uint32_t *) LargeMalloc(GetColorBufferSize(), EMemoryTag::Renderer);
+    mColorBuffer     = mColorBuffers[0];
 }
 
 //-------------------------------------
 CRenderer::~CRenderer() {
-    if(mColorBuffer != nullptr) {
-        AlignedFree(mColorBuffer);
+    for(uint32_t i = 0; i < kMaxColorBuffers; ++i) {
+        if(mColorBuffers[i] != nullptr) {
+            LargeFree(mColorBuffers[i], GetColorBufferSize(), EMemoryTag::Renderer);
+            mColorBuffers[i] = nullptr;
+        }
+    }
+    mColorBuffer = nullptr;
+}
+
+//-------------------------------------
+// Buffer 0 is kept: drawing continues in it. Returns with fewer buffers
+// if the memory runs out
+//-------------------------------------
+void
+CRenderer::SetNumColorBuffers(uint32_t count) {
+    count = std::clamp<uint32_t>(count, 1, kMaxColorBuffers);
+
+    for(uint32_t i = 1; i < kMaxColorBuffers; ++i) {
+        if(i < count && mColorBuffers[i] == nullptr) {
+            mColorBuffers[i] = (uint32_t *) LargeMalloc(GetColorBufferSize(), EMemoryTag::Renderer);
+            if(mColorBuffers[i] == nullptr)
+                count = i;  // Out of memory: fewer buffers
+        }
+        else if(i >= count && mColorBuffers[i] != nullptr) {
+            LargeFree(mColorBuffers[i], GetColorBufferSize(), EMemoryTag::Renderer);
+            mColorBuffers[i] = nullptr;
+        }
     }
+    mNumColorBuffers = count;
+    mColorBuffer     = mColorBuffers[0];
 }
 
 //-------------------------------------
 void
 CRenderer::Clear(uint8_t i) {
-    memset(mColorBuffer, i, mWidth * mHeight * 4);
+    // Same bytes memset(i) would write
+    CPixelKernels::Fill(mColorBuffer, i * 0x01010101u, size_t(mWidth) * mHeight);
+}
+
+//-------------------------------------
+// Triangle setup
+//-------------------------------------
+// 28.4: vertices snap to 1/16 pixel, so the edge functions (products of two
+// coordinates) are exact integers with 8 fractional bits
+static const int32_t    kSubPixelBits = 4;
+static const int32_t    kSubPixelOne  = 1 << kSubPixelBits;
+static const int32_t    kSubPixelHalf = kSubPixelOne >> 1;
+// Max |window coordinate| in pixels. Deltas stay in 20 bits, so the per pixel
+// steps always fit in 32 bits and the edge values at any pixel in 64
+static const float      kGuardBand    = 32768.0f;
+
+//-------------------------------------
+struct SnappedVertex {
+    int32_t x, y;
+};
+
+//-------------------------------------
+struct EdgeSetup {
+    int64_t edge;       // At the center of the first pixel of the rectangle
+    int64_t stepX;      // Per pixel
+    int64_t stepY;
+};
+
+//-------------------------------------
+static inline bool
+Snap(const CVector3 &v, SnappedVertex &snapped) {
+    // Written so NaN fails too
+    if(!(v.z > 0.0f && v.z <= 1.0f) || !(fabsf(v.x) <= kGuardBand) || !(fabsf(v.y) <= kGuardBand))
+        return false;
+
+    snapped.x = int32_t(lrintf(v.x * float(kSubPixelOne)));
+    snapped.y = int32_t(lrintf(v.y * float(kSubPixelOne)));
+
+    return true;
+}
+
+//-------------------------------------
+// Edge a -> b: cross(b - a, p - a), positive inside for triangles with positive area.
+// Top-left rule: a pixel center exactly on an edge belongs to the triangle only if
+// it is a top (horizontal, interior below) or a left (going up) edge. The -1 turns
+// >= 0 into > 0 for the others, so shared edges are rasterized exactly once
+//-------------------------------------
+static inline void
+SetupEdge(const SnappedVertex &a, const SnappedVertex &b, int32_t x, int32_t y, EdgeSetup &setup) {
+    int64_t dx = int64_t(b.x) - a.x;
+    int64_t dy = int64_t(b.y) - a.y;
+    int64_t px = int64_t(x) * kSubPixelOne + kSubPixelHalf;
+    int64_t py = int64_t(y) * kSubPixelOne + kSubPixelHalf;
+    bool    isTopLeft = (dy == 0 && dx > 0) || dy < 0;
+
+    setup.edge  = dx * (py - a.y) - dy * (px - a.x) - (isTopLeft ? 0 : 1);
+    setup.stepX = -dy * kSubPixelOne;
+    setup.stepY =  dx * kSubPixelOne;
+}
+
+//-------------------------------------
+static inline bool
+FitsInt32(int64_t value) {
+    return value >= INT32_MIN && value <= INT32_MAX;
+}
+
+//-------------------------------------
+// Big triangles far out of the screen: same stepping in 64 bits
+//-------------------------------------
+static void
+FillTriangleWide(uint32_t *dst, uint32_t pitch, uint32_t width, uint32_t height, const EdgeSetup edges[3], uint32_t color) {
+    int64_t e0 = edges[0].edge, e1 = edges[1].edge, e2 = edges[2].edge;
+
+    for(uint32_t y = 0; y < height; ++y) {
+        int64_t w0 = e0, w1 = e1, w2 = e2;
+
+        for(uint32_t x = 0; x < width; ++x) {
+            if((w0 | w1 | w2) >= 0)
+                dst[x] = color;
+            w0 += edges[0].stepX;
+            w1 += edges[1].stepX;
+            w2 += edges[2].stepX;
+        }
+
+        e0 += edges[0].stepY;
+        e1 += edges[1].stepY;
+        e2 += edges[2].stepY;
+        dst += pitch;
+    }
+}
+
+//-------------------------------------
+void
+CRenderer::DrawTriangle(const CVector3 &v0, const CVector3 &v1, const CVector3 &v2, uint32_t color) {
+    SnappedVertex   p0, p1, p2;
+    EdgeSetup       edges[3];
+    int64_t         area;
+
+    if(!Snap(v0, p0) || !Snap(v1, p1) || !Snap(v2, p2))
+        return;
+
+    area = (int64_t(p1.x) - p0.x) * (int64_t(p2.y) - p0.y) - (int64_t(p1.y) - p0.y) * (int64_t(p2.x) - p0.x);
+    if(area == 0)
+        return;
+    if(area < 0)
+        std::swap(p1, p2);
+
+    // Pixels whose center is inside the bounds: ceil / floor of (s - half) / one
+    int32_t minX = (std::min(std::min(p0.x, p1.x), p2.x) - kSubPixelHalf + kSubPixelOne - 1) >> kSubPixelBits;
+    int32_t minY = (std::min(std::min(p0.y, p1.y), p2.y) - kSubPixelHalf + kSubPixelOne - 1) >> kSubPixelBits;
+    int32_t maxX = (std::max(std::max(p0.x, p1.x), p2.x) - kSubPixelHalf) >> kSubPixelBits;
+    int32_t maxY = (std::max(std::max(p0.y, p1.y), p2.y) - kSubPixelHalf) >> kSubPixelBits;
+
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, int32_t(mWidth)  - 1);
+    maxY = std::min(maxY, int32_t(mHeight) - 1);
+    if(minX > maxX || minY > maxY)
+        return;
+
+    uint32_t    width  = uint32_t(maxX - minX + 1);
+    uint32_t    height = uint32_t(maxY - minY + 1);
+    uint32_t    *dst   = mColorBuffer + size_t(minY) * mWidth + minX;
+
+    SetupEdge(p1, p2, minX, minY, edges[0]);
+    SetupEdge(p2, p0, minX, minY, edges[1]);
+    SetupEdge(p0, p1, minX, minY, edges[2]);
+
+    // The edge functions are linear: checking the corners (one step past the
+    // rectangle, the kernels step once more) covers every value they see
+    bool    fits = true;
+    for(const EdgeSetup &e : edges) {
+        int64_t right  = e.stepX * width;
+        int64_t bottom = e.stepY * height;
+
+        fits = fits && FitsInt32(e.edge) && FitsInt32(e.edge + right) && FitsInt32(e.edge + bottom) && FitsInt32(e.edge + right + bottom);
+    }
+
+    if(fits == false) {
+        FillTriangleWide(dst, mWidth, width, height, edges, color);
+        return;
+    }
+
+    int32_t edge[3]  = { int32_t(edges[0].edge),  int32_t(edges[1].edge),  int32_t(edges[2].edge)  };
+    int32_t stepX[3] = { int32_t(edges[0].stepX), int32_t(edges[1].stepX), int32_t(edges[2].stepX) };
+    int32_t stepY[3] = { int32_t(edges[0].stepY), int32_t(edges[1].stepY), int32_t(edges[2].stepY) };
+
+    CPixelKernels::FillTriangle(dst, mWidth, width, height, edge, stepX, stepY, color);
+}
+
+//-------------------------------------
+void
+CRenderer::DrawTriangles(const CMesh &mesh, uint32_t color) {
+    const stream_vector<vec3>       &positions = mesh.mVertexPosTrans;
+    const stream_vector<int32_t>    &indices   = mesh.mIndices;
+
+    for(size_t i = 0; i + 2 < indices.size(); i += 3) {
+        DrawTriangle(positions[indices[i]], positions[indices[i + 1]], positions[indices[i + 2]], color);
+    }
 }
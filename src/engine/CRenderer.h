@@ -1,5 +1,8 @@
 #pragma once
 
+#include <Math/types/CVector3.h>
+//-------------------------------------
+#include <cstddef>
 #include <cstdint>
 
 class CMesh;
@@ -9,7 +12,17 @@ class CRenderer {
 friend class CWindow;
 public:
     void        Clear(uint8_t i = 0);
+
+    // Flat shaded, both windings. Window coordinates (CMesh::mVertexPosTrans): pixel centers
+    // at +0.5, snapped to 28.4 fixed point, top-left fill rule. There is no clipper yet:
+    // triangles with a vertex out of 0 < z <= 1 (reverse Z) or the guard band are skipped
+    void        DrawTriangle(const MindShake::CVector3 &v0, const MindShake::CVector3 &v1, const MindShake::CVector3 &v2, uint32_t color);
+    // Triangle list in mesh.mIndices, after CMesh::Transform
+    void        DrawTriangles(const CMesh &mesh, uint32_t color);
+
+    // The one being drawn. With more than one (CWindow::SetPresentBuffers) it changes every frame
     uint32_t *  GetColorBuffer() const      { return mColorBuffer; }
+    size_t      GetColorBufferSize() const  { return size_t(mWidth) * mHeight * sizeof(uint32_t); }
 
     uint32_t    GetWidth() const            { return mWidth;       }
     uint32_t    GetHalfWidth() const        { return mWidth >> 1;  }
@@ -28,8 +41,18 @@ private:
     CRenderer & operator = (const CRenderer &)  = delete;
     CRenderer & operator = (CRenderer &&)       = delete;
 
+    // CWindow presents one while another is drawn
+    static constexpr uint32_t kMaxColorBuffers = 3;
+
+    void        SetNumColorBuffers(uint32_t count);
+    uint32_t    GetNumColorBuffers() const  { return mNumColorBuffers; }
+    uint32_t *  GetColorBuffer(uint32_t index) const { return mColorBuffers[index]; }
+    void        SetDrawColorBuffer(uint32_t index) { mColorBuffer = mColorBuffers[index]; }
+
 protected:
     uint32_t        *mColorBuffer { nullptr };
+    uint32_t        *mColorBuffers[kMaxColorBuffers] { };
+    uint32_t        mNumColorBuffers { 1 };
     uint32_t        mWidth        { 0 };
     uint32_t        mHeight       { 0 };
 
@@ -4,7 +4,10 @@
 #include "CLight.h"
 //-------------------------------------
 #include <Common/Core/stringAux.h>
+#include <Core/log/log.h>
+#include <Kernel/mt/CWorkerPool.h>
 #include <algorithm>
+#include <unordered_map>
 
 //-------------------------------------
 CSceneManager   *CSceneManager::mpInstance = nullptr;
@@ -28,77 +31,119 @@ CSceneManager::DeleteInstance() {
     }
 }
 
+//-------------------------------------
+CSceneManager::CSceneManager()
+    : mNodePool(MindShake::CPoolAllocator::kDefaultSlabSlots, MindShake::EMemoryTag::Scene)
+    , mMeshPool(MindShake::CPoolAllocator::kDefaultSlabSlots, MindShake::EMemoryTag::Mesh)
+    , mCameraPool(MindShake::CPoolAllocator::kDefaultSlabSlots, MindShake::EMemoryTag::Scene)
+    , mLightPool(MindShake::CPoolAllocator::kDefaultSlabSlots, MindShake::EMemoryTag::Scene) {
+}
+
 //-------------------------------------
 CSceneManager::~CSceneManager() {
     for(CSceneNode *node : mNodes) {
         if(node != nullptr) {
-            delete node;
+            DestroyNode(node);
         }
     }
 
+    FreeDeferredNodes(~uint64_t(0));
+
     mNodes.clear();
     mMeshes.clear();
     mCameras.clear();
     mLights.clear();
+
+    // Slabs are returned in bulk
+    mNodePool.Release();
+    mMeshPool.Release();
+    mCameraPool.Release();
+    mLightPool.Release();
+
+    delete mpWorkerPool;
+    mpWorkerPool = nullptr;
+
+    CSceneNode::mMovedNodes.clear();
 }
 
 //-------------------------------------
-CSceneNode *
+NodeHandle
 CSceneManager::CreateSceneNode() {
     CSceneNode   *pSceneNode;
 
-    pSceneNode = new CSceneNode;
-    //pSceneNode->mNodeType = ENodeType::Node;
+    pSceneNode = mNodePool.Create();
+
+    NodeHandle handle = AllocHandle(pSceneNode);
+    if(handle.IsNull()) {
+        mNodePool.Destroy(pSceneNode);
+        return {};
+    }
 
     mNodes.push_back(pSceneNode);
 
-    return pSceneNode;
+    return handle;
 }
 
 //-------------------------------------
-CMesh *
+MeshHandle
 CSceneManager::CreateMesh() {
     CMesh   *pMesh;
 
-    pMesh = new CMesh;
-    //pMesh->mNodeType = ENodeType::Mesh;
+    pMesh = mMeshPool.Create();
+
+    MeshHandle handle = AllocHandle(pMesh).Cast<CMesh>();
+    if(handle.IsNull()) {
+        mMeshPool.Destroy(pMesh);
+        return {};
+    }
 
     mNodes.push_back(pMesh);
     mMeshes.push_back(pMesh);
+    mpSpatialIndex->Insert(pMesh);
 
-    return pMesh;
+    return handle;
 }
 
 //-------------------------------------
-CCamera *
+CameraHandle
 CSceneManager::CreateCamera() {
     CCamera *pCamera;
 
-    pCamera = new CCamera;
-    //pCamera->mNodeType = ENodeType::Camera;
+    pCamera = mCameraPool.Create();
+
+    CameraHandle handle = AllocHandle(pCamera).Cast<CCamera>();
+    if(handle.IsNull()) {
+        mCameraPool.Destroy(pCamera);
+        return {};
+    }
 
     mNodes.push_back(pCamera);
     mCameras.push_back(pCamera);
 
-    return pCamera;
+    return handle;
 }
 
 //-------------------------------------
-CLight *
+LightHandle
 CSceneManager::CreateLight() {
     CLight *pLight;
 
-    pLight = new CLight;
-    //pLight->mNodeType = ENodeType::Light;
+    pLight = mLightPool.Create();
+
+    LightHandle handle = AllocHandle(pLight).Cast<CLight>();
+    if(handle.IsNull()) {
+        mLightPool.Destroy(pLight);
+        return {};
+    }
 
     mNodes.push_back(pLight);
     mLights.push_back(pLight);
 
-    return pLight;
+    return handle;
 }
 
 //-------------------------------------
-CSceneNode *
+NodeHandle
 CSceneManager::GetSceneNodeByName(const string &name) const {
 
     for (CSceneNode *pNode : mNodes) {
@@ -106,16 +151,16 @@ CSceneManager::GetSceneNodeByName(const string &name) const {
             const std::string &objName = pNode->GetName();
 
             if (stricmp(objName.c_str(), name.c_str()) == 0) {
-                return pNode;
+                return pNode->GetHandle();
             }
         }
     }
 
-    return nullptr;
+    return {};
 }
 
 //-------------------------------------
-CMesh *
+MeshHandle
 CSceneManager::GetMeshByName(const string &name) const {
 
     for (CMesh *pMesh : mMeshes) {
@@ -123,16 +168,16 @@ CSceneManager::GetMeshByName(const string &name) const {
             const std::string &objName = pMesh->GetName();
 
             if (stricmp(objName.c_str(), name.c_str()) == 0) {
-                return pMesh;
+                return pMesh->GetHandle().Cast<CMesh>();
             }
         }
     }
 
-    return nullptr;
+    return {};
 }
 
 //-------------------------------------
-CCamera *
+CameraHandle
 CSceneManager::GetCameraByName(const string &name) const {
 
     for (CCamera *pCamera : mCameras) {
@@ -140,16 +185,16 @@ CSceneManager::GetCameraByName(const string &name) const {
             const std::string &objName = pCamera->GetName();
 
             if (stricmp(objName.c_str(), name.c_str()) == 0) {
-                return pCamera;
+                return pCamera->GetHandle().Cast<CCamera>();
             }
         }
     }
 
-    return nullptr;
+    return {};
 }
 
 //-------------------------------------
-CLight *
+LightHandle
 CSceneManager::GetLightByName(const string &name) const {
 
     for (CLight *pLight : mLights) {
@@ -157,70 +202,88 @@ CSceneManager::GetLightByName(const string &name) const {
             const std::string &objName = pLight->GetName();
 
             if (stricmp(objName.c_str(), name.c_str()) == 0) {
-                return pLight;
+                return pLight->GetHandle().Cast<CLight>();
             }
         }
     }
 
-    return nullptr;
+    return {};
 }
 
 //-------------------------------------
-CSceneNode *
+NodeHandle
 CSceneManager::GetSceneNodeByUserId(int32_t userId) const {
     for (CSceneNode *pNode : mNodes) {
         if (pNode != nullptr) {
             if (pNode->GetUserId() == userId) {
-                return pNode;
+                return pNode->GetHandle();
             }
         }
     }
 
-    return nullptr;
+    return {};
 }
 
 //-------------------------------------
-CMesh *
+MeshHandle
 CSceneManager::GetMeshByUserId(int32_t userId) const {
     for (CMesh *pMesh: mMeshes) {
         if (pMesh != nullptr) {
             if (pMesh->GetUserId() == userId) {
-                return pMesh;
+                return pMesh->GetHandle().Cast<CMesh>();
             }
         }
     }
 
-    return nullptr;
+    return {};
 }
 
 //-------------------------------------
-CCamera *
+CameraHandle
 CSceneManager::GetCameraByUserId(int32_t userId) const {
     for (CCamera *pCamera : mCameras) {
         if (pCamera != nullptr) {
             if (pCamera->GetUserId() == userId) {
-                return pCamera;
+                return pCamera->GetHandle().Cast<CCamera>();
             }
         }
     }
 
-    return nullptr;
+    return {};
 }
 
 //-------------------------------------
-CLight *
+LightHandle
 CSceneManager::GetLightByUserId(int32_t userId) const {
     for (CLight *pLight : mLights) {
         if (pLight != nullptr) {
             if (pLight->GetUserId() == userId) {
-                return pLight;
+                return pLight->GetHandle().Cast<CLight>();
             }
         }
     }
 
-    return nullptr;
+    return {};
+}
+
+
+//-------------------------------------
+bool
+CSceneManager::DeleteMesh(MeshHandle handle) {
+    return DeleteSceneNode(Resolve(handle));
+}
+
+//-------------------------------------
+bool
+CSceneManager::DeleteCamera(CameraHandle handle) {
+    return DeleteSceneNode(Resolve(handle));
 }
 
+//-------------------------------------
+bool
+CSceneManager::DeleteLight(LightHandle handle) {
+    return DeleteSceneNode(Resolve(handle));
+}
 
 //-------------------------------------
 bool
@@ -229,28 +292,28 @@ CSceneManager::DeleteSceneNode(CSceneNode *node) {
     if(it != mNodes.end()) {
         mNodes.erase(it);
 
-        //if(node->mNodeType == ENodeType::Mesh) {
+        if(node->GetType() == ENodeType::Mesh) {
             auto it2 = std::find(mMeshes.begin(), mMeshes.end(), node);
             if (it2 != mMeshes.end()) {
                 mMeshes.erase(it2);
             }
-        //}
+        }
 
-        //else if(node->mNodeType == ENodeType::Mesh) {
+        else if(node->GetType() == ENodeType::Camera) {
             auto it3 = std::find(mCameras.begin(), mCameras.end(), node);
             if (it3 != mCameras.end()) {
                 mCameras.erase(it3);
             }
-        //}
+        }
 
-        //else if(node->mNodeType == ENodeType::Light) {
+        else if(node->GetType() == ENodeType::Light) {
             auto it4 = std::find(mLights.begin(), mLights.end(), node);
             if (it4 != mLights.end()) {
                 mLights.erase(it4);
             }
-        //}
+        }
 
-        delete node;
+        DestroyNode(node);
 
         return true;
     }
@@ -258,3 +321,507 @@ CSceneManager::DeleteSceneNode(CSceneNode *node) {
     return false;
 }
 
+//-------------------------------------
+NodeHandle
+CSceneManager::AllocHandle(CSceneNode *node) {
+    uint32_t    index;
+
+    if(mFirstFreeSlot != kInvalidSlot) {
+        index          = mFirstFreeSlot;
+        mFirstFreeSlot = mHandleSlots[index].nextFree;
+    }
+    else {
+        // A greater index would be masked into an existing slot
+        if(mHandleSlots.size() > NodeHandle::kMaxIndex)
+            return {};
+
+        index = uint32_t(mHandleSlots.size());
+        mHandleSlots.emplace_back();
+    }
+
+    HandleSlot &slot = mHandleSlots[index];
+    slot.pNode    = node;
+    slot.nextFree = kInvalidSlot;
+
+    node->mHandle = NodeHandle(index, slot.generation);
+    mDepthLevelsDirty = true;
+
+    return node->mHandle;
+}
+
+//-------------------------------------
+void
+CSceneManager::FreeHandle(NodeHandle handle) {
+    if(Resolve(handle) == nullptr)
+        return;
+
+    uint32_t    index = handle.GetIndex();
+    HandleSlot  &slot = mHandleSlots[index];
+
+    // Bumping the generation invalidates every copy of the handle
+    slot.pNode      = nullptr;
+    slot.generation = NodeHandle::NextGeneration(slot.generation);
+    slot.nextFree   = mFirstFreeSlot;
+    mFirstFreeSlot  = index;
+    mDepthLevelsDirty = true;
+}
+
+//-------------------------------------
+void
+CSceneManager::DestroyNode(CSceneNode *node) {
+    FreeHandle(node->mHandle);
+
+    if(node->GetType() == ENodeType::Mesh) {
+        mpSpatialIndex->Remove(static_cast<CMesh *>(node));
+    }
+
+    // A snapshot being rendered may still reference it: unlink now, free later
+    if(mUseSnapshots) {
+        node->SetParent(nullptr);
+        while(node->GetNumChildren() > 0) {
+            node->GetChild(0)->SetParent(nullptr);
+        }
+
+        mDeferredNodes.push_back({ node, mSnapshotFrame });
+        return;
+    }
+
+    FreeNode(node);
+}
+
+//-------------------------------------
+void
+CSceneManager::FreeNode(CSceneNode *node) {
+    switch(node->GetType()) {
+        case ENodeType::Node:
+            mNodePool.Destroy(node);
+            break;
+
+        case ENodeType::Mesh:
+            mMeshPool.Destroy(static_cast<CMesh *>(node));
+            break;
+
+        case ENodeType::Camera:
+            mCameraPool.Destroy(static_cast<CCamera *>(node));
+            break;
+
+        case ENodeType::Light:
+            mLightPool.Destroy(static_cast<CLight *>(node));
+            break;
+    }
+}
+
+//-------------------------------------
+const PoolStats &
+CSceneManager::GetPoolStats(ENodeType type) const {
+    switch(type) {
+        case ENodeType::Mesh:
+            return mMeshPool.GetStats();
+
+        case ENodeType::Camera:
+            return mCameraPool.GetStats();
+
+        case ENodeType::Light:
+            return mLightPool.GetStats();
+
+        default:
+            return mNodePool.GetStats();
+    }
+}
+
+//-------------------------------------
+void
+CSceneManager::LogPoolStats() const {
+    static const char *kNames[] = { "Node", "Mesh", "Camera", "Light" };
+    static const ENodeType kTypes[] = { ENodeType::Node, ENodeType::Mesh, ENodeType::Camera, ENodeType::Light };
+
+    for(size_t i = 0; i < sizeof(kTypes) / sizeof(kTypes[0]); ++i) {
+        const PoolStats &stats = GetPoolStats(kTypes[i]);
+        MS_LOG("[Pool %-6s] used: %zu / %zu (%.1f%%), peak: %zu, slabs: %zu, slot: %zu bytes",
+               kNames[i], stats.used, stats.capacity, stats.GetOccupancy() * 100.0f, stats.peak, stats.numSlabs, stats.slotSize);
+    }
+}
+
+
+//-------------------------------------
+void
+CSceneManager::GetTraversalOrder(vector<CSceneNode *> &order) const {
+    vector<CSceneNode *>    stack;
+
+    auto isOwned = [this](CSceneNode *node) {
+        return Resolve(node->mHandle) == node;
+    };
+
+    order.clear();
+    order.reserve(mNodes.size());
+
+    // Roots are nodes without parent or whose parent is not ours. Depth first, preorder
+    for(CSceneNode *root : mNodes) {
+        if(root->mpParent != nullptr && isOwned(root->mpParent))
+            continue;
+
+        stack.push_back(root);
+        while(stack.empty() == false) {
+            CSceneNode *node = stack.back();
+            stack.pop_back();
+
+            order.push_back(node);
+            for(auto it = node->mChildren.rbegin(); it != node->mChildren.rend(); ++it) {
+                if(isOwned(*it))
+                    stack.push_back(*it);
+            }
+        }
+    }
+}
+
+//-------------------------------------
+CSceneNode *
+CSceneManager::RelocateNode(CSceneNode *node) {
+    CSceneNode  *pNew = nullptr;
+
+    switch(node->GetType()) {
+        case ENodeType::Node:
+            pNew = new (mNodePool.AllocateSlot()) CSceneNode(std::move(*node));
+            break;
+
+        case ENodeType::Mesh:
+            pNew = new (mMeshPool.AllocateSlot()) CMesh(std::move(*static_cast<CMesh *>(node)));
+            break;
+
+        case ENodeType::Camera:
+            pNew = new (mCameraPool.AllocateSlot()) CCamera(std::move(*static_cast<CCamera *>(node)));
+            break;
+
+        case ENodeType::Light:
+            pNew = new (mLightPool.AllocateSlot()) CLight(std::move(*static_cast<CLight *>(node)));
+            break;
+    }
+
+    mHandleSlots[pNew->mHandle.GetIndex()].pNode = pNew;
+
+    return pNew;
+}
+
+//-------------------------------------
+void
+CSceneManager::Defragment() {
+    vector<CSceneNode *>                            order;
+    std::unordered_map<CSceneNode *, CSceneNode *>  relocated;
+    MindShake::CObjectPool<CSceneNode>              oldNodePool;
+    MindShake::CObjectPool<CMesh>                   oldMeshPool;
+    MindShake::CObjectPool<CCamera>                 oldCameraPool;
+    MindShake::CObjectPool<CLight>                  oldLightPool;
+
+    // No snapshot may be in use here, so nothing needs to wait
+    FreeDeferredNodes(~uint64_t(0));
+
+    GetTraversalOrder(order);
+
+    // The current objects stay in the old slabs until they are moved
+    oldNodePool.Swap(mNodePool);
+    oldMeshPool.Swap(mMeshPool);
+    oldCameraPool.Swap(mCameraPool);
+    oldLightPool.Swap(mLightPool);
+
+    mNodePool.Reserve(oldNodePool.GetNumUsed());
+    mMeshPool.Reserve(oldMeshPool.GetNumUsed());
+    mCameraPool.Reserve(oldCameraPool.GetNumUsed());
+    mLightPool.Reserve(oldLightPool.GetNumUsed());
+
+    relocated.reserve(order.size());
+    for(CSceneNode *node : order) {
+        relocated[node] = RelocateNode(node);
+    }
+
+    auto remap = [&relocated](CSceneNode *node) {
+        auto it = relocated.find(node);
+        return (it != relocated.end()) ? it->second : node;
+    };
+
+    // Patch hierarchy links. Nodes not owned by the manager keep their address
+    for(auto &pair : relocated) {
+        CSceneNode  *oldNode = pair.first;
+        CSceneNode  *newNode = pair.second;
+
+        if(newNode->mpParent != nullptr) {
+            CSceneNode *parent = remap(newNode->mpParent);
+            if(parent == newNode->mpParent) {
+                std::replace(parent->mChildren.begin(), parent->mChildren.end(), oldNode, newNode);
+            }
+            newNode->mpParent = parent;
+        }
+
+        for(CSceneNode *&child : newNode->mChildren) {
+            CSceneNode *newChild = remap(child);
+            if(newChild == child) {
+                child->mpParent = newNode;
+            }
+            child = newChild;
+        }
+
+        // So the destructor of the moved-from object does not unlink anything
+        oldNode->mpParent = nullptr;
+        oldNode->mChildren.clear();
+        oldNode->mHandle  = NodeHandle();
+    }
+
+    mMeshes.clear();
+    mCameras.clear();
+    mLights.clear();
+    for(size_t i = 0; i < order.size(); ++i) {
+        CSceneNode *oldNode = order[i];
+        CSceneNode *newNode = relocated[oldNode];
+
+        order[i] = newNode;
+        switch(oldNode->GetType()) {
+            case ENodeType::Node:
+                oldNodePool.Destroy(oldNode);
+                break;
+
+            case ENodeType::Mesh:
+                oldMeshPool.Destroy(static_cast<CMesh *>(oldNode));
+                mMeshes.push_back(static_cast<CMesh *>(newNode));
+                break;
+
+            case ENodeType::Camera:
+                oldCameraPool.Destroy(static_cast<CCamera *>(oldNode));
+                mCameras.push_back(static_cast<CCamera *>(newNode));
+                break;
+
+            case ENodeType::Light:
+                oldLightPool.Destroy(static_cast<CLight *>(oldNode));
+                mLights.push_back(static_cast<CLight *>(newNode));
+                break;
+        }
+    }
+    mNodes.swap(order);
+    mDepthLevelsDirty = true;
+    mpSpatialIndex->SetDirty();
+}
+
+//-------------------------------------
+void
+CSceneManager::BuildDepthLevels() {
+    auto isOwned = [this](CSceneNode *node) {
+        return Resolve(node->mHandle) == node;
+    };
+
+    mDepthLevels.resize(1);
+    mDepthLevels[0].clear();
+    mExternalParents.clear();
+
+    for(CSceneNode *node : mNodes) {
+        if(node->mpParent == nullptr) {
+            mDepthLevels[0].push_back(node);
+        }
+        else if(isOwned(node->mpParent) == false) {
+            mDepthLevels[0].push_back(node);
+            mExternalParents.push_back(node->mpParent);
+        }
+    }
+
+    std::sort(mExternalParents.begin(), mExternalParents.end());
+    mExternalParents.erase(std::unique(mExternalParents.begin(), mExternalParents.end()), mExternalParents.end());
+
+    for(size_t depth = 0; mDepthLevels[depth].empty() == false; ++depth) {
+        mDepthLevels.emplace_back();
+
+        const vector<CSceneNode *>  &level = mDepthLevels[depth];
+        vector<CSceneNode *>        &next  = mDepthLevels[depth + 1];
+        for(CSceneNode *node : level) {
+            for(CSceneNode *child : node->mChildren) {
+                if(isOwned(child))
+                    next.push_back(child);
+            }
+        }
+    }
+    // The last level is always empty
+    mDepthLevels.pop_back();
+
+    mDepthLevelsVersion = CSceneNode::GetHierarchyVersion();
+    mDepthLevelsDirty   = false;
+}
+
+//-------------------------------------
+MindShake::CWorkerPool *
+CSceneManager::GetWorkerPool() {
+    if(mpWorkerPool == nullptr) {
+        mpWorkerPool = new MindShake::CWorkerPool();
+    }
+
+    return mpWorkerPool;
+}
+
+//-------------------------------------
+void
+CSceneManager::UpdateWorldMatrices() {
+    if(mDepthLevelsDirty || mDepthLevelsVersion != CSceneNode::GetHierarchyVersion()) {
+        BuildDepthLevels();
+    }
+
+    // Nodes owned by others are updated lazily, before the threads read them
+    for(CSceneNode *parent : mExternalParents) {
+        parent->GetMatrixWorld();
+    }
+
+    for(const vector<CSceneNode *> &level : mDepthLevels) {
+        if(mParallelUpdate && level.size() >= mParallelMinNodes) {
+            GetWorkerPool()->ParallelFor(level.size(), kParallelMinBatch, [&level](size_t begin, size_t end) {
+                CSceneNode::UpdateMatricesWorldFromParent(&level[begin], end - begin);
+            });
+        }
+        else {
+            CSceneNode::UpdateMatricesWorldFromParent(level.data(), level.size());
+        }
+    }
+}
+
+//-------------------------------------
+void
+CSceneManager::SetSpatialIndex(ESpatialIndex type) {
+    if(type == mSpatialIndexType)
+        return;
+
+    mpSpatialIndex->Clear();
+    mSpatialIndexType = type;
+    switch(type) {
+        case ESpatialIndex::BVH:
+            mpSpatialIndex = &mBVH;
+            break;
+
+        case ESpatialIndex::LooseOctree:
+            mpSpatialIndex = &mLooseOctree;
+            break;
+    }
+    mpSpatialIndex->SetDirty();
+}
+
+//-------------------------------------
+void
+CSceneManager::UpdateSpatialIndex() {
+    mMovedMeshes.clear();
+    for(NodeHandle handle : CSceneNode::mMovedNodes) {
+        CSceneNode *node = Resolve(handle);
+        if(node != nullptr && node->GetType() == ENodeType::Mesh) {
+            mMovedMeshes.push_back(static_cast<CMesh *>(node));
+        }
+    }
+    CSceneNode::mMovedNodes.clear();
+
+    mpSpatialIndex->Update(mMeshes, mMovedMeshes);
+}
+
+//-------------------------------------
+CSpatialIndex *
+CSceneManager::GetBuiltSpatialIndex() {
+    if(mpSpatialIndex->IsDirty()) {
+        mpSpatialIndex->Build(mMeshes);
+    }
+
+    return mpSpatialIndex;
+}
+
+//-------------------------------------
+void
+CSceneManager::CullMeshes(CCamera &camera, vector<CMesh *> &visible) {
+    GetBuiltSpatialIndex()->QueryFrustum(camera.GetFrustumPlanes(), CCamera::kNumFrustumPlanes, visible);
+}
+
+//-------------------------------------
+void
+CSceneManager::GetMeshesInSphere(const vec3 &center, float radius, vector<CMesh *> &result) {
+    GetBuiltSpatialIndex()->QuerySphere(center, radius, result);
+}
+
+//-------------------------------------
+MeshHandle
+CSceneManager::RayCast(const vec3 &origin, const vec3 &direction, float maxDistance, float *pDistance) {
+    CMesh *pMesh = GetBuiltSpatialIndex()->RayCast(origin, direction, maxDistance, pDistance);
+
+    return (pMesh != nullptr) ? pMesh->GetHandle().Cast<CMesh>() : MeshHandle();
+}
+//-------------------------------------
+MeshHandle
+CSceneManager::Pick(CCamera &camera, float screenX, float screenY, float *pDistance) {
+    // Reverse Z: 1 is the near plane
+    vec3 origin = camera.UnProject(vec3(screenX, screenY, 1.0f));
+    vec3 target = camera.UnProject(vec3(screenX, screenY, 0.5f));
+
+    return RayCast(origin, (target - origin).GetNormalized(), MindShake::Float32::POS_INFINITY, pDistance);
+}
+
+//-------------------------------------
+const CSceneSnapshot &
+CSceneManager::PublishSnapshot() {
+    CSceneSnapshot  &snapshot = mSnapshots[mFrontSnapshot ^ 1];
+
+    mUseSnapshots = true;
+    UpdateWorldMatrices();
+
+    snapshot.Clear();
+    snapshot.mFrame = ++mSnapshotFrame;
+
+    snapshot.mMeshes.reserve(mMeshes.size());
+    for(CMesh *mesh : mMeshes) {
+        if(mesh->IsEnabled()) {
+            snapshot.mMeshes.push_back({ mesh, mesh->GetHandle().Cast<CMesh>(), mesh->GetMatrixWorld() });
+        }
+    }
+
+    snapshot.mCameras.reserve(mCameras.size());
+    for(CCamera *camera : mCameras) {
+        if(camera->IsEnabled() == false)
+            continue;
+
+        CameraState state;
+
+        state.handle         = camera->GetHandle().Cast<CCamera>();
+        state.world          = camera->GetMatrixWorld();
+        state.view           = camera->GetViewMatrix();
+        state.projection     = camera->GetProjectionMatrix();
+        state.viewProjection = camera->GetViewProjectionMatrix();
+        std::copy(camera->GetFrustumPlanes(), camera->GetFrustumPlanes() + CCamera::kNumFrustumPlanes, state.frustum);
+
+        state.viewportX      = camera->GetViewportX();
+        state.viewportY      = camera->GetViewportY();
+        state.viewportWidth  = camera->GetViewportWidth();
+        state.viewportHeight = camera->GetViewportHeight();
+        state.viewportNear   = camera->GetViewportNear();
+        state.viewportFar    = camera->GetViewportFar();
+        state.fov            = camera->GetFOV();
+
+        snapshot.mCameras.push_back(state);
+    }
+
+    return snapshot;
+}
+
+//-------------------------------------
+bool
+CSceneManager::SwapSnapshots() {
+    if(mSnapshots[mFrontSnapshot ^ 1].mFrame <= mSnapshots[mFrontSnapshot].mFrame)
+        return false;
+
+    mFrontSnapshot ^= 1;
+
+    // Nodes deleted before the new front was published are in no snapshot in use
+    FreeDeferredNodes(mSnapshots[mFrontSnapshot].mFrame);
+
+    return true;
+}
+
+//-------------------------------------
+void
+CSceneManager::FreeDeferredNodes(uint64_t frame) {
+    size_t  kept = 0;
+
+    for(const DeferredNode &deferred : mDeferredNodes) {
+        if(deferred.frame < frame) {
+            FreeNode(deferred.pNode);
+        }
+        else {
+            mDeferredNodes[kept++] = deferred;
+        }
+    }
+    mDeferredNodes.resize(kept);
+}
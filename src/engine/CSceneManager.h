@@ -1,17 +1,35 @@
 #pragma once
 
+#include <engine/engineEnums.h>
+#include <engine/CHandle.h>
+#include <engine/CBVH.h>
+#include <engine/CLooseOctree.h>
+#include <engine/CSceneSnapshot.h>
+//-------------------------------------
+#include <Core/memory/CPoolAllocator.h>
+//-------------------------------------
 #include <vector>
 #include <string>
+#include <type_traits>
 
 //-------------------------------------
 using std::string;
 using std::vector;
+using PoolStats = MindShake::PoolStats;
 
 class CSceneNode;
 class CCamera;
 class CMesh;
 class CLight;
 
+namespace MindShake {
+    class CWorkerPool;
+}
+
+//-------------------------------------
+// Objects are referenced through generational handles. Raw pointers
+// (from Resolve or Get*ByIndex) are only valid until the next call to
+// Defragment, which may relocate the objects.
 //-------------------------------------
 class CSceneManager {
 public:
@@ -19,38 +37,89 @@ public:
     static void             DeleteInstance();
 
 public:
-    CSceneNode *        CreateSceneNode();
-    CMesh *             CreateMesh();
-    CCamera *           CreateCamera();
-    CLight *            CreateLight();
+    NodeHandle          CreateSceneNode();
+    MeshHandle          CreateMesh();
+    CameraHandle        CreateCamera();
+    LightHandle         CreateLight();
+
+    // O(1). Returns nullptr for null or stale handles
+    template <typename T>
+    T *                 Resolve(CHandle<T, HandleValue> handle) const;
+    template <typename T>
+    bool                IsValid(CHandle<T, HandleValue> handle) const  { return Resolve(handle) != nullptr; }
 
     CSceneNode *        GetSceneNodeByIndex(size_t index)    { return (index < mNodes.size())   ? mNodes[index]   : nullptr; }
     CMesh *             GetMeshByIndex(size_t index)         { return (index < mMeshes.size())  ? mMeshes[index]  : nullptr; }
     CCamera *           GetCameraByIndex(size_t index)       { return (index < mCameras.size()) ? mCameras[index] : nullptr; }
     CLight *            GetLightByIndex(size_t index)        { return (index < mLights.size())  ? mLights[index]  : nullptr; }
 
-    CSceneNode *        GetSceneNodeByName(const string &name) const;
-    CMesh *             GetMeshByName(const string &name) const;
-    CCamera *           GetCameraByName(const string &name) const;
-    CLight *            GetLightByName(const string &name) const;
+    NodeHandle          GetSceneNodeByName(const string &name) const;
+    MeshHandle          GetMeshByName(const string &name) const;
+    CameraHandle        GetCameraByName(const string &name) const;
+    LightHandle         GetLightByName(const string &name) const;
 
-    CSceneNode *        GetSceneNodeByUserId(int32_t UserId) const;
-    CMesh *             GetMeshByUserId(int32_t UserId) const;
-    CCamera *           GetCameraByUserId(int32_t UserId) const;
-    CLight *            GetLightByUserId(int32_t UserId) const;
+    NodeHandle          GetSceneNodeByUserId(int32_t UserId) const;
+    MeshHandle          GetMeshByUserId(int32_t UserId) const;
+    CameraHandle        GetCameraByUserId(int32_t UserId) const;
+    LightHandle         GetLightByUserId(int32_t UserId) const;
 
     size_t              GetNumSceneNodes() const             { return mNodes.size();   }
     size_t              GetNumMeshes() const                 { return mMeshes.size();  }
     size_t              GetNumCameras() const                { return mCameras.size(); }
     size_t              GetNumLights() const                 { return mLights.size();  }
-    
+
+    bool                DeleteSceneNode(NodeHandle handle)   { return DeleteSceneNode(Resolve(handle)); }
+    bool                DeleteMesh(MeshHandle handle);
+    bool                DeleteCamera(CameraHandle handle);
+    bool                DeleteLight(LightHandle handle);
     bool                DeleteSceneNode(CSceneNode *node);
-    bool                DeleteMesh(CMesh *mesh)              { return DeleteSceneNode(reinterpret_cast<CSceneNode *>(mesh));   }
-    bool                DeleteCamera(CCamera *camera)        { return DeleteSceneNode(reinterpret_cast<CSceneNode *>(camera)); }
-    bool                DeleteLight(CLight *light)           { return DeleteSceneNode(reinterpret_cast<CSceneNode *>(light));  }
+
+    // Relocates every object into fresh slabs, sorted by hierarchy traversal order.
+    // Handles stay valid, raw pointers do not (nor the snapshots: do not call it
+    // while one is being rendered).
+    void                Defragment();
+
+    // Updates the world matrix of every dirty node. Nodes are grouped by hierarchy
+    // depth: a level only depends on the previous one, so big levels are split
+    // across the worker threads. Levels smaller than ParallelMinNodes are updated
+    // in the calling thread.
+    void                UpdateWorldMatrices();
+
+    void                SetParallelUpdate(bool set)          { mParallelUpdate = set;       }
+    bool                IsParallelUpdate() const             { return mParallelUpdate;      }
+    void                SetParallelMinNodes(size_t count)    { mParallelMinNodes = count;   }
+    size_t              GetParallelMinNodes() const          { return mParallelMinNodes;    }
+
+    // Spatial queries over the world bounds of the meshes. Call UpdateSpatialIndex
+    // after moving nodes (once per frame, after UpdateWorldMatrices is fine)
+    void                SetSpatialIndex(ESpatialIndex type);
+    ESpatialIndex       GetSpatialIndexType() const          { return mSpatialIndexType;    }
+    void                UpdateSpatialIndex();
+    void                CullMeshes(CCamera &camera, vector<CMesh *> &visible);
+    void                GetMeshesInSphere(const vec3 &center, float radius, vector<CMesh *> &result);
+    // Closest mesh whose bounds are hit. direction must be normalized
+    MeshHandle          RayCast(const vec3 &origin, const vec3 &direction, float maxDistance, float *pDistance = nullptr);
+    MeshHandle          Pick(CCamera &camera, float screenX, float screenY, float *pDistance = nullptr);
+    CSpatialIndex &     GetSpatialIndex()                    { return *mpSpatialIndex;      }
+    CBVH &              GetBVH()                             { return mBVH;                 }
+    CLooseOctree &      GetLooseOctree()                     { return mLooseOctree;         }
+
+    // Double buffered snapshots of the renderable state. PublishSnapshot updates
+    // the world matrices and fills the back snapshot (end of simulation).
+    // SwapSnapshots makes it the front one, once the renderer is done with the
+    // previous front; it returns false if nothing new was published.
+    // While snapshots are in use, deleted nodes are unlinked at once but only
+    // destroyed when no snapshot in use can reference them.
+    const CSceneSnapshot &  PublishSnapshot();
+    bool                SwapSnapshots();
+    const CSceneSnapshot &  GetFrontSnapshot() const         { return mSnapshots[mFrontSnapshot]; }
+
+    // Pool occupancy (one pool per node type)
+    const PoolStats &   GetPoolStats(ENodeType type) const;
+    void                LogPoolStats() const;
 
 protected:
-                        CSceneManager()                      = default;
+                        CSceneManager();
                         CSceneManager(const CSceneManager &) = delete;
                         CSceneManager(CSceneManager &&)      = delete;
     virtual             ~CSceneManager();
@@ -58,12 +127,110 @@ protected:
     CSceneManager &     operator=(const CSceneManager &)     = delete;
     CSceneManager &     operator=(CSceneManager &&)          = delete;
 
+    // Null handle when every slot is in use (see CHandle.h)
+    NodeHandle          AllocHandle(CSceneNode *node);
+    void                FreeHandle(NodeHandle handle);
+
+    // Whether a node can be resolved through a CHandle<T> (any node for CSceneNode)
+    template <typename T>
+    static bool         IsOfType(const CSceneNode *node);
+
+    void                DestroyNode(CSceneNode *node);
+    void                FreeNode(CSceneNode *node);
+    void                FreeDeferredNodes(uint64_t frame);
+    CSceneNode *        RelocateNode(CSceneNode *node);
+    void                GetTraversalOrder(vector<CSceneNode *> &order) const;
+
+    void                BuildDepthLevels();
+    CSpatialIndex *     GetBuiltSpatialIndex();
+    MindShake::CWorkerPool *GetWorkerPool();
+
 protected:
     static CSceneManager *  mpInstance;
 
 protected:
+    struct HandleSlot {
+        CSceneNode  *pNode      { nullptr };
+        uint32_t    generation  { 1 };
+        uint32_t    nextFree    { kInvalidSlot };
+    };
+    static const uint32_t   kInvalidSlot = 0xffffffff;
+    static const size_t     kParallelMinBatch = 256;
+
     vector<CSceneNode *>    mNodes;
     vector<CMesh *>         mMeshes;
     vector<CCamera *>       mCameras;
     vector<CLight *>        mLights;
+
+    vector<HandleSlot>      mHandleSlots;
+    uint32_t                mFirstFreeSlot { kInvalidSlot };
+
+    // Each node type lives in its own contiguous, cache line aligned slots
+    MindShake::CObjectPool<CSceneNode>  mNodePool;
+    MindShake::CObjectPool<CMesh>       mMeshPool;
+    MindShake::CObjectPool<CCamera>     mCameraPool;
+    MindShake::CObjectPool<CLight>      mLightPool;
+
+    CBVH                                mBVH;
+    CLooseOctree                        mLooseOctree;
+    CSpatialIndex *                     mpSpatialIndex      { &mBVH };
+    ESpatialIndex                       mSpatialIndexType   { ESpatialIndex::BVH };
+    vector<CMesh *>                     mMovedMeshes;
+
+    struct DeferredNode {
+        CSceneNode  *pNode;
+        uint64_t    frame;          // Last snapshot published when it was deleted
+    };
+
+    CSceneSnapshot                      mSnapshots[2];
+    uint32_t                            mFrontSnapshot      { 0 };
+    uint64_t                            mSnapshotFrame      { 0 };
+    bool                                mUseSnapshots       { false };
+    vector<DeferredNode>                mDeferredNodes;
+
+    // Nodes grouped by depth (roots first). Rebuilt when the hierarchy changes
+    vector<vector<CSceneNode *>>        mDepthLevels;
+    vector<CSceneNode *>                mExternalParents;   // Parents of our roots not owned by the manager
+    uint32_t                            mDepthLevelsVersion { 0 };
+    bool                                mDepthLevelsDirty   { true };
+
+    MindShake::CWorkerPool *            mpWorkerPool        { nullptr };
+    size_t                              mParallelMinNodes   { 4096 };
+    bool                                mParallelUpdate     { true };
 };
+
+//-------------------------------------
+template <typename T>
+inline T *
+CSceneManager::Resolve(CHandle<T, HandleValue> handle) const {
+    uint32_t index = handle.GetIndex();
+
+    if (index >= mHandleSlots.size())
+        return nullptr;
+
+    const HandleSlot &slot = mHandleSlots[index];
+    if (slot.generation != handle.GetGeneration())
+        return nullptr;
+
+    // Cast can retype a handle: a node of another type does not resolve
+    if (IsOfType<T>(slot.pNode) == false)
+        return nullptr;
+
+    return static_cast<T *>(slot.pNode);
+}
+
+//-------------------------------------
+template <typename T>
+inline bool
+CSceneManager::IsOfType(const CSceneNode *node) {
+    if (std::is_same<T, CMesh>::value)
+        return node->GetType() == ENodeType::Mesh;
+    if (std::is_same<T, CCamera>::value)
+        return node->GetType() == ENodeType::Camera;
+    if (std::is_same<T, CLight>::value)
+        return node->GetType() == ENodeType::Light;
+
+    static_assert(std::is_same<T, CSceneNode>::value || std::is_same<T, CMesh>::value ||
+                  std::is_same<T, CCamera>::value || std::is_same<T, CLight>::value, "Unknown node type");
+    return true;
+}
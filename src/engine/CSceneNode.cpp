@@ -2,16 +2,26 @@
 //-------------------------------------
 #include <algorithm>
 
+//-------------------------------------
+uint32_t                CSceneNode::mHierarchyVersion = 0;
+std::vector<NodeHandle> CSceneNode::mMovedNodes;
+
 //-------------------------------------
 CSceneNode::~CSceneNode() {
 
+    if(mpParent != nullptr || mChildren.empty() == false) {
+        ++mHierarchyVersion;
+    }
+
     if(mpParent != nullptr) {
         mpParent->RemoveChild(this);
         mpParent = nullptr;
     }
 
+    // Do not use SetParent here, it would erase from mChildren while iterating it
     for(auto &node : mChildren) {
-        node->SetParent(nullptr);
+        node->mpParent = nullptr;
+        node->SetDirtyTransform();
     }
     mChildren.clear();
 }
@@ -36,6 +46,8 @@ CSceneNode::SetParent(CSceneNode *pParent) {
 
     // Set parent
     mpParent = pParent;
+    SetDirtyTransform();
+    ++mHierarchyVersion;
 
     // Add to parent's children list
     if(pParent != nullptr) {
@@ -68,12 +80,48 @@ CSceneNode::RemoveChild(CSceneNode *pChild) {
     auto it = std::find(mChildren.begin(), mChildren.end(), pChild);
     if(it != mChildren.end()) {
         pChild->mpParent = nullptr;
+        pChild->SetDirtyTransform();
         mChildren.erase(it);
+        ++mHierarchyVersion;
     }
 }
 
 //-------------------------------------
-const mat4 &
+vec3
+CSceneNode::GetRotation() const {
+    vec3    angles;
+
+    if(mRotationMode == ERotationMode::Euler)
+        return mRotation;
+
+    mOrientation.ToEulerAnglesXYZ(angles);
+    return angles;
+}
+
+//-------------------------------------
+quat
+CSceneNode::GetOrientation() const {
+    quat    orientation;
+
+    if(mRotationMode == ERotationMode::Quaternion)
+        return mOrientation;
+
+    orientation.FromEulerAnglesXYZ(mRotation);
+    return orientation;
+}
+
+//-------------------------------------
+void
+CSceneNode::Rotate(const quat &rotation) {
+    quat    orientation = GetOrientation() * rotation;
+
+    // Keep it unit length: it accumulates every frame
+    orientation.Normalize();
+    SetOrientation(orientation);
+}
+
+//-------------------------------------
+const mat3x4 &
 CSceneNode::GetMatrixLocal() {
 
     if(mIsDirtyTransform)
@@ -83,7 +131,7 @@ CSceneNode::GetMatrixLocal() {
 }
 
 //-------------------------------------
-const mat4 &
+const mat3x4 &
 CSceneNode::GetMatrixWorld() {
 
     if(IsDirtyTransformWorld()) {
@@ -115,7 +163,7 @@ void
 CSceneNode::BuildLocalMatrix2D() {
 
     mIsDirtyTransform = false;
-    mMatrixLocal.MakeTransform(mPosition, vec3(mScale.x, mScale.y, 1), mRotation.z);
+    mMatrixLocal.MakeTransform(mPosition, vec3(mScale.x, mScale.y, 1), GetRotation().z);
 }
 
 //-------------------------------------
@@ -123,5 +171,57 @@ void
 CSceneNode::BuildLocalMatrix3D() {
 
     mIsDirtyTransform = false;
-    mMatrixLocal.MakeTransform(mPosition, mScale, mRotation);
+    if(mRotationMode == ERotationMode::Quaternion) {
+        mMatrixLocal.MakeTransform(mPosition, mScale, mOrientation);
+    }
+    else {
+        mMatrixLocal.MakeTransform(mPosition, mScale, mRotation);
+    }
+}
+
+//-------------------------------------
+// The sines and cosines of the Euler nodes of every batch are computed
+// together (SIMD). Quaternion nodes do not need them.
+//-------------------------------------
+void
+CSceneNode::UpdateMatricesWorldFromParent(CSceneNode *const *nodes, size_t count) {
+    const size_t    kBatch = 64;
+    CSceneNode      *dirty[kBatch];
+    CSceneNode      *euler[kBatch];
+    vec3            positions[kBatch], scales[kBatch], rotations[kBatch];
+    mat3x4          locals[kBatch];
+
+    for(size_t i = 0; i < count; ) {
+        size_t  numDirty = 0;
+        size_t  numEuler = 0;
+
+        // SetDirtyTransform marks the whole subtree, so a clean node has a clean parent
+        for(; i < count && numDirty < kBatch; ++i) {
+            CSceneNode *node = nodes[i];
+            if(node->mIsDirtyTransform) {
+                dirty[numDirty++] = node;
+                if(node->mRotationMode == ERotationMode::Quaternion) {
+                    node->BuildLocalMatrix3D();
+                    continue;
+                }
+
+                euler[numEuler]     = node;
+                positions[numEuler] = node->mPosition;
+                scales[numEuler]    = node->mScale;
+                rotations[numEuler] = node->mRotation;
+                ++numEuler;
+            }
+        }
+
+        mat3x4::MakeTransforms(positions, scales, rotations, locals, numEuler);
+        for(size_t j = 0; j < numEuler; ++j) {
+            euler[j]->mIsDirtyTransform = false;
+            euler[j]->mMatrixLocal      = locals[j];
+        }
+
+        // In order: a parent may be in the same batch
+        for(size_t j = 0; j < numDirty; ++j) {
+            dirty[j]->UpdateMatrixWorldFromLocal();
+        }
+    }
 }
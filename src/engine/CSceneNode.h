@@ -1,8 +1,14 @@
 #pragma once
 
 #include <engine/engineEnums.h>
+#include <engine/CHandle.h>
 //-------------------------------------
 #include <Math/types/CMatrix4.h>
+#include <Math/types/CMatrix3x4.h>
+#include <Math/types/CAABB.h>
+#include <Math/types/CPlane.h>
+//-------------------------------------
+#include <Core/memory/allocators.h>
 //-------------------------------------
 #include <string>
 #include <vector>
@@ -10,13 +16,23 @@
 //-------------------------------------
 using mat3   = MindShake::CMatrix3;
 using mat4   = MindShake::CMatrix4;
+using mat3x4 = MindShake::CMatrix3x4;
 using vec2   = MindShake::CVector2;
 using vec3   = MindShake::CVector3;
 using vec4   = MindShake::CVector4;
 using quat   = MindShake::CQuaternion;
+using aabb   = MindShake::CAABB;
+using plane  = MindShake::CPlane;
+
+// Cache line aligned storage: SIMD kernels can use aligned loads from data()
+template <typename T>
+using aligned_vector = std::vector<T, MindShake::CAlignedAllocator<T>>;
 
 //-------------------------------------
 class CSceneNode {
+    friend class CSceneManager;
+    friend class CSpatialIndex;
+
     using Nodes  = std::vector<CSceneNode *>;
     using string = std::string;
 
@@ -29,6 +45,9 @@ public:
     void                SetEnable(bool set)                       { mEnable = set;                                        }
     bool                IsEnabled() const                         { return mEnable;                                       }
 
+    ENodeType           GetType() const                           { return mType;                                         }
+    NodeHandle          GetHandle() const                         { return mHandle;                                       }
+
     void                SetName(const string &name)               { mName = name;                                         }
     const string &      GetName() const                           { return mName;                                         }
 
@@ -67,19 +86,27 @@ public:
     float               GetScaleY() const                         { return mScale.y;                                      }
     float               GetScaleZ() const                         { return mScale.z;                                      }
 
+    // Euler angles (degrees). They switch the node to ERotationMode::Euler
     void                SetRotation(float x, float y, float z)    { SetRotation(vec3(x, y, z));                           }
-    void                SetRotation(const vec3 &angles)           { SetDirtyTransform(); mRotation = angles;              }
-    void                SetRotationX(float x)                     { SetDirtyTransform(); mRotation.x = x;                 }
-    void                SetRotationY(float y)                     { SetDirtyTransform(); mRotation.y = y;                 }
-    void                SetRotationZ(float z)                     { SetDirtyTransform(); mRotation.z = z;                 }
+    void                SetRotation(const vec3 &angles)           { SetDirtyTransform(); SetEulerMode(); mRotation = angles; }
+    void                SetRotationX(float x)                     { SetDirtyTransform(); SetEulerMode(); mRotation.x = x;    }
+    void                SetRotationY(float y)                     { SetDirtyTransform(); SetEulerMode(); mRotation.y = y;    }
+    void                SetRotationZ(float z)                     { SetDirtyTransform(); SetEulerMode(); mRotation.z = z;    }
     void                Rotate(float x, float y, float z)         { Rotate(vec3(x, y, z));                                }
-    void                Rotate(const vec3 &angles)                { SetDirtyTransform(); mRotation += angles;             }
-    void                RotateZ(float z)                          { SetDirtyTransform(); mRotation.z += z;                }
+    void                Rotate(const vec3 &angles)                { SetDirtyTransform(); SetEulerMode(); mRotation += angles; }
+    void                RotateZ(float z)                          { SetDirtyTransform(); SetEulerMode(); mRotation.z += z;   }
 
-    const vec3 &        GetRotation() const                       { return mRotation;                                     }
-    float               GetRotationX() const                      { return mRotation.x;                                   }
-    float               GetRotationY() const                      { return mRotation.y;                                   }
-    float               GetRotationZ() const                      { return mRotation.z;                                   }
+    vec3                GetRotation() const;
+    float               GetRotationX() const                      { return GetRotation().x;                               }
+    float               GetRotationY() const                      { return GetRotation().y;                               }
+    float               GetRotationZ() const                      { return GetRotation().z;                               }
+
+    // Orientation (unit quaternion). They switch the node to ERotationMode::Quaternion
+    void                SetOrientation(const quat &orientation)   { SetDirtyTransform(); mRotationMode = ERotationMode::Quaternion; mOrientation = orientation; }
+    void                Rotate(const quat &rotation);             // Local space: orientation * rotation
+
+    quat                GetOrientation() const;
+    ERotationMode       GetRotationMode() const                   { return mRotationMode;                                 }
 
     void                SetParent(CSceneNode *pParent);
     CSceneNode *        GetParent() const                         { return mpParent;                                      }
@@ -88,30 +115,55 @@ public:
     CSceneNode *        GetChild(size_t index)                    { return (index < mChildren.size()) ? mChildren[index] : nullptr; }
     size_t              GetNumChildren() const                    { return mChildren.size();                              }
 
-    virtual const mat4 &GetMatrixLocal();
-    virtual const mat4 &GetMatrixWorld();
+    // Affine. Promote to mat4 only to combine with a projection (mat4 * mat3x4)
+    virtual const mat3x4 &GetMatrixLocal();
+    virtual const mat3x4 &GetMatrixWorld();
 
     void                SetDirtyTransform();
     bool                IsDirtyTransform() const                  { return mIsDirtyTransform;                             }
     bool                IsDirtyTransformWorld() const;
+    // Set with the transform, cleared by the spatial index once it has the new bounds
+    bool                IsMoved() const                           { return mIsMoved;                                      }
+    void                MarkMoved();
+
+    // Changes every time a parent / child link is modified (by any node)
+    static uint32_t     GetHierarchyVersion()                     { return mHierarchyVersion;                             }
 
 protected:
+    // Relative Euler changes start from the current orientation
+    void                SetEulerMode();
+
     void                BuildLocalMatrix2D();
     void                BuildLocalMatrix3D();
 
+    // Recomputes the world matrix assuming the parent one is up to date.
+    // Used by the CSceneManager level update: it never walks up the hierarchy.
+    void                UpdateMatrixWorldFromParent();
+    // Same for a range of nodes, building the dirty local matrices in batches
+    static void         UpdateMatricesWorldFromParent(CSceneNode *const *nodes, size_t count);
+    void                UpdateMatrixWorldFromLocal();
+    // Called when the world matrix has been recomputed outside GetMatrixWorld
+    virtual void        OnMatrixWorldChanged()                    { }
+
+    // Only used by CSceneManager to relocate nodes (links must be patched by the caller)
+                        CSceneNode(CSceneNode &&)      = default;
+
 private:
                         CSceneNode(const CSceneNode &) = delete;
-                        CSceneNode(CSceneNode &&)      = delete;
 
     CSceneNode &        operator=(const CSceneNode &)  = delete;
     CSceneNode &        operator=(CSceneNode &&)       = delete;
 
 protected:
+    static uint32_t             mHierarchyVersion;
+    // Owned nodes whose mIsMoved went from false to true. Drained by CSceneManager
+    static std::vector<NodeHandle> mMovedNodes;
+
     string          mName;
     int32_t         mUserId   { 0 };
 
-    mat4            mMatrixLocal { mat4::kIDENTITY };
-    mat4            mMatrixWorld { mat4::kIDENTITY };
+    mat3x4          mMatrixLocal { mat3x4::kIDENTITY };
+    mat3x4          mMatrixWorld { mat3x4::kIDENTITY };
 
     CSceneNode *    mpParent  { nullptr };
     Nodes           mChildren;
@@ -119,18 +171,68 @@ protected:
     vec3            mPosition { 0 };
     vec3            mScale    { 1 };
     vec3            mRotation { 0 };
+    quat            mOrientation { quat::kIDENTITY };
+    ERotationMode   mRotationMode { ERotationMode::Euler };
 
     ENodeType       mType     { ENodeType::Node };
+    NodeHandle      mHandle;                // Null if the node is not owned by CSceneManager
 
     bool            mEnable   { true };
     bool            mIsDirtyTransform { true };
+    bool            mIsMoved          { true };
 };
 
 //-------------------------------------
 inline void
 CSceneNode::SetDirtyTransform() { 
     mIsDirtyTransform = true;
+    MarkMoved();
     for(auto node : mChildren) {
         node->SetDirtyTransform();
     }
-}
\ No newline at end of file
+}
+
+//-------------------------------------
+inline void
+CSceneNode::SetEulerMode() {
+    if(mRotationMode == ERotationMode::Quaternion) {
+        mRotationMode = ERotationMode::Euler;
+        mOrientation.ToEulerAnglesXYZ(mRotation);
+    }
+}
+
+//-------------------------------------
+inline void
+CSceneNode::MarkMoved() {
+    // Only nodes already known by a spatial index (flag cleared) are queued, once
+    if(mIsMoved == false) {
+        mIsMoved = true;
+        if(mHandle) {
+            mMovedNodes.push_back(mHandle);
+        }
+    }
+}
+
+//-------------------------------------
+inline void
+CSceneNode::UpdateMatrixWorldFromParent() {
+    // SetDirtyTransform marks the whole subtree, so a clean node has a clean parent
+    if(mIsDirtyTransform == false)
+        return;
+
+    BuildLocalMatrix3D();
+    UpdateMatrixWorldFromLocal();
+}
+
+//-------------------------------------
+inline void
+CSceneNode::UpdateMatrixWorldFromLocal() {
+    if(mpParent != nullptr) {
+        mMatrixWorld = mpParent->mMatrixWorld * mMatrixLocal;
+    }
+    else {
+        mMatrixWorld = mMatrixLocal;
+    }
+
+    OnMatrixWorldChanged();
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <engine/CSceneNode.h>
+#include <engine/CCamera.h>
+//-------------------------------------
+#include <vector>
+
+//-------------------------------------
+class CMesh;
+
+using std::vector;
+
+//-------------------------------------
+struct MeshInstance {
+    CMesh           *pMesh;         // Geometry is shared, not copied. The render side only writes mVertexPosTrans
+    MeshHandle      handle;
+    mat3x4          world;
+};
+
+//-------------------------------------
+struct CameraState {
+    CameraHandle    handle;
+    mat3x4          world;
+    mat4            view;
+    mat4            projection;
+    mat4            viewProjection;
+    plane           frustum[CCamera::kNumFrustumPlanes];
+
+    uint32_t        viewportX;
+    uint32_t        viewportY;
+    uint32_t        viewportWidth;
+    uint32_t        viewportHeight;
+    float           viewportNear;
+    float           viewportFar;
+    float           fov;
+};
+
+//-------------------------------------
+// Immutable copy of the renderable state published by CSceneManager at the
+// end of the simulation, so frame N can be rendered while frame N + 1 is
+// simulated. Only enabled meshes and cameras are captured.
+// The mesh geometry (mVertexPos...) is referenced: do not edit the vertices
+// of a mesh while a snapshot that contains it is being rendered.
+//-------------------------------------
+class CSceneSnapshot {
+    friend class CSceneManager;
+
+public:
+    uint64_t                        GetFrame() const            { return mFrame;                }
+
+    const aligned_vector<MeshInstance> &GetMeshes() const       { return mMeshes;               }
+    const aligned_vector<CameraState> & GetCameras() const      { return mCameras;              }
+    const CameraState *             GetCamera(CameraHandle handle) const;
+
+protected:
+    void                            Clear()                     { mMeshes.clear(); mCameras.clear(); }
+
+protected:
+    uint64_t                        mFrame { 0 };
+    aligned_vector<MeshInstance>    mMeshes;
+    aligned_vector<CameraState>     mCameras;
+};
+
+//-------------------------------------
+inline const CameraState *
+CSceneSnapshot::GetCamera(CameraHandle handle) const {
+    for(const CameraState &camera : mCameras) {
+        if(camera.handle == handle)
+            return &camera;
+    }
+
+    return nullptr;
+}
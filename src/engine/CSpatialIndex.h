@@ -0,0 +1,46 @@
+#pragma once
+
+#include <engine/CSceneNode.h>
+//-------------------------------------
+#include <Math/culling/CFrustumCuller.h>
+//-------------------------------------
+#include <vector>
+
+//-------------------------------------
+class CMesh;
+
+using std::vector;
+using frustumCuller = MindShake::CFrustumCuller;
+using aabbArraySoA  = MindShake::CAABBArraySoA;
+
+//-------------------------------------
+// Common interface of the spatial indices over the world bounds of the meshes.
+// Indices clear CSceneNode::mIsMoved once they have read the new bounds.
+//-------------------------------------
+class CSpatialIndex {
+public:
+    virtual             ~CSpatialIndex()                    = default;
+
+    virtual void        Build(const vector<CMesh *> &meshes) = 0;
+    // moved: meshes whose transform / bounds changed since the last update.
+    // Rebuilds instead if the index is dirty
+    virtual void        Update(const vector<CMesh *> &meshes, const vector<CMesh *> &moved) = 0;
+    virtual void        Insert(CMesh *mesh)                 = 0;
+    virtual void        Remove(CMesh *mesh)                 = 0;
+    virtual void        Clear()                             = 0;
+
+    virtual void        QueryFrustum(const plane *planes, size_t numPlanes, vector<CMesh *> &result) const = 0;
+    virtual void        QuerySphere(const vec3 &center, float radius, vector<CMesh *> &result) const = 0;
+    virtual void        QueryAABB(const aabb &box, vector<CMesh *> &result) const = 0;
+    // Closest mesh whose bounds are hit by the ray. direction must be normalized
+    virtual CMesh *     RayCast(const vec3 &origin, const vec3 &direction, float maxDistance, float *pDistance = nullptr) const = 0;
+
+    void                SetDirty()                          { mIsDirty = true;              }
+    bool                IsDirty() const                     { return mIsDirty;              }
+
+protected:
+    static void         ClearMoved(CSceneNode *node)        { node->mIsMoved = false;       }
+
+protected:
+    bool                mIsDirty { true };
+};
@@ -1,7 +1,9 @@
 #include "CWindow.h"
+#include "CSceneManager.h"
+#include "CPixelKernels.h"
 //-------------------------------------
 #include <Common/Math/math_funcs.h>
-//-------------------------------------
+#include <Core/log/log.h>
 
 using namespace MindShake;
 
@@ -14,6 +16,7 @@ using namespace MindShake;
 CWindow::CWindow(const char *title, uint32_t width, uint32_t height, uint32_t flags) : mRenderer(width, height) {
     mWindow = mfb_open_ex(title, width, height, flags);
     if (mWindow) {
+        mfb_set_stretch_func(&CPixelKernels::Stretch);
         mfb_set_active_callback(mWindow, this, &CWindow::OnActive);
         mfb_set_resize_callback(mWindow, this, &CWindow::OnResize);
         //mfb_set_keyboard_callback(mWindow, this, &CWindow::OnKeyboard);
@@ -32,6 +35,18 @@ CWindow::~CWindow() {
     }
 }
 
+//-------------------------------------
+// minifb keeps a single stretch function for all the windows. It can be
+// replaced while the present thread is stretching a frame
+//-------------------------------------
+void
+CWindow::SetStretchFilter(EStretchFilter filter) {
+    mStretchFilter = filter;
+    if (mWindow) {
+        mfb_set_stretch_func((filter == EStretchFilter::Bilinear) ? &CPixelKernels::StretchBilinear : &CPixelKernels::Stretch);
+    }
+}
+
 //-------------------------------------
 void 
 CWindow::AddOnEnterFrame(Event event) {
@@ -44,9 +59,22 @@ CWindow::AddOnExitFrame(Event event) {
     mExitFrame.emplace_back(event);
 }
 
+//-------------------------------------
+void 
+CWindow::AddOnRenderFrame(RenderEvent event) {
+    mRenderFrame.emplace_back(event);
+}
+
 //-------------------------------------
 void 
 CWindow::Run() {
+    StartPresent();
+    if (mWindow && mIsPipelined && mRenderFrame.empty() == false) {
+        RunPipelined();
+        StopPresent();
+        return;
+    }
+
     if (mWindow) {
         for (;;) {
             mTimeFrameIni = mTimer.GetTime();
@@ -58,17 +86,26 @@ CWindow::Run() {
                 for(auto &enterFrame : mEnterFrame)
                     enterFrame(this);
                 mTimeUser = mTimer.GetTime() - timeUserIni;
+
+                if (mRenderFrame.empty() == false) {
+                    double timeRenderIni = mTimer.GetTime();
+                    CSceneManager *pScene = CSceneManager::GetInstance();
+                    pScene->PublishSnapshot();
+                    pScene->SwapSnapshots();
+                    for (auto &renderFrame : mRenderFrame)
+                        renderFrame(this, pScene->GetFrontSnapshot());
+                    mTimeRender = mTimer.GetTime() - timeRenderIni;
+                }
             }
 
-            double timeUpdateIni = mTimer.GetTime();
-            mfb_update_state state = mfb_update(mWindow, mRenderer.GetColorBuffer());
-            if (state != STATE_OK) {
+            if (Present(mIsActive) == false) {
                 break;
             }
-            mTimeUpdateWin = mTimer.GetTime() - timeUpdateIni;
 
             for (auto &exitFrame : mExitFrame)
                 exitFrame(this);
+            mFrameArena.NextFrame();
+            MemoryNextFrame();
 
 #if defined(TARGET_PLATFORM_WINDOWS) || defined(TARGET_PLATFORM_LINUX)
             VerticalSync();
@@ -77,6 +114,270 @@ CWindow::Run() {
             mTimeDelta = Min(mTimeFrame, (1.0f / mFPS) * 1.2f);
         }
     }
+    StopPresent();
+}
+
+//-------------------------------------
+// Main thread: simulates and publishes N + 1 while the render thread draws N,
+// then waits for it, presents N and hands N + 1 to the render thread.
+//-------------------------------------
+void 
+CWindow::RunPipelined() {
+    CSceneManager   *pScene = CSceneManager::GetInstance();
+    std::thread     renderThread(&CWindow::RenderLoop, this);
+    bool            hasFrame = false;   // The render thread drew one
+
+    for (;;) {
+        mTimeFrameIni = mTimer.GetTime();
+        if (mIsActive) {
+            double timeUserIni = mTimer.GetTime();
+            for (auto &enterFrame : mEnterFrame)
+                enterFrame(this);
+            pScene->PublishSnapshot();
+            mTimeUser = mTimer.GetTime() - timeUserIni;
+        }
+
+        WaitRender();
+        mTimeClear  = mRenderTimeClear;
+        mTimeRender = mRenderTime;
+
+        // The render thread is idle: the draw buffer can change
+        if (Present(hasFrame) == false) {
+            break;
+        }
+
+        for (auto &exitFrame : mExitFrame)
+            exitFrame(this);
+
+        // The render thread is idle until StartRender
+        mFrameArena.NextFrame();
+        MemoryNextFrame();
+
+        hasFrame = false;
+        if (mIsActive && pScene->SwapSnapshots()) {
+            StartRender();
+            hasFrame = true;
+        }
+
+#if defined(TARGET_PLATFORM_WINDOWS) || defined(TARGET_PLATFORM_LINUX)
+        VerticalSync();
+#endif
+        mTimeFrame = mTimer.GetTime() - mTimeFrameIni;
+        mTimeDelta = Min(mTimeFrame, (1.0f / mFPS) * 1.2f);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mRenderMutex);
+        mRenderQuit = true;
+    }
+    mRenderCV.notify_all();
+    renderThread.join();
+    mRenderQuit = false;
+}
+
+//-------------------------------------
+void 
+CWindow::RenderLoop() {
+    CChronoTimer    timer;      // mTimer belongs to the main thread
+    double          timeClear, timeRender;
+
+    std::unique_lock<std::mutex> lock(mRenderMutex);
+    for (;;) {
+        mRenderCV.wait(lock, [this] { return mRenderPending || mRenderQuit; });
+        if (mRenderQuit)
+            return;
+
+        lock.unlock();
+        RenderSnapshot(timer, timeClear, timeRender);
+        lock.lock();
+
+        mRenderTimeClear = timeClear;
+        mRenderTime      = timeRender;
+        mRenderPending   = false;
+        mRenderCV.notify_all();
+    }
+}
+
+//-------------------------------------
+void 
+CWindow::RenderSnapshot(CChronoTimer &timer, double &timeClear, double &timeRender) {
+    double timeIni = timer.GetTime();
+
+    mRenderer.Clear(0x00);
+    timeClear = timer.GetTime() - timeIni;
+
+    const CSceneSnapshot &snapshot = CSceneManager::GetInstance()->GetFrontSnapshot();
+    for (auto &renderFrame : mRenderFrame)
+        renderFrame(this, snapshot);
+    timeRender = timer.GetTime() - timeIni - timeClear;
+}
+
+//-------------------------------------
+void 
+CWindow::StartRender() {
+    {
+        std::lock_guard<std::mutex> lock(mRenderMutex);
+        mRenderPending = true;
+    }
+    mRenderCV.notify_all();
+}
+
+//-------------------------------------
+void 
+CWindow::WaitRender() {
+    std::unique_lock<std::mutex> lock(mRenderMutex);
+    mRenderCV.wait(lock, [this] { return mRenderPending == false; });
+}
+
+//-------------------------------------
+// Returns false when the window is closed (minifb has destroyed it).
+// Without a new frame the present thread shows the last one again
+//-------------------------------------
+bool
+CWindow::Present(bool newFrame) {
+    double              timeUpdateIni = mTimer.GetTime();
+    mfb_update_state    state;
+
+    // mfb_update_events destroys a closing window: nothing can be presenting
+    // then, so the present thread is stopped before handing it another frame
+    if (mPresentThread.joinable() && mfb_is_window_closing(mWindow)) {
+        StopPresent();
+    }
+
+    if (mPresentThread.joinable()) {
+        if (SubmitPresent(newFrame) == false) {
+            StopPresent();
+        }
+        state = mfb_update_events(mWindow);
+    }
+    else {
+        state = mfb_update(mWindow, mRenderer.GetColorBuffer());
+        mTimePresent = mTimer.GetTime() - timeUpdateIni;
+    }
+
+    if (state != STATE_OK) {
+        if (state == STATE_EXIT)
+            mWindow = nullptr;
+        return false;
+    }
+    mTimeUpdateWin = mTimer.GetTime() - timeUpdateIni;
+
+    return true;
+}
+
+//-------------------------------------
+void
+CWindow::StartPresent() {
+    if (mWindow == nullptr || mPresentBuffers < 2 || mPresentThread.joinable())
+        return;
+
+    if (mfb_can_update_present(mWindow) == false) {
+        MS_LOG("CWindow: the window backend can not present from a thread, presenting in Run");
+        return;
+    }
+
+    mRenderer.SetNumColorBuffers(mPresentBuffers);
+    if (mRenderer.GetNumColorBuffers() < 2) {
+        mRenderer.SetNumColorBuffers(1);
+        return;
+    }
+
+    mDrawBuffer       = 0;
+    mLastBuffer       = -1;
+    mQueuedBuffer     = -1;
+    mPresentingBuffer = -1;
+    mPresentQuit      = false;
+    mPresentState     = STATE_OK;
+    mPresentThread    = std::thread(&CWindow::PresentLoop, this);
+}
+
+//-------------------------------------
+// A frame still queued is dropped. Drawing goes on in the current buffer
+//-------------------------------------
+void
+CWindow::StopPresent() {
+    if (mPresentThread.joinable() == false)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mPresentMutex);
+        mPresentQuit = true;
+    }
+    mPresentCV.notify_all();
+    mPresentThread.join();
+}
+
+//-------------------------------------
+// Hands the drawn buffer to the present thread (waiting while the previous
+// frame is still queued) and moves drawing to one it is not using.
+// Returns false once the present thread failed
+//-------------------------------------
+bool
+CWindow::SubmitPresent(bool newFrame) {
+    const int32_t   numBuffers = int32_t(mRenderer.GetNumColorBuffers());
+
+    std::unique_lock<std::mutex> lock(mPresentMutex);
+    mPresentCV.wait(lock, [this] { return mQueuedBuffer < 0 || mPresentState != STATE_OK; });
+    if (newFrame == false) {
+        mQueuedBuffer = mLastBuffer;
+        mTimePresent  = mPresentTime;
+        mPresentCV.notify_all();
+        return mPresentState == STATE_OK;
+    }
+    mQueuedBuffer = mDrawBuffer;
+    mLastBuffer   = mDrawBuffer;
+    mPresentCV.notify_all();
+
+    auto isFree = [this](int32_t index) { return index != mQueuedBuffer && index != mPresentingBuffer; };
+    mPresentCV.wait(lock, [&] {
+        for (int32_t i = 1; i < numBuffers; ++i) {
+            if (isFree((mDrawBuffer + i) % numBuffers))
+                return true;
+        }
+        return false;
+    });
+    for (int32_t i = 1; i < numBuffers; ++i) {
+        if (isFree((mDrawBuffer + i) % numBuffers)) {
+            mDrawBuffer = (mDrawBuffer + i) % numBuffers;
+            break;
+        }
+    }
+    mRenderer.SetDrawColorBuffer(uint32_t(mDrawBuffer));
+    mTimePresent = mPresentTime;
+
+    return mPresentState == STATE_OK;
+}
+
+//-------------------------------------
+void
+CWindow::PresentLoop() {
+    CChronoTimer        timer;      // mTimer belongs to the main thread
+    mfb_update_state    state;
+    double              timeIni;
+    uint32_t            *buffer;
+
+    std::unique_lock<std::mutex> lock(mPresentMutex);
+    for (;;) {
+        mPresentCV.wait(lock, [this] { return mQueuedBuffer >= 0 || mPresentQuit; });
+        if (mPresentQuit)
+            return;
+
+        mPresentingBuffer = mQueuedBuffer;
+        mQueuedBuffer     = -1;
+        buffer            = mRenderer.GetColorBuffer(uint32_t(mPresentingBuffer));
+        mPresentCV.notify_all();
+
+        lock.unlock();
+        timeIni = timer.GetTime();
+        state   = mfb_update_present(mWindow, buffer);
+        lock.lock();
+
+        mPresentTime      = timer.GetTime() - timeIni;
+        mPresentingBuffer = -1;
+        if (state != STATE_OK)
+            mPresentState = state;
+        mPresentCV.notify_all();
+    }
 }
 
 //-------------------------------------
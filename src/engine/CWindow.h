@@ -1,13 +1,21 @@
 #pragma once
 
 #include "CRenderer.h"
+#include "engineEnums.h"
 //-------------------------------------
 #include <Kernel/timer/CChronoTimer.h>
+#include <Core/memory/CFrameArena.h>
 //-------------------------------------
 #include <MiniFB.h>
 //-------------------------------------
 #include <vector>
 #include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//-------------------------------------
+class CSceneSnapshot;
 
 //-------------------------------------
 using namespace std::placeholders;
@@ -15,16 +23,22 @@ using namespace std::placeholders;
 //-------------------------------------
 class CWindow {
     using CChronoTimer = MindShake::CChronoTimer;
+    using CFrameArena  = MindShake::CFrameArena;
     using Event        = std::function<void(CWindow *)>;
     using Events       = std::vector<Event>;
     using KeyEvent     = std::function<void(CWindow *, mfb_key, mfb_key_mod, bool)>;
     using KeyEvents    = std::vector<KeyEvent>;
+    using RenderEvent  = std::function<void(CWindow *, const CSceneSnapshot &)>;
+    using RenderEvents = std::vector<RenderEvent>;
 
 public:
                 CWindow(const char *title, unsigned width, unsigned height, unsigned flags);
                 ~CWindow();
 
     CRenderer & GetRenderer()               { return mRenderer;     }
+    // Scratch memory for per frame data, valid until the end of the next frame
+    // (see MindShake::CFrameArena). Reset at the end of every Run iteration
+    CFrameArena &GetFrameArena()            { return mFrameArena;   }
 
     template<typename T>
     void        AddOnEnterFrame(T *obj, void (T::*method)(CWindow *)) { AddOnEnterFrame(std::bind(method, obj, _1));  }
@@ -34,17 +48,41 @@ public:
     void        AddOnExitFrame(T* obj, void (T::* method)(CWindow*)) { AddOnExitFrame(std::bind(method, obj, _1)); }
     void        AddOnExitFrame(Event event);
 
+    // Drawing from a CSceneManager snapshot, after the OnEnterFrame (simulation) events
+    template<typename T>
+    void        AddOnRenderFrame(T *obj, void (T::*method)(CWindow *, const CSceneSnapshot &)) { AddOnRenderFrame(std::bind(method, obj, _1, _2)); }
+    void        AddOnRenderFrame(RenderEvent event);
+
     void        Run();
 
+    // Pipelined: the OnRenderFrame events of frame N run in a render thread while
+    // the OnEnterFrame events simulate frame N + 1. Set it before Run
+    void        SetPipelined(bool set)      { mIsPipelined = set;   }
+    bool        IsPipelined() const         { return mIsPipelined;  }
+
+    // Color buffers. With 1 Run presents each frame itself (mfb_update). With 2 or 3
+    // a present thread pushes the finished frame (mfb_update_present) while the next
+    // one is drawn in another buffer; Run only updates the events. Backends without
+    // mfb_update_present fall back to 1. Set it before Run
+    void        SetPresentBuffers(uint32_t count) { mPresentBuffers = count; }
+    uint32_t    GetPresentBuffers() const   { return mPresentBuffers; }
+
     void        SetFPS(uint32_t fps)        { mFPS = fps;}
 
+    // Filter used when the window size differs from the renderer one
+    void        SetStretchFilter(EStretchFilter filter);
+    EStretchFilter GetStretchFilter() const { return mStretchFilter; }
+
 // Getters
 public:
     uint32_t    GetFPS() const              { return mFPS;          }
     double      GetTimeDelta() const        { return mTimeDelta;    }
     double      GetTimeClear() const        { return mTimeClear;    }
     double      GetTimeUser() const         { return mTimeUser;     }
+    double      GetTimeRender() const       { return mTimeRender;   }
     double      GetTimeUpdateWin() const    { return mTimeUpdateWin; }
+    // Last mfb_update_present in the present thread (GetTimeUpdateWin is the wait for it)
+    double      GetTimePresent() const      { return mTimePresent;  }
     double      GetTimeLastFrame() const    { return mTimeFrame;    }
 
     const uint8_t *GetKeyBuffer() const     { return mfb_get_key_buffer(mWindow); }
@@ -58,6 +96,18 @@ protected:
 protected:
     void        VerticalSync();
 
+    void        RunPipelined();
+    bool        Present(bool newFrame);
+    void        RenderLoop();
+    void        RenderSnapshot(CChronoTimer &timer, double &timeClear, double &timeRender);
+    void        StartRender();
+    void        WaitRender();
+
+    void        StartPresent();
+    void        StopPresent();
+    void        PresentLoop();
+    bool        SubmitPresent(bool newFrame);
+
 private:
                 CWindow(const CWindow &) = delete;
                 CWindow(CWindow &&) = delete;
@@ -68,17 +118,44 @@ private:
 private:
     struct mfb_window   *mWindow      { nullptr };
     CRenderer       mRenderer;
+    CFrameArena     mFrameArena { MindShake::CLinearArena::kDefaultChunkSize, MindShake::EMemoryTag::Renderer };
     bool            mIsActive     { true };
+    EStretchFilter  mStretchFilter { EStretchFilter::Nearest };
 
     uint32_t        mFPS { 60 };
     CChronoTimer    mTimer;
     double          mTimeClear{};
     double          mTimeUser{};
+    double          mTimeRender{};
     double          mTimeUpdateWin{};
     double          mTimeFrameIni{};
     double          mTimeFrame{};
     double          mTimeDelta{};
     Events          mEnterFrame;
     Events          mExitFrame;
+    RenderEvents    mRenderFrame;
     KeyEvents       mKeyEvents;
+
+    // Pipelined mode
+    bool                    mIsPipelined    { false };
+    std::mutex              mRenderMutex;
+    std::condition_variable mRenderCV;
+    bool                    mRenderPending  { false };
+    bool                    mRenderQuit     { false };
+    double                  mRenderTimeClear{};
+    double                  mRenderTime{};
+
+    // Present thread
+    uint32_t                mPresentBuffers { 1 };
+    std::thread             mPresentThread;
+    std::mutex              mPresentMutex;
+    std::condition_variable mPresentCV;
+    int32_t                 mDrawBuffer     { 0 };
+    int32_t                 mLastBuffer     { -1 };     // Last one submitted
+    int32_t                 mQueuedBuffer   { -1 };     // Waiting for the present thread
+    int32_t                 mPresentingBuffer { -1 };
+    bool                    mPresentQuit    { false };
+    mfb_update_state        mPresentState   { STATE_OK };
+    double                  mPresentTime{};
+    double                  mTimePresent{};
 };
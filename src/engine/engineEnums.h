@@ -8,3 +8,21 @@ enum class ENodeType {
     Light,
 };
 
+
+//-------------------------------------
+enum class ERotationMode {
+    Euler,          // Degrees, X then Y then Z (trig on every rebuild)
+    Quaternion,     // Rebuilds are multiply-adds only
+};
+
+//-------------------------------------
+enum class ESpatialIndex {
+    BVH,            // Mostly static scenes: best queries, refit + rebuild
+    LooseOctree,    // Many objects moving every frame: O(1) reinsertion
+};
+
+//-------------------------------------
+enum class EStretchFilter {
+    Nearest,        // Pixel replication, exact for integer factors
+    Bilinear,       // Smooth, for non integer (ie. dynamic resolution) scales
+};
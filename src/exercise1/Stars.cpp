@@ -37,6 +37,7 @@ Stars::Init(uint32_t numStars, uint32_t depth) {
     printf("   - Debug: To Bottom: B\n");
     printf("   - Debug: To Front: F\n");
     printf(" - Show FPS info: F1\n");
+    printf(" - Bilinear window stretch: F2\n");
 
     mWindowWidth     = mWindow->GetRenderer().GetWidth();
     mWindowHeight    = mWindow->GetRenderer().GetHeight();
@@ -239,6 +240,14 @@ Stars::ManageInput() {
         mShowFPS = !mShowFPS;
         printf("Show FPS: %s\n", mShowFPS ? "Enabled" : "Disabled");
     }
+
+    // window stretch filter
+    if (keys[KB_KEY_F2]) {
+        keys[KB_KEY_F2] = false;
+        bool bilinear = (mWindow->GetStretchFilter() == EStretchFilter::Bilinear);
+        mWindow->SetStretchFilter(bilinear ? EStretchFilter::Nearest : EStretchFilter::Bilinear);
+        printf("Bilinear stretch: %s\n", bilinear ? "Disabled" : "Enabled");
+    }
 }
 
 //-------------------------------------
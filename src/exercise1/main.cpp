@@ -3,6 +3,7 @@
 #include <engine/CWindow.h>
 //-------------------------------------
 #include <Core/utils/pathUtils.h>
+#include <Kernel/cpu/CCpuKernel.h>
 //-------------------------------------
 #include <stdlib.h>
 #include <time.h>
@@ -19,6 +20,7 @@ main(int, char* argv[]) {
     // Initialize stuff
     srand((unsigned)time(nullptr));
     SetApplicationDirectory(argv);
+    MindShake::CCpuKernelBase::LogAll();
 
     CWindow win("Stars", kWidth, kHeight, WF_RESIZABLE);
     Stars   stars(&win, kNumStars, kDepth);